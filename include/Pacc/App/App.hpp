@@ -8,12 +8,15 @@
 #include <Pacc/PackageSystem/Events.hpp>
 #include <Pacc/PackageSystem/Package.hpp>
 #include <Pacc/PackageSystem/IPackageLoader.hpp>
+#include <Pacc/PackageSystem/PackageRegistry.hpp>
 #include <Pacc/Generation/Premake5.hpp>
 #include <Pacc/Toolchains/Toolchain.hpp>
 #include <Pacc/Generation/BuildQueueBuilder.hpp>
 
 #include <Pacc/Helpers/Lua.hpp>
 
+class InputFingerprints;
+
 class PaccApp
 	:
 	public PaccAppModule_EventHandlerActions
@@ -54,6 +57,12 @@ public:
 	void visualizeGraph();
 	// query
 	void query();
+	// daemon
+	void daemon();
+	// pch
+	void pch();
+	// worker
+	void worker();
 
 
 
@@ -71,6 +80,12 @@ public:
 
 	auto detectPreferredPackageLoaderFor(fs::path const& path_) const -> IPackageLoader&;
 
+	/// <summary>Folders searched for packages by name, in order of priority.</summary>
+	auto packageSearchFolders() const -> Vec<fs::path>;
+
+	/// <summary>Returns the index of installed packages (loaded on first use).</summary>
+	auto packageRegistry() -> PackageRegistry&;
+
 	void loadPaccConfig();
 
 	PaccApp();
@@ -83,6 +98,10 @@ public:
 
 	sol::state	lua;
 
+	// Set once the state is prepared, so that the daemon prepares it only once
+	bool paccConfigLoaded 	= false;
+	bool luaReady 			= false;
+
 	UMap<String, UPtr<IPackageLoader> > packageLoaders;
 	UMap<String, UPtr<IPackageBuilder> > packageBuilders;
 
@@ -118,7 +137,11 @@ private:
 	auto setupPackageLoaders() -> void;
 	auto setupPackageBuilders() -> void;
 	auto determineBuildSettingsFromArgs() const -> BuildSettings;
-	auto buildSpecifiedPackage(Package& pkg_, Toolchain& toolchain_, BuildSettings const& settings_, bool isDependency_ = false) -> void;
+	/// <summary>Writes the resolved graph ("pacc query graph"), from the snapshot if it is still valid.</summary>
+	auto queryGraph(std::ostream& out_) -> void;
+	auto buildSpecifiedPackage(Package& pkg_, Toolchain& toolchain_, BuildSettings const& settings_, bool isDependency_ = false) -> BuildProcessResult;
+	/// <summary>Builds the package, then rebuilds the projects affected by file changes ("pacc build --watch").</summary>
+	auto buildInWatchMode(Toolchain& toolchain_, BuildSettings const& settings_) -> void;
 	auto installPackageDependencies(Package& pkg_, bool isRoot) -> size_t;
 
 	/// <summary>
@@ -133,12 +156,14 @@ private:
 
 	auto downloadPackage(fs::path const &target_, DownloadLocation const& loc_) -> void;
 
-	auto ensureProjectsAreBuilt(Package& pkg_, Vec<String> const& projectNames_, BuildSettings const& settings_) -> void;
+	auto ensureProjectsAreBuilt(Package& pkg_, Vec<String> const& projectNames_, BuildSettings const& settings_, InputFingerprints& fingerprints_) -> void;
 	auto ensureDependenciesBuilt(Package& pkg_, BuildQueueBuilder const &depQueue_, BuildSettings const& settings_) -> void;
 
 	auto collectMissingDependencies(Package const & pkg_) -> Vec<PackageDependency>;
 
 	UMap<LuaScriptContext, sol::state> loadedLuaScripts;
+
+	UPtr<PackageRegistry> registry;
 };
 
 inline PaccApp& useApp() {
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Main.hpp>
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+class PaccApp;
+
+/// <summary>
+/// 	Opt-in background process ("pacc daemon") that keeps the pacc configuration,
+/// 	the Lua SDK and parsed manifests in memory between commands.
+/// </summary>
+/// <remarks>
+/// 	The CLI forwards commands over a Unix domain socket (together with its working directory,
+/// 	environment and standard streams). The daemon runs every command in a forked child,
+/// 	so each command starts from the warm state and cannot leave anything behind.
+/// 	Commands run concurrently; the ones that never end (watch mode, workers) are not forwarded.
+/// 	Cached state is invalidated with inotify. Supported on Linux only.
+/// </remarks>
+namespace pacc_daemon
+{
+
+auto socketPath() -> Path;
+
+/// <summary>Runs the command in the daemon, if one is running.</summary>
+/// <returns>The exit code or nullopt if the command has to run in this process.</returns>
+auto forward(ProgramArgs const& args_) -> Opt<int>;
+
+/// <summary>Serves commands until stopped with "pacc daemon stop".</summary>
+void serve(PaccApp& app_);
+
+/// <returns><c>false</c> if no daemon was running.</returns>
+auto stop() -> bool;
+
+auto isRunning() -> bool;
+
+}
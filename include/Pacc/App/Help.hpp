@@ -18,6 +18,11 @@ constexpr ActionInfo actions[] = {
 	{ "log", 			"list latest build logs or print last log's content (--last)" },
 	{ "list-versions",	"lists available versions of remote package" },
 	{ "list-packages",	"lists installed global packages" },
+	{ "graph",			"prints the dependency graph with the critical build path (--format=dot|json)" },
+	{ "query",			"prints package information as JSON (\"package\" or the full resolved \"graph\")" },
+	{ "daemon",			"keeps pacc warm in the background and serves commands from memory (start, stop, status)" },
+	{ "pch",			"lists the headers worth precompiling, by include frequency (suggest)" },
+	{ "worker",			"compiles jobs of distributed builds (\"build --distribute\") sent by other machines" },
 	{ "version", 		"displays pacc version" },
 	{ "help", 			"displays this help message" },
 	{ "install",		"installs package artifacts" },
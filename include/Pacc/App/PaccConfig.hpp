@@ -14,6 +14,12 @@ struct PaccConfig
 	size_t 		selectedToolchain;
 	fs::path 	path;
 
+	Vec<String> workers; 		// addresses of the "pacc worker" processes used by "pacc build --distribute"
+	String 		workerToken; 	// shared by the workers and the building machines
+
+	Opt<int> 	linkJobs; 				// links run at the same time, derived from the available memory if not set
+	int 		linkJobMemory = 4096; 	// memory (MiB) a link needs
+
 	Toolchain* currentToolchain() const
 	{
 		if (selectedToolchain < toolchains.size())
@@ -40,4 +46,6 @@ private:
 
 	VecOfTc readToolchains(json const& input_, String const &field_);
 	void readSelectedToolchain(json const& input_);
+	void readWorkers(json const& input_);
+	void readLinkLimits(json const& input_);
 };
@@ -22,6 +22,9 @@ struct PaccMainAction {
 		Run,
 		Graph,
 		Query,
+		Daemon,
+		Pch,
+		Worker,
 	} type = None;
 
 	PaccMainAction() = default;
@@ -48,6 +51,9 @@ struct PaccMainAction {
 		if (str == "run") return Run;
 		if (str == "graph") return Graph;
 		if (str == "query") return Query;
+		if (str == "daemon") return Daemon;
+		if (str == "pch") return Pch;
+		if (str == "worker") return Worker;
 		return None;
 	}
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/PackageSystem/Package.hpp>
+
+struct Toolchain;
+
+/// <summary>Compiler feature used to measure compilation ("--profile-compile").</summary>
+enum class CompileProfiler
+{
+	None,
+	ClangTimeTrace, 	// -ftime-trace: JSON trace next to each object file
+	GccTimeReport, 		// -ftime-report: per-TU time report printed to stderr
+};
+
+/// <summary>Aggregated compile times of a build.</summary>
+struct CompileProfile
+{
+	struct Entry
+	{
+		String 		name;
+		double 		milliseconds 	= 0;
+		std::size_t count 			= 0;
+	};
+
+	CompileProfiler profiler = CompileProfiler::None;
+
+	Vec<Entry> translationUnits; 	// slowest first
+	Vec<Entry> headers; 			// by cumulative parse time (inclusive), clang only
+	Vec<Entry> templates; 			// by cumulative instantiation time, clang only
+	Vec<Entry> phases; 				// summed over all TUs, gcc only
+
+	bool unitsNamed = true; 		// false: gcc reports of a parallel build, the units are only numbered
+
+	auto toJSON() const -> json;
+	void printSummary(std::size_t limit_ = 10) const;
+};
+
+/// <summary>Profiler supported by the toolchain (depends on the compiler).</summary>
+auto compileProfilerFor(Toolchain const& toolchain_) -> CompileProfiler;
+
+/// <summary>Adds the profiling flag to the compiler options of every project.</summary>
+/// <returns><c>false</c> if the toolchain has no supported profiler.</returns>
+auto enableCompileProfiling(Package& package_, Toolchain const& toolchain_) -> bool;
+
+/// <summary>
+/// 	Collects the profiling output of the build that started at <c>buildStart_</c>:
+/// 	clang traces from the object folder or the gcc report from the latest build log.
+/// </summary>
+/// <param name="jobs_">Jobs the build ran at once (0 if unknown).</param>
+/// <remarks>
+/// 	gcc reports name no file, they are matched to the compiled files by order.
+/// 	The order holds only for a single job, parallel builds get numbered units.
+/// </remarks>
+auto collectCompileProfile(Package const& package_, CompileProfiler profiler_, fs::file_time_type buildStart_, int jobs_) -> CompileProfile;
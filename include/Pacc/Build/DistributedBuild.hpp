@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Main.hpp>
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>
+/// 	Compilation on other machines ("pacc build --distribute"), similar to distcc.
+/// 	Make runs the compiler through the pacc launcher ("pacc remote-compile {compiler} {args}"),
+/// 	which preprocesses the source locally and sends it to one of the workers ("pacc worker").
+/// 	The worker compiles it and sends back the object file and the compiler output.
+/// </summary>
+/// <remarks>
+/// 	Linking, precompiled headers and everything the launcher does not recognize as a single
+/// 	compilation run locally, as does every job no worker could take. Links wait for a slot of
+/// 	the link pool, if there is one. Workers accept only code generation, warning and optimization
+/// 	options. Workers reachable from other machines require a shared token. Supported on Linux only.
+/// </remarks>
+namespace distributed
+{
+
+/// <summary>Action name of the compiler launcher, handled before the arguments are parsed.</summary>
+constexpr StringView LauncherAction 		= "remote-compile";
+
+/// <summary>Environment variable with the addresses of the workers (separated with ';') used by the launcher.</summary>
+constexpr StringView WorkersVariable 		= "PACC_WORKERS";
+
+/// <summary>Environment variable with the token shared by the workers and the launchers ("workerToken" in settings.json).</summary>
+constexpr StringView TokenVariable 			= "PACC_WORKER_TOKEN";
+
+/// <summary>Environment variable with the path of the link pool (see JobServer::createPool), links run by the launcher take a slot of it.</summary>
+constexpr StringView LinkPoolVariable 		= "PACC_LINK_POOL";
+
+constexpr StringView DefaultWorkerAddress 	= "127.0.0.1:7340";
+
+struct WorkerInfo
+{
+	String 	address;
+	int 	slots 	= 0; 		// number of jobs compiled at the same time
+	bool 	busy 	= false; 	// all slots were taken
+};
+
+/// <returns>The workers that responded (in the same order), unreachable ones are skipped.</returns>
+auto probeWorkers(Vec<String> const& addresses_) -> Vec<WorkerInfo>;
+
+/// <summary>Runs the compiler command (<c>args_[2]</c> onwards) on a worker if possible, locally otherwise (links limited by the link pool).</summary>
+/// <returns>The exit code of the compiler.</returns>
+auto runLauncher(ProgramArgs const& args_) -> int;
+
+/// <summary>Makes the launchers run by this process send the token to the workers.</summary>
+void useToken(StringView token_);
+
+/// <summary>
+/// 	Compiles jobs received on the address, at most <c>slots_</c> at the same time. Runs until interrupted.
+/// 	Jobs without the token are refused (if it is not empty).
+/// </summary>
+/// <exception cref="PaccException">The address is not local and the token is empty.</exception>
+void serveWorker(StringView address_, int slots_, StringView token_);
+
+}
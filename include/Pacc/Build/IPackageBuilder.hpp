@@ -16,9 +16,24 @@ struct BuildSettings
 	String configName 		= "Debug";
 	String platformName 	= "x64";
 
-	String targetName 		= "";
+	String targetName 		= ""; // projects to build (separated with ';'), empty = all
 
 	Opt<int> cores;
+
+	// true: every build takes its jobs from the jobserver published in MAKEFLAGS, instead of running "cores" jobs on its own
+	bool sharedJobServer = false;
+
+	// true: links wait for a slot of the link pool (see distributed::LinkPoolVariable)
+	bool linkPool = false;
+
+	// false: reuse the project files generated by the previous build (none of the files were added or removed)
+	bool regenerateProjectFiles = true;
+
+	// true: build from scratch, the outputs of the previous build are stale (f.e. different flags or toolchain)
+	bool rebuild = false;
+
+	// addresses of the workers that compile the sources ("pacc build --distribute"), empty = compile locally
+	Vec<String> workers;
 };
 
 using BuildProcessResult = Opt<int>;
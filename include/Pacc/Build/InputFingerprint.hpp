@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/System/FileHasher.hpp>
+
+struct Toolchain;
+
+/// <summary>
+/// 	What an artifact of a project was built from.
+/// 	Stored next to the artifact ("{artifact}.fingerprint"), so the artifact is rebuilt only when it differs.
+/// </summary>
+struct InputFingerprint
+{
+	String configuration; 	// hash of the resolved flags, build settings and the toolchain identity
+	String sources; 		// hash of the contents of the project files, the files in its include folders
+							// and the fingerprints of the projects it depends on
+
+	/// <summary>Computes the fingerprint of the project.</summary>
+	/// <param name="dependencies_">Fingerprints of the projects the project depends on.</param>
+	/// <remarks>
+	/// 	Files are hashed with <paramref name="hasher_"/>, so only changed files are read again.
+	/// 	The caller saves the hasher once it is done with it.
+	/// </remarks>
+	static auto compute(Package const& pkg_, Project const& project_, Toolchain const& toolchain_, BuildSettings const& settings_,
+		FileHasher& hasher_, Vec<InputFingerprint> const& dependencies_) -> InputFingerprint;
+
+	/// <returns>The fingerprint stored with the artifact, nullopt if there is none.</returns>
+	static auto load(Path const& artifact_) -> Opt<InputFingerprint>;
+
+	void save(Path const& artifact_) const;
+
+	auto operator==(InputFingerprint const& other_) const -> bool = default;
+};
+
+/// <summary>
+/// 	Fingerprints of the projects checked by a command.
+/// 	Each project is fingerprinted once, with the fingerprints of its dependency projects (transitively) folded in,
+/// 	so a changed header or a rebuild of a dependency makes the dependent projects stale too.
+/// </summary>
+class InputFingerprints
+{
+public:
+	InputFingerprints(Toolchain const& toolchain_, BuildSettings const& settings_);
+
+	auto of(Package const& pkg_, Project const& project_) -> InputFingerprint const&;
+
+	/// <summary>Stores the file hashes read so far.</summary>
+	void save() { hasher.save(); }
+
+private:
+	Toolchain const& 					toolchain;
+	BuildSettings const& 				settings;
+	FileHasher 							hasher;
+	UMap<Project const*, InputFingerprint> 	computed;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>
+/// 	GNU make jobserver shared by every build a pacc command runs, so that nested and concurrent
+/// 	builds together run at most the requested number of jobs.
+/// </summary>
+/// <remarks>
+/// 	The tokens are in a named pipe, published in MAKEFLAGS ("-j{N} --jobserver-auth=fifo:{path}") while
+/// 	the jobserver exists. GNU make 4.4+ and ninja 1.13+ take a token for every job but their first one
+/// 	(also when run by "cmake --build"). Each build started by pacc holds a slot for that first job:
+/// 	the first build uses the slot of pacc itself, the others take a token.
+/// 	Pools (<c>createPool</c>) use the same tokens to limit other jobs (f.e. links) of all builds,
+/// 	their path is published in an environment variable. Not supported on Windows.
+/// </remarks>
+class JobServer
+{
+public:
+	/// <summary>Slot held by a running build, given back on destruction.</summary>
+	class Slot
+	{
+	public:
+		Slot() = default;
+		Slot(Slot&& other_) noexcept;
+		Slot& operator=(Slot&& other_) noexcept;
+		~Slot();
+
+	private:
+		friend class JobServer;
+
+		JobServer* server 	= nullptr;
+		bool implicit 		= false;
+		char token 			= '+';
+	};
+
+	/// <summary>Creates a jobserver with <c>jobs_</c> slots and publishes it in MAKEFLAGS.</summary>
+	/// <returns>nullptr if it could not be created.</returns>
+	static auto create(int jobs_) -> UPtr<JobServer>;
+
+	/// <summary>Joins the jobserver of the make that runs pacc (from MAKEFLAGS), if there is one.</summary>
+	static auto join() -> UPtr<JobServer>;
+
+	/// <summary>Creates a pool with <c>jobs_</c> slots and publishes its path in the <c>variable_</c> environment variable.</summary>
+	/// <returns>nullptr if it could not be created.</returns>
+	static auto createPool(int jobs_, StringView variable_) -> UPtr<JobServer>;
+
+	/// <summary>Joins the pool published in the <c>variable_</c> environment variable, if there is one.</summary>
+	static auto joinPool(StringView variable_) -> UPtr<JobServer>;
+
+	/// <returns>The jobserver (not a pool) created or joined last, nullptr if there is none.</returns>
+	static auto active() -> JobServer*;
+
+	JobServer(JobServer const&) = delete;
+	JobServer& operator=(JobServer const&) = delete;
+
+	/// <summary>Removes the jobserver and restores its environment variable (only the created ones).</summary>
+	~JobServer();
+
+	/// <summary>Waits until a slot is free.</summary>
+	auto acquire() -> Slot;
+
+	/// <returns>Number of slots, 0 if unknown (joined jobserver without "-j" in MAKEFLAGS).</returns>
+	auto jobs() const -> int { return numJobs; }
+
+private:
+	JobServer() = default;
+
+	static auto createFifo(StringView variable_, int jobs_, int tokens_) -> UPtr<JobServer>;
+	static auto openFifo(StringView path_) -> UPtr<JobServer>;
+
+	void release(Slot& slot_);
+
+	Path 		fifo;
+	int 		fd 				= -1;
+	int 		numJobs 		= 0;
+	bool 		owned 			= false; 	// created by this process
+	String 		variable; 					// environment variable that publishes it
+	Opt<String> prevValue;
+
+	std::mutex 	mutex;
+	bool 		implicitTaken 	= false;
+};
@@ -54,12 +54,19 @@ public:
 
 private:
 
-	DepQueueStep 			collectReadyDependencies(DepQueue const& ready_, PendingDeps & pending_);
+	DepQueueStep 			collectReadyDependencies(PendingDeps & pending_);
 
-	bool 					isPackageLoaded(fs::path root_) const;
-	PackagePtr 				findPackageByRoot(fs::path root_) const;
+	bool 					isPackageLoaded(fs::path const& root_) const;
+	PackagePtr 				findPackageByRoot(fs::path const& root_) const;
 
-	Vec<PackagePtr> loadedPackages;
+	/// <summary>Canonical form of the package root, used as the lookup key.</summary>
+	/// <remarks>Resolved on the filesystem once per root, remembered afterwards.</remarks>
+	String const& 			packageKey(fs::path const& root_) const;
+
+	Vec<PackagePtr> 		loadedPackages; // in load order
+	StrUMap<PackagePtr> 	packagesByRoot; // canonical root -> package
+	mutable StrUMap<String> canonicalRoots; // root -> canonical root
+	USet<Dependency const*> queuedDeps; 	// dependencies already in the queue
 	PendingDeps 			pendingDeps;
 	DepQueue 				queue; // prepared queue
 };
@@ -9,3 +9,18 @@ auto currentTimeForLog() -> String;
 auto saveBuildOutputLog(StringView packageName_, String const& outputLog_) -> fs::path;
 
 auto getSortedBuildLogs(size_t limit = 0) -> Vec<fs::path>;
+
+/// <summary>Returns the newest build output log of the package.</summary>
+auto findLatestBuildLog(StringView packageName_) -> Opt<fs::path>;
+
+/// <summary>Saves a report of the build (f.e. "compile_profile.json") next to the build logs.</summary>
+auto saveBuildReport(StringView packageName_, StringView reportName_, String const& content_) -> fs::path;
+
+/// <summary>Remembers how long the last successful build of the package (in <c>packageFolder_</c>) took.</summary>
+void saveBuildDuration(Path const& packageFolder_, double milliseconds_);
+
+/// <summary>Last measured build durations in milliseconds, by package folder (see <c>buildDurationKey</c>).</summary>
+auto loadBuildDurations() -> StrUMap<double>;
+
+/// <summary>Key of the package in the saved build durations.</summary>
+auto buildDurationKey(Path const& packageFolder_) -> String;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+namespace gen
+{
+
+constexpr std::size_t DefaultMaxPchHeaders = 32;
+
+/// <summary>External or system header included by the project sources.</summary>
+struct HeaderUsage
+{
+	String 		name; 				// as written in the include directive
+	bool 		angled 	= true; 	// <name> or "name"
+	std::size_t sources = 0; 		// sources that include it (directly or through headers of the package)
+	double 		weight 	= 0; 		// fraction of the sources
+};
+
+/// <summary>
+/// 	Scans the C++ sources of the project and ranks the headers from outside of the package
+/// 	(system and dependency headers) by the number of sources that include them.
+/// 	Includes of the package's own headers are followed, includes inside conditional blocks are ignored.
+/// </summary>
+/// <returns>Headers included by enough sources, in the order they were first included.</returns>
+auto suggestPchHeaders(Package const& pkg_, Project const& project_, std::size_t maxHeaders_ = DefaultMaxPchHeaders) -> Vec<HeaderUsage>;
+
+/// <summary>
+/// 	Writes the precompiled header and source of the project into "build/pch/{project}" of the package.
+/// 	Unchanged files are not written again, so the header is not precompiled again.
+/// </summary>
+/// <returns>The precompiled header, nullopt if no header is included often enough.</returns>
+auto writeAutoPch(Package const& pkg_, Project const& project_) -> Opt<PrecompiledHeader>;
+
+/// <summary>Returns the precompiled header of the project, synthesized if it is set to "auto".</summary>
+auto resolvePch(Package const& pkg_, Project const& project_) -> Opt<PrecompiledHeader>;
+
+}
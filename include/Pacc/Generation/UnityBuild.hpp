@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+namespace gen
+{
+
+/// <summary>Translation units of a unity build and the sources compiled through them.</summary>
+struct UnityBuildFiles
+{
+	Vec<Path> batches; 			// generated translation units
+	Vec<Path> batchedSources; 	// compiled through the batches, removed from the project
+};
+
+/// <summary>
+/// 	Splits the sources (sorted) into batches of <paramref name="batchSize_"/> files on average.
+/// 	A batch ends after a file whose name hash says so (content-defined boundaries),
+/// 	so adding or removing a file changes only its own batch, not all batches after it.
+/// </summary>
+auto splitIntoUnityBatches(Vec<String> sources_, std::size_t batchSize_) -> Vec<Vec<String>>;
+
+/// <summary>
+/// 	Writes the unity translation units of the project into "build/unity/{project}" of the package.
+/// 	Files with unchanged contents are not written again, so they are not recompiled.
+/// 	C++ batches include <paramref name="pch_"/> first.
+/// </summary>
+auto writeUnityBuild(Package const& pkg_, Project const& project_, UnityBuild const& unity_, Opt<PrecompiledHeader> const& pch_) -> UnityBuildFiles;
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/////////////////////////////////////////
+/// <summary>64-bit FNV-1a hash. Meant for fingerprints (detecting changes), not for security.</summary>
+class Fnv1a
+{
+public:
+	static constexpr uint64_t OffsetBasis 	= 14695981039346656037ull;
+	static constexpr uint64_t Prime 		= 1099511628211ull;
+
+	/// <summary>Hashes raw bytes.</summary>
+	constexpr void addBytes(StringView bytes_)
+	{
+		for (char c : bytes_)
+		{
+			value ^= static_cast<uint8_t>(c);
+			value *= Prime;
+		}
+	}
+
+	/// <summary>Hashes the number (byte by byte, little-endian).</summary>
+	constexpr void add(uint64_t number_)
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			value ^= static_cast<uint8_t>(number_ >> (i * 8));
+			value *= Prime;
+		}
+	}
+
+	/// <summary>Hashes the string with its length, so that ("ab", "c") and ("a", "bc") differ.</summary>
+	constexpr void add(StringView str_)
+	{
+		this->add(static_cast<uint64_t>(str_.size()));
+		this->addBytes(str_);
+	}
+
+	constexpr auto digest() const -> uint64_t { return value; }
+
+	auto hex() const -> String { return fmt::format("{:016x}", value); }
+
+private:
+	uint64_t value = OffsetBasis;
+};
+
+/////////////////////////////////////////
+/// <summary>128-bit hash value.</summary>
+struct Hash128
+{
+	uint64_t low 	= 0;
+	uint64_t high 	= 0;
+
+	auto hex() const -> String { return fmt::format("{:016x}{:016x}", high, low); }
+
+	auto operator==(Hash128 const& other_) const -> bool = default;
+};
+
+/////////////////////////////////////////
+/// <summary>
+/// 	Fast 128-bit hash of a buffer, for content hashes of files (not for security).
+/// 	Reads 32-byte stripes into 4 independent lanes, so the CPU processes them in parallel
+/// 	(and compilers can vectorize them), instead of one byte at a time like <c>Fnv1a</c>.
+/// </summary>
+/// <remarks>Words are read in the native byte order, so the hashes are meant for local caches only.</remarks>
+auto fastHash128(StringView bytes_) -> Hash128;
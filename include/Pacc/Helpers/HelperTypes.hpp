@@ -23,6 +23,21 @@ using Map = std::map<Key, Value>;
 template <typename Key, typename Value>
 using UMap = std::unordered_map<Key, Value>;
 
+template <typename T>
+using USet = std::unordered_set<T>;
+
+/// <summary>Transparent string hash, allows lookups by <c>StringView</c> without allocating.</summary>
+struct StringHash {
+	using is_transparent = void;
+
+	auto operator()(StringView str_) const noexcept -> std::size_t {
+		return std::hash<StringView>{}(str_);
+	}
+};
+
+template <typename Value>
+using StrUMap = std::unordered_map<std::string, Value, StringHash, std::equal_to<>>;
+
 // Memory:
 template <typename T>
 using UPtr = std::unique_ptr<T>;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>
+/// 	Writes JSON directly to a stream, without building a document first.
+/// 	Output is buffered and flushed in chunks, so memory use does not depend on the size of the output.
+/// </summary>
+/// <remarks>
+/// 	The writer does not validate the structure (f.e. a value without a key inside an object).
+/// 	Output is indented with tabs, like <c>json::dump(1, '\t')</c>.
+/// </remarks>
+class JsonWriter
+{
+public:
+	explicit JsonWriter(std::ostream& out_, bool pretty_ = true);
+	~JsonWriter();
+
+	JsonWriter(JsonWriter const&) = delete;
+	JsonWriter& operator=(JsonWriter const&) = delete;
+
+	auto beginObject() -> JsonWriter&;
+	auto endObject() -> JsonWriter&;
+	auto beginArray() -> JsonWriter&;
+	auto endArray() -> JsonWriter&;
+
+	auto key(StringView key_) -> JsonWriter&;
+
+	auto value(StringView value_) -> JsonWriter&;
+	auto value(char const* value_) -> JsonWriter& { return this->value(StringView(value_)); }
+	auto value(String const& value_) -> JsonWriter& { return this->value(StringView(value_)); }
+	auto value(bool value_) -> JsonWriter&;
+	auto value(double value_) -> JsonWriter&;
+	auto value(int64_t value_) -> JsonWriter&;
+	auto value(std::size_t value_) -> JsonWriter&;
+	auto value(int value_) -> JsonWriter& { return this->value(int64_t(value_)); }
+	auto null() -> JsonWriter&;
+
+	/// <summary>Writes a key and its value.</summary>
+	template <typename T>
+	auto field(StringView key_, T const& value_) -> JsonWriter&
+	{
+		return this->key(key_).value(value_);
+	}
+
+	/// <summary>Writes an array of strings.</summary>
+	auto stringArray(Vec<String> const& values_) -> JsonWriter&;
+
+	/// <summary>Writes the buffered output to the stream.</summary>
+	void flush();
+
+private:
+	void beginValue(); // separator and indentation before a value or a key
+	void newLine();
+	void writeString(StringView str_);
+	void flushIfFull();
+
+	std::ostream& 		out;
+	fmt::memory_buffer 	buffer;
+	Vec<bool> 			nonEmpty; 	// per nesting level: whether the container has elements
+	bool 				pretty;
+	bool 				afterKey = false;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/////////////////////////////////////////
+/// <summary>
+/// 	Calls <c>func_(i)</c> for each i in [0, count_) on all hardware threads
+/// 	(the calling thread included). Each worker takes the next unprocessed index.
+/// </summary>
+/// <remarks>Returns when all calls are done. The first exception thrown by a call is rethrown.</remarks>
+template <typename TFunc>
+void parallelFor(std::size_t count_, TFunc&& func_)
+{
+	auto next = std::atomic_size_t{0};
+
+	auto worker = [&]
+		{
+			for (auto i = next++; i < count_; i = next++)
+				func_(i);
+		};
+
+	auto numWorkers = std::min<std::size_t>(count_, std::max(1u, std::thread::hardware_concurrency()));
+
+	auto workers = Vec<std::future<void>>();
+	for (std::size_t i = 1; i < numWorkers; ++i)
+		workers.push_back(std::async(std::launch::async, worker));
+
+	// Stop the other workers early if this one fails, they are joined by the futures.
+	try {
+		worker();
+	}
+	catch(...) {
+		next = count_;
+		throw;
+	}
+
+	for (auto& w : workers)
+		w.get();
+}
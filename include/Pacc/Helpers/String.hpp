@@ -26,6 +26,14 @@ bool compareIgnoreCase(StringView l, StringView r);
 /////////////////////////////////////////////////
 String replaceAll(StringView source_, StringView from_, StringView to_);
 
+/////////////////////////////////////////////////
+/// <summary>
+/// 	Matches the path against a Premake file pattern:
+/// 	<c>*</c> matches within a folder name, <c>**</c> also matches across folders, <c>?</c> matches a single character.
+/// </summary>
+/// <remarks>Both should use forward slashes.</remarks>
+bool matchesGlob(StringView pattern_, StringView path_);
+
 struct IgnoreCaseLess
 {
 	// case-independent (ci) compare_less binary function
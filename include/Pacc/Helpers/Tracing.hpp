@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/Helpers/String.hpp>
+
+namespace tracing
+{
+
+/// <summary>
+/// 	Records time spans of the run and writes them in the Chrome trace-event format
+/// 	(viewable in Perfetto or chrome://tracing). Enabled with the "--trace" flag.
+/// </summary>
+/// <remarks>Thread-safe. When disabled, spans cost a single atomic load.</remarks>
+class Tracer
+{
+public:
+	struct Event
+	{
+		String 			name;
+		StringView 		category;
+		int64_t 		start 		= 0; // microseconds since the tracer was enabled
+		int64_t 		duration 	= 0; // microseconds
+		int 			threadId 	= 0;
+		Vec<StringPair> args 		= {};
+	};
+
+	/// <summary>Starts recording, the trace will be written to the <c>outputFile_</c>.</summary>
+	void enable(Path outputFile_);
+
+	auto enabled() const -> bool { return isEnabled.load(std::memory_order_relaxed); }
+
+	/// <summary>Microseconds since the tracer was enabled.</summary>
+	auto now() const -> int64_t;
+
+	void record(Event event_);
+
+	/// <summary>Writes the recorded events (if enabled) and stops recording.</summary>
+	void finish();
+
+private:
+	auto currentThreadId() -> int; // Small, stable numbers instead of native ids. Requires the lock.
+
+	std::atomic_bool 					isEnabled = false;
+	std::mutex 							mutex;
+	Path 								outputFile;
+	ch::steady_clock::time_point 		startTime;
+	Vec<Event> 							events;
+	Map<std::thread::id, int> 			threadIds;
+};
+
+/// <summary>Tracer of the program (singleton).</summary>
+auto tracer() -> Tracer&;
+
+/// <summary>Records the time from its creation to its destruction (RAII).</summary>
+class Span
+{
+public:
+	/// <remarks>`category_` has to outlive the span (use literals). The name is only copied if tracing is enabled.</remarks>
+	Span(StringView name_, StringView category_);
+	~Span();
+
+	/// <summary>Creates a span with a name formatted only if tracing is enabled.</summary>
+	template <typename... TArgs>
+	static auto formatted(StringView category_, fmt::format_string<TArgs...> name_, TArgs&&... args_) -> Span
+	{
+		auto& t = tracer();
+		if (!t.enabled())
+			return Span(std::nullopt);
+
+		return Span(Tracer::Event{ fmt::format(name_, std::forward<TArgs>(args_)...), category_, t.now() });
+	}
+
+	Span(Span const&) = delete;
+	Span& operator=(Span const&) = delete;
+
+	/// <summary>Adds an argument shown with the span (ignored if tracing is disabled).</summary>
+	auto arg(StringView name_, StringView value_) -> Span&;
+
+private:
+	explicit Span(Opt<Tracer::Event> event_);
+
+	Opt<Tracer::Event> event;
+};
+
+}
@@ -5,3 +5,7 @@
 #include <Pacc/Helpers/HelperTypes.hpp>
 
 using ProgramArgs = Vec< String >;
+
+/// <summary>Runs a pacc command and reports its errors.</summary>
+/// <returns>Exit code of the command.</returns>
+auto runPacc(ProgramArgs args_) -> int;
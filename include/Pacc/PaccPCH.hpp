@@ -18,12 +18,16 @@
 #include <optional>
 #include <variant>
 #include <thread>
+#include <mutex>
+#include <future>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <filesystem>
 #include <algorithm>
 #include <cctype>
 #include <queue>
+#include <unordered_set>
 
 #include <nlohmann/json.hpp>
 #include <fmt/format.h>
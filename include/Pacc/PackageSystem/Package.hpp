@@ -5,6 +5,7 @@
 #include <Pacc/Helpers/HelperTypes.hpp>
 #include <Pacc/PackageSystem/Dependency.hpp>
 #include <Pacc/PackageSystem/Events.hpp>
+#include <Pacc/PackageSystem/Property.hpp>
 #include <Pacc/Toolchains/Toolchain.hpp>
 
 struct Package;
@@ -23,6 +24,19 @@ auto getNumElements(VecOfStrAcc const& v) -> std::size_t;
 auto findPackageFile(Path const& directory_, Opt<StringView> extension_ = std::nullopt) -> Path;
 auto findPackageScriptFile(Path const& directory_) -> Path;
 
+/// <summary>Top-level package information, readable without loading the package.</summary>
+struct PackageMetadata
+{
+	String 	name; // empty if the package is named after its first project
+	Version version;
+	bool 	isCMake = false;
+};
+
+/// <summary>Reads only the top-level "name", "version" and "cmake" fields of the JSON manifest.</summary>
+/// <remarks>Projects, filters and event handlers are skipped, nothing is executed.</remarks>
+/// <returns>Metadata or nullopt if the manifest could not be read or parsed</returns>
+auto readPackageMetadata(Path const& manifest_) -> Opt<PackageMetadata>;
+
 /// <summary>GNU visibility mode</summary>
 /// <remarks>Check https://gcc.gnu.org/wiki/Visibility</remarks>
 struct GNUSymbolVisibility
@@ -87,18 +101,40 @@ struct Configuration
 	template <typename T>
 	using SaC = SelfAndComputed<T>;
 
+	/// <summary>Own strings and strings computed from the dependencies.</summary>
+	/// <remarks>
+	/// 	Computed values are views over the dependencies' storage (see <c>ArrayProperty</c>).
+	/// 	They are flattened (each value kept once, at its first occurrence) only when a generator walks them.
+	/// </remarks>
+	template <typename TTransformPolicy = policies::PassFurther>
+	struct Strings
+	{
+		using TransformPolicy 	= TTransformPolicy;
+		using Computed 			= ArrayProperty<String, policies::JoinUnique, TTransformPolicy>;
+
+		VecOfStrAcc 			self;
+		AccessSplit<Computed> 	computed;
+
+		void addComputed(AccessType access_, String value_)
+		{
+			targetByAccessType(computed, access_).add( std::move(value_) );
+		}
+	};
+
+	using PathStrings = Strings<policies::ResolvePath>;
+
 
 	GNUSymbolVisibility 			symbolVisibility;
 
 	String							moduleDefinitionFile;
 	Vec<String>						files;
 	SaC<AccessSplitVec<Dependency>> dependencies;
-	SaC<VecOfStrAcc>				defines;
-	SaC<VecOfStrAcc>				includeFolders;
-	SaC<VecOfStrAcc>				linkerFolders;
-	SaC<VecOfStrAcc>				linkedLibraries;
-	SaC<VecOfStrAcc>				compilerOptions;
-	SaC<VecOfStrAcc>				linkerOptions;
+	Strings<>						defines;
+	PathStrings						includeFolders;
+	PathStrings						linkerFolders;
+	Strings<>						linkedLibraries;
+	Strings<>						compilerOptions;
+	Strings<>						linkerOptions;
 };
 
 enum class Artifact {
@@ -136,9 +172,19 @@ struct TargetBase
 
 struct PrecompiledHeader
 {
-	String header;
-	String source;
-	String definition;
+	String header 		= {};
+	String source 		= {};
+	String definition 	= {};
+
+	bool automatic = false; // "auto": synthesized from the most included headers
+};
+
+/// <summary>Unity (jumbo) build: project sources compiled in batches, each batch as a single translation unit.</summary>
+struct UnityBuild
+{
+	bool 		enabled 	= true; 	// false: opted out (also of "--unity")
+	std::size_t batchSize 	= 8; 		// average number of sources in a batch
+	Vec<String> exclude; 				// patterns of sources compiled separately
 };
 
 enum class ProjectType
@@ -181,6 +227,7 @@ struct Project
 
 	String language;
 	Opt<PrecompiledHeader> pch;
+	Opt<UnityBuild> unity; // nullopt: not configured (enabled by "--unity")
 
 	Type type;
 
@@ -223,9 +270,6 @@ struct Package
 
 	static PackagePreloadInfo preload(Path dir_ = "");
 
-	void loadPackageSpecificInfo(json const& json_);
-	void loadWorkspaceInfo(json const& json_);
-
 	static UPtr<Package> load(Path dir_ = "")
 	{
 		return load( preload(dir_) );
@@ -236,6 +280,13 @@ struct Package
 	auto findProject(StringView name_) const -> Project const*;
 	auto requireProject(StringView name_) const -> Project const&;
 
+	/// <summary>Rebuilds the project name -> index lookup table.</summary>
+	/// <remarks>
+	/// 	Called automatically by <c>findProject</c> when the number of projects changed or the indexed project was renamed.
+	/// 	Call it after renaming projects, otherwise they are not found under their new names.
+	/// </remarks>
+	void reindexProjects() const;
+
 	auto predictOutputFolder(Project const& project_) const -> Path;
 	auto predictRealOutputFolder(Project const& project_, BuildSettings settings_ = {}) const -> Path;
 
@@ -252,7 +303,10 @@ struct Package
 	}
 
 private:
-	static bool loadFromJSON(Package& package_, String const& packageContent_);
+	static bool loadFromJSON(Package& package_, StringView packageContent_);
+
+	mutable StrUMap<std::size_t> 	projectIndex;
+	mutable std::size_t 			numIndexedProjects = 0;
 };
 
 
@@ -266,28 +320,19 @@ void mergeFields(Vec<T>& into_, Vec<T> const& from_, TMapValueFn&& mapValueFn_ =
 	}
 }
 
-template <typename T, typename TMapValueFn = ReturnIdentity>
-void mergeAccesses(T &into_, T const & from_, AccessType method_, TMapValueFn&& mapValueFn_ = TMapValueFn())
+/// <summary>Links interface and public values of <c>from_</c> into the computed field of <c>into_</c>.</summary>
+/// <remarks>Nothing is copied, values are resolved when the computed field is flattened.</remarks>
+template <typename T>
+void mergeAccesses(T &into_, T const & from_, AccessType method_, typename T::TransformPolicy transform_ = {})
 {
-	auto& target = targetByAccessType(into_.computed, method_); // by default
-
-	auto forBoth =
-		[](auto & selfAndComputed, auto const& whatToDo)
-		{
-			whatToDo(selfAndComputed.computed);
-			whatToDo(selfAndComputed.self);
-		};
+	auto& target = targetByAccessType(into_.computed, method_);
 
 	// Private is private
 	// Merge only interface and public:
-	auto mergeFieldsTarget =
-		[&](auto &selfOrComputed)
-		{
-			mergeFields(target, selfOrComputed.interface_, mapValueFn_);
-			mergeFields(target, selfOrComputed.public_, mapValueFn_);
-		};
-
-	forBoth(from_, mergeFieldsTarget);
+	target.link(from_.computed.interface_, transform_);
+	target.link(from_.computed.public_, transform_);
+	target.link(from_.self.interface_, transform_);
+	target.link(from_.self.public_, transform_);
 }
 
 /// <summary>Merges configuration into target configuration (computed field).</summary>
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+struct Package;
+
+/// <summary>
+/// 	Parsed JSON manifests kept in memory by the pacc daemon, by manifest path.
+/// 	Packages with a script file or a CMake build are never cached.
+/// </summary>
+/// <remarks>
+/// 	Packages are moved out of the cache (they are not copyable), so the cache is meant
+/// 	to be filled by a long-running process and consumed by its forked children.
+/// 	Manifests parsed because of a cache miss are recorded, so that the long-running process can load them too.
+/// </remarks>
+class PackageCache
+{
+public:
+	PackageCache();
+	~PackageCache();
+
+	/// <summary>Removes the package from the cache.</summary>
+	/// <returns>The package or <c>nullptr</c> if it was not cached.</returns>
+	auto take(Path const& root_) -> UPtr<Package>;
+
+	void store(UPtr<Package> package_);
+
+	/// <summary>Forgets every package with a manifest inside the folder.</summary>
+	void invalidateFolder(Path const& folder_);
+	void clear();
+
+	void recordMiss(Path const& root_);
+	auto takeMisses() -> Vec<Path>;
+
+	auto size() const -> std::size_t { return packages.size(); }
+
+	bool enabled = false;
+
+private:
+	StrUMap< UPtr<Package> > 	packages;
+	Vec<Path> 					misses;
+};
+
+/// <summary>Returns the package cache of the process.</summary>
+auto packageCache() -> PackageCache&;
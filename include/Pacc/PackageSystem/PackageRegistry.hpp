@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/PackageSystem/Version.hpp>
+
+/// <summary>
+/// 	Index of the installed packages (package folder name -> location and version),
+/// 	for each of the package folders (f.e. "pacc_packages" or the global "packages" folder).
+/// </summary>
+/// <remarks>
+/// 	The index is stored in a JSON file and a package folder is scanned again only when
+/// 	its modification time changed. Install, uninstall, link and unlink update it incrementally.
+/// </remarks>
+class PackageRegistry
+{
+public:
+	struct Entry
+	{
+		String 			name;
+		Path 			location; 				// absolute
+		Path 			manifest; 				// empty if the package has no pacc manifest
+		Opt<Version> 	version; 				// nullopt if it cannot be known without loading the package
+		bool 			isLink 			= false;
+		int64_t 		manifestTime 	= 0;
+	};
+
+	explicit PackageRegistry(Path storageFile_);
+
+	/// <summary>Finds the package inside the package folder.</summary>
+	/// <returns>The entry or nullopt if the package is not there.</returns>
+	auto find(Path const& packagesFolder_, StringView name_) -> Opt<Entry>;
+
+	/// <summary>Returns all packages inside the package folder.</summary>
+	auto packagesIn(Path const& packagesFolder_) -> Vec<Entry>;
+
+	/// <summary>Reads (again) a single package, f.e. after it was installed or linked.</summary>
+	void update(Path const& packagesFolder_, StringView name_);
+
+	/// <summary>Removes a single package, f.e. after it was uninstalled or unlinked.</summary>
+	void remove(Path const& packagesFolder_, StringView name_);
+
+	/// <summary>Makes the next lookups validate every folder again, f.e. when packages could have been installed in the meantime.</summary>
+	void invalidate();
+
+	/// <summary>Reads the manifest of the package folder.</summary>
+	static auto readEntry(Path const& location_) -> Opt<Entry>;
+
+private:
+	struct Folder
+	{
+		int64_t 		time 	= 0;
+		bool 			checked = false; // was the time validated during this run
+		StrUMap<Entry> 	packages;
+	};
+
+	auto folderOf(Path const& packagesFolder_) -> Folder*;
+	void rescan(Folder& folder_, Path const& path_, int64_t time_);
+	auto refreshed(Entry entry_) -> Opt<Entry>;
+
+	void load();
+	void save() const;
+
+	Path 				storageFile;
+	StrUMap<Folder> 	folders;
+	bool 				loaded = false;
+};
@@ -2,78 +2,198 @@
 
 #include <Pacc/PaccPCH.hpp>
 
+#include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/PackageSystem/Dependency.hpp>
+#include <Pacc/System/Filesystem.hpp>
+
 namespace policies
 {
 
 ////////////////////////////////////
+/// <summary>Appends every value, in order.</summary>
+template <typename TValue>
 class Join
 {
 public:
-	template <typename TProp, typename TTransformPolicy>
-	void operator()(TProp & left_, TProp const& right_, TTransformPolicy transformPolicy_ = {})
+	static constexpr bool Unique = false;
+
+	void operator()(Vec<TValue> & into_, TValue value_)
 	{
-		left_.content.reserve(right_.content.size());
-		for (auto const& elem : right_.content)
-		{
-			left_.content.push_back( transformPolicy_(elem) );
-		}
+		into_.push_back( std::move(value_) );
 	}
 };
 
+////////////////////////////////////
+/// <summary>Appends only values that were not seen yet (first occurrence wins).</summary>
+template <typename TValue>
+class JoinUnique
+{
+public:
+	static constexpr bool Unique = true;
+
+	void operator()(Vec<TValue> & into_, TValue value_)
+	{
+		if (seen.insert(value_).second)
+			into_.push_back( std::move(value_) );
+	}
+
+private:
+	USet<TValue> seen;
+};
+
 ////////////////////////////////////
 class PassFurther
 {
 public:
 	template <typename T>
-	T operator()(T && toPass_) const
+	T operator()(T toPass_) const
 	{
-		return std::forward<T>(toPass_);
+		return toPass_;
 	}
 };
 
 ////////////////////////////////////
+/// <summary>Makes relative paths relative to the <c>basePath</c>.</summary>
 class ResolvePath
 {
 public:
-	fs::path basePath;
+	Path basePath;
 
-	template <typename T>
-	T operator()(T && path_) const
+	String operator()(String path_) const
 	{
-		if (path_.is_relative())
+		if (Path(path_).is_relative())
 			return fsx::fwd(basePath / path_).string();
-		else
-			return path_;
+
+		return path_;
 	}
-}
+};
 
 }
 
 ////////////////////////////////////
+/// <summary>
+/// 	An array that holds its own values and links to other arrays (or properties)
+/// 	without copying them.
+/// </summary>
+/// <remarks>
+/// 	Links are not resolved until the property is flattened, so the linked storage
+/// 	must outlive the property. Own values and links keep their relative order.
+/// </remarks>
 template <
-		typename TMergePolicy 		= policies::Join,
-		typename TTransformPolicy 	= policies::PassFurther
+		typename 					TValue,
+		template <typename> class 	TMergePolicy 		= policies::Join,
+		typename 					TTransformPolicy 	= policies::PassFurther
 	>
 class ArrayProperty
 {
-	using ValueType 		= TValueType;
-	using MergePolicy 		= TMergePolicy;
+public:
+	using ValueType 		= TValue;
+	using MergePolicy 		= TMergePolicy<TValue>;
 	using TransformPolicy 	= TTransformPolicy;
 
-	MergePolicy* 		mergePolicy 	= nullptr;
-	TransformPolicy* 	transformPolicy	= nullptr;
+	/// <summary>Appends own value.</summary>
+	void add(ValueType value_)
+	{
+		content.push_back( std::move(value_) );
+	}
+
+	/// <summary>Links values stored in the vector. Each one will be transformed on flattening.</summary>
+	void link(Vec<ValueType> const& values_, TransformPolicy transform_ = {})
+	{
+		links.push_back( Link{ &values_, nullptr, std::move(transform_), content.size() } );
+	}
+
+	/// <summary>Links the other property (with all of its links).</summary>
+	void link(ArrayProperty const& property_, TransformPolicy transform_ = {})
+	{
+		links.push_back( Link{ nullptr, &property_, std::move(transform_), content.size() } );
+	}
+
+	/// <summary>Resolves all the links and merges the values with the merge policy.</summary>
+	auto flatten() const -> Vec<ValueType>
+	{
+		auto ctx = FlattenContext{};
+		this->flattenInto(ctx);
+		return std::move(ctx.result);
+	}
+
+	auto ownValues() const -> Vec<ValueType> const& { return content; }
+	auto numLinks() const -> std::size_t { return links.size(); }
+
+private:
+	struct Link
+	{
+		Vec<ValueType> const* 	values;
+		ArrayProperty const* 	property;
+		TransformPolicy 		transform;
+		std::size_t 			contentOffset; // number of own values added before the link
+	};
+
+	struct FlattenContext
+	{
+		Vec<ValueType> 					result;
+		MergePolicy 					merge;
+		Vec<TransformPolicy const*> 	transforms; // outermost first
+		USet<ArrayProperty const*> 		visited;
+	};
 
-	void mergeWith(ArrayProperty const& other_)
+	void flattenInto(FlattenContext & ctx_) const
 	{
-		auto doMerge = [&](auto const& merger) {
-				merger(*this, other_, transformPolicy_ ? *transformPolicy_ : TransformPolicy{});
+		auto emit = [&](ValueType const& value_)
+			{
+				auto value = value_;
+				for (auto it = ctx_.transforms.rbegin(); it != ctx_.transforms.rend(); ++it)
+					value = (**it)(std::move(value));
+
+				ctx_.merge(ctx_.result, std::move(value));
 			};
 
-		if (mergePolicy)
-			doMerge(*mergePolicy);
-		else
-			doMerge(MergePolicy{});
+		std::size_t contentIdx = 0;
+		for (auto const& l : links)
+		{
+			for (; contentIdx < l.contentOffset; ++contentIdx)
+				emit(content[contentIdx]);
+
+			ctx_.transforms.push_back(&l.transform);
+
+			if (l.values)
+			{
+				for (auto const& value : *l.values)
+					emit(value);
+			}
+			// With unique merging, a property reached again (diamond dependency)
+			// would only produce duplicates.
+			else if (!MergePolicy::Unique || ctx_.visited.insert(l.property).second)
+				l.property->flattenInto(ctx_);
+
+			ctx_.transforms.pop_back();
+		}
+
+		for (; contentIdx < content.size(); ++contentIdx)
+			emit(content[contentIdx]);
 	}
 
-	Vec<ValueType> content;
+	Vec<ValueType> 	content;
+	Vec<Link> 		links;
 };
+
+/////////////////////////////////////////////////
+/// <summary>Flattens selected accesses of the split property.</summary>
+template <typename TValue, template <typename> class TMergePolicy, typename TTransformPolicy>
+auto flattenAccesses(
+		AccessSplit<ArrayProperty<TValue, TMergePolicy, TTransformPolicy>> const& split_,
+		MultiAccess accesses_ = MultiAccess::All
+	)
+	-> AccessSplitVec<TValue>
+{
+	auto result = AccessSplitVec<TValue>{};
+
+	if (accesses_ & MultiAccess::Private)
+		result.private_ = split_.private_.flatten();
+	if (accesses_ & MultiAccess::Public)
+		result.public_ = split_.public_.flatten();
+	if (accesses_ & MultiAccess::Interface)
+		result.interface_ = split_.interface_.flatten();
+
+	return result;
+}
@@ -4,6 +4,7 @@
 
 #include <Pacc/PackageSystem/IPackageLoader.hpp>
 #include <Pacc/Build/IPackageBuilder.hpp>
+#include <Pacc/System/Filesystem.hpp>
 
 namespace plugins::cmake
 {
@@ -14,7 +15,11 @@ struct BuildInfo {
 	// TODO: add more info
 };
 
-BuildInfo runBuildInfoQuery(fs::path const& packagePath_);
+/// <summary>
+/// 	Configures the package with CMake (when its inputs changed) to get the file-API reply.
+/// 	Uses the generator of the toolchain (selected one by default).
+/// </summary>
+BuildInfo runBuildInfoQuery(fs::path const& packagePath_, BuildSettings const& settings_ = {}, Toolchain const* toolchain_ = nullptr);
 
 class PackageLoader
 	: public IPackageLoader
@@ -24,14 +29,14 @@ public:
 
 	auto canLoad(fs::path const& root_) const -> bool override
 	{
-		return fs::is_directory(root_) && fs::is_regular_file(root_ / "CMakeLists.txt");
+		return fsx::dirCache().isRegularFile(root_ / "CMakeLists.txt");
 	}
 
 	auto load(fs::path const& root_) -> UPtr<Package> override;
 	auto loadTarget(fs::path const& root_, String const& name_, TargetBase& target_) -> bool override;
 
 protected:
-	auto discoverTargets(json const& json_) const -> Vec<StringPair>;
+	auto discoverTargets(json const& json_, StringView configName_) const -> Vec<StringPair>;
 	auto loadProjectFromFile(fs::path const& file, Project& project_) -> bool;
 	auto loadVersion(fs::path const& root_) -> Version;
 };
@@ -3,17 +3,21 @@
 #include <Pacc/PaccPCH.hpp>
 
 #include <Pacc/PackageSystem/Package.hpp>
-#include <Pacc/Helpers/Json.hpp>
+#include <Pacc/PackageSystem/Events.hpp>
 
-class PackageJsonReader
-	: public BasicJsonView<json> // non-const
-{
-public:
-	using BasicJsonView::BasicJsonView;
+/// <summary>
+/// 	Reads the pacc.json content directly into the package in a single pass (SAX),
+/// 	without building a JSON document first.
+/// </summary>
+/// <remarks>
+/// 	Accepts the same formats as before (workspace, single project, array of projects),
+/// 	throws the same validation errors. Only "events" are kept as JSON, because event actions load from JSON.
+/// </remarks>
+void readPackageJson(Package& package_, StringView content_);
 
-	/// <summary>
-	/// 	Makes sure that provided json can be further processed,
-	/// 	f.e.: ensures that projects are inside a workspace.
-	/// </summary>
-	void makeConformant();
-};
+/// <summary>Reads event handlers ("events" field value) of the target.</summary>
+void readTargetEventHandlers(
+		PaccAppModule_EventHandlerActions const&	events_,
+		json const&									scripts_,
+		EventHandlingTarget&						target_
+	);
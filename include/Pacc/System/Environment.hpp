@@ -32,4 +32,11 @@ fs::path findExecutable(StringView execName_);
 /// </summary>
 fs::path getPaccAppPath();
 
+/// <summary>
+/// 	Memory (in bytes) that new processes can use without swapping: "MemAvailable" in /proc/meminfo,
+/// 	lowered to the unused part of the memory limits of the cgroup pacc runs in.
+/// </summary>
+/// <returns>std::nullopt if unknown (f.e. on Windows).</returns>
+Opt<std::uint64_t> availableMemory();
+
 }
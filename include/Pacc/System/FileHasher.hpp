@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/Helpers/Hash.hpp>
+
+/// <summary>
+/// 	Content hashes of files (<c>fastHash128</c>), computed on all hardware threads.
+/// 	Hashes are remembered by path, inode, size and modification time in a table file,
+/// 	so unchanged files are not read again, in later runs too.
+/// </summary>
+/// <remarks>
+/// 	Loading and saving the table reads the whole file, so a command should use one hasher
+/// 	for all its lookups and save it once.
+/// 	Files modified in the last seconds are hashed but not remembered: a later write within
+/// 	the resolution of the modification time would not be noticed otherwise.
+/// </remarks>
+class FileHasher
+{
+public:
+	struct Stats
+	{
+		std::size_t read 		= 0; 	// files read and hashed
+		std::size_t reused 		= 0; 	// hashes taken from the table
+		std::size_t bytesRead 	= 0;
+	};
+
+	/// <summary>Remembered hash and the state of the file it was computed from.</summary>
+	struct Entry
+	{
+		uint64_t 	inode 	= 0; 	// 0 where not available (Windows)
+		uint64_t 	size 	= 0;
+		int64_t 	mtime 	= 0;
+		Hash128 	hash;
+	};
+
+	/// <summary>Loads the table, by default "file_hashes.bin" in the pacc data folder.</summary>
+	explicit FileHasher(Path tableFile_ = defaultTableFile());
+
+	/// <returns>Hash of the file contents, nullopt if the file cannot be read.</returns>
+	auto hash(Path const& file_) -> Opt<Hash128>;
+
+	/// <returns>Hashes of the files, in the same order.</returns>
+	auto hashAll(Vec<Path> const& files_) -> Vec<Opt<Hash128>>;
+
+	/// <summary>
+	/// 	Stores the table if it changed. Entries written by other processes in the meantime are kept,
+	/// 	entries of files found missing by this hasher are dropped.
+	/// </summary>
+	void save();
+
+	auto stats() const -> Stats const& { return counters; }
+
+	static auto defaultTableFile() -> Path;
+
+private:
+	Path 			tableFile;
+	StrUMap<Entry> 	entries;
+	StrUMap<Entry> 	added; 		// since the table was loaded
+	Stats 			counters;
+	USet<String> 	removed; 	// remembered files found missing since the table was loaded
+};
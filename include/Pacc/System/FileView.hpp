@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>
+/// 	Read-only view of the whole file contents, mapped into memory (no copy on the heap).
+/// 	Converts to <c>StringView</c> and can be passed directly to <c>json::parse</c>.
+/// </summary>
+/// <remarks>
+/// 	The view (and anything that points into it) is valid as long as the object lives.
+/// 	Do not write to the file while it is viewed: a file truncated while mapped crashes the process (SIGBUS),
+/// 	so files edited by the user (f.e. manifests) are read with <c>readFileContents</c> instead.
+/// </remarks>
+class FileView
+{
+public:
+	/// <summary>Maps the file. Throws <c>PaccException</c> if it cannot be opened.</summary>
+	explicit FileView(Path const& path_);
+	~FileView();
+
+	FileView(FileView&& other_) noexcept;
+	FileView& operator=(FileView&& other_) noexcept;
+
+	FileView(FileView const&) = delete;
+	FileView& operator=(FileView const&) = delete;
+
+	auto view() const -> StringView { return StringView(ptr, len); }
+	operator StringView() const 	{ return this->view(); }
+
+	auto data() const -> char const* 	{ return ptr; }
+	auto size() const -> std::size_t 	{ return len; }
+	auto begin() const -> char const* 	{ return ptr; }
+	auto end() const -> char const* 	{ return ptr + len; }
+
+private:
+	void close();
+
+	char const* 	ptr = "";
+	std::size_t 	len = 0;
+	bool 			mapped = false;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>
+/// 	Reports files created, written, removed or renamed inside the watched folders (inotify).
+/// 	Supported on Linux only, the constructor throws <c>PaccException</c> elsewhere.
+/// </summary>
+/// <remarks>
+/// 	Folders created inside a recursively watched folder are watched automatically
+/// 	and the files they already contain are reported as changed.
+/// </remarks>
+class FileWatcher
+{
+public:
+	struct Changes
+	{
+		Vec<Path> 	files; 			// absolute paths (forward slashes), without duplicates
+		bool 		all = false; 	// events were lost (the kernel queue overflowed), anything may have changed
+	};
+
+	FileWatcher();
+	~FileWatcher();
+
+	FileWatcher(FileWatcher const&) = delete;
+	FileWatcher& operator=(FileWatcher const&) = delete;
+
+	/// <summary>Watches the folder (and its subfolders if <paramref name="recursive_"/>). Missing folders are ignored.</summary>
+	void watch(Path const& folder_, bool recursive_ = false);
+
+	/// <summary>Stops watching all folders.</summary>
+	void clear();
+
+	/// <summary>
+	/// 	Waits for the first change, then collects changes until none arrive for <paramref name="debounce_"/>,
+	/// 	so a burst of saves is reported at once.
+	/// </summary>
+	auto waitForChanges(ch::milliseconds debounce_) -> Changes;
+
+private:
+	struct Folder
+	{
+		Path path;
+		bool recursive = false;
+	};
+
+	void addWatch(Path const& folder_, bool recursive_, Vec<Path>* existingFiles_);
+	void readEvents(StrUMap<Path>& changes_, bool& overflowed_);
+
+	int 				fd = -1;
+	UMap<int, Folder> 	folders; 			// by watch descriptor
+	StrUMap<int> 		watchDescriptors; 	// by folder
+	bool 				warnedLimit = false; // about the watch limit, once
+};
@@ -2,6 +2,8 @@
 
 #include <Pacc/PaccPCH.hpp>
 
+#include <Pacc/Helpers/HelperTypes.hpp>
+
 // File system extension
 namespace fsx
 {
@@ -23,5 +25,53 @@ fs::path readSymlinkOrJunction(fs::path const& path);
 void createSymlink(fs::path const& target, fs::path const& link, bool junctionIfAvailable, std::error_code& err);
 void createSymlink(fs::path const& target, fs::path const& link, bool junctionIfAvailable);
 
+/// <summary>
+/// 	Per-run cache of directory listings.
+/// 	Answers existence and type checks with a single directory read per folder.
+/// </summary>
+/// <remarks>
+/// 	Entries are not refreshed automatically.
+/// 	Call <c>invalidate</c> after the folder contents were changed by pacc (install, link, etc.).
+/// </remarks>
+class DirectoryCache
+{
+public:
+	auto exists(fs::path const& path_) -> bool;
+	auto isRegularFile(fs::path const& path_) -> bool;
+	auto isDirectory(fs::path const& path_) -> bool;
+
+	/// <summary>Forgets the listing of the path and of its parent folder.</summary>
+	void invalidate(fs::path const& path_);
+	void clear();
+
+private:
+	struct Listing
+	{
+		StrUMap<fs::file_type> entries;
+	};
+
+	auto typeOf(fs::path const& path_) -> fs::file_type;
+	auto listingOf(String const& dir_) -> Listing const&;
+
+	std::mutex 			mutex;
+	StrUMap<Listing> 	listings;
+};
+
+/// <summary>Returns the directory cache shared by the whole run.</summary>
+auto dirCache() -> DirectoryCache&;
+
+/// <summary>Returns the folder to search for files matching the Premake pattern and whether to search its subfolders.</summary>
+auto globBase(StringView pattern_) -> std::pair<fs::path, bool>;
+
+/// <summary>Returns the files (forward slashes, sorted) matching the absolute Premake pattern (see <c>matchesGlob</c>).</summary>
+auto glob(StringView pattern_) -> Vec<fs::path>;
+
+/// <summary>
+/// 	Writes the file under a temporary name in the same folder and renames it over the target,
+/// 	so that other processes read either the old or the new contents (never a partial file).
+/// </summary>
+/// <returns><c>false</c> if it could not be written, the target is left unchanged.</returns>
+auto replaceFile(fs::path const& path_, StringView contents_) -> bool;
+
 
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>
+/// 	Stream sockets used by the daemon and the build workers.
+/// 	Addresses are "unix:{path}" for Unix domain sockets and "{host}:{port}" for TCP.
+/// </summary>
+/// <remarks>Supported on Linux only, other systems fail to connect or listen.</remarks>
+namespace net
+{
+
+/// <summary>Owns a file descriptor (closed on destruction).</summary>
+struct FileDescriptor
+{
+	int fd = -1;
+
+	explicit FileDescriptor(int fd_ = -1) : fd(fd_) {}
+	~FileDescriptor() { this->close(); }
+
+	FileDescriptor(FileDescriptor const&) = delete;
+	FileDescriptor& operator=(FileDescriptor const&) = delete;
+
+	void close();
+};
+
+/// <returns><c>false</c> if the connection was closed or failed before all data was written.</returns>
+auto writeAll(int fd_, void const* data_, std::size_t size_) -> bool;
+
+/// <returns><c>false</c> if the connection was closed or failed before all data was read.</returns>
+auto readAll(int fd_, void* data_, std::size_t size_) -> bool;
+
+/// <summary>Writes the data prefixed with its size (32-bit, network byte order).</summary>
+auto writeFrame(int fd_, StringView data_) -> bool;
+
+/// <summary>Reads data written with <c>writeFrame</c>.</summary>
+/// <returns>nullopt if the connection failed or the frame is larger than <c>maxSize_</c>.</returns>
+auto readFrame(int fd_, std::size_t maxSize_) -> Opt<String>;
+
+/// <summary>Connects to the address, waiting at most <c>timeout_</c> for the connection.</summary>
+/// <returns>The socket or -1 if the connection failed.</returns>
+auto connectTo(StringView address_, Opt<ch::milliseconds> timeout_ = std::nullopt) -> int;
+
+/// <summary>Makes reads fail when no data arrives for <c>timeout_</c>.</summary>
+void setReceiveTimeout(int fd_, ch::milliseconds timeout_);
+
+/// <summary>Starts listening on the address. Unix domain sockets are accessible only by the current user.</summary>
+/// <exception cref="PaccException">The address is invalid or in use.</exception>
+auto listenOn(StringView address_) -> int;
+
+/// <returns><c>true</c> for Unix domain sockets and hosts that resolve only to loopback addresses (f.e. "127.0.0.1:7340", "localhost:7340").</returns>
+auto isLocalAddress(StringView address_) -> bool;
+
+}
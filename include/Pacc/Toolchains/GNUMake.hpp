@@ -18,6 +18,15 @@ struct GNUMakeToolchain : Toolchain
 	// TODO: Choose between "gmake" and "gmake2"
 	virtual String premakeToolchainType() const { return "gmake2"; }
 
+	/// <summary>Ninja when available, Unix Makefiles otherwise.</summary>
+	virtual String cmakeGenerator() const override;
+
+	/// <summary>GNU Make 4.4 and newer (named pipe jobservers).</summary>
+	virtual bool supportsJobServer() const override;
+
+	/// <summary>Unix Makefiles, or Ninja 1.13 and newer (older versions ignore named pipe jobservers).</summary>
+	virtual bool cmakeGeneratorSupportsJobServer() const override;
+
 	virtual Opt<int> run(Package const & pkg_, BuildSettings settings_ = {}, int verbosityLevel_ = 0) override;
 
 	static Vec<GNUMakeToolchain> detect();
@@ -28,6 +28,8 @@ struct MSVCToolchain : Toolchain
 
 	virtual String premakeToolchainType() const override;
 
+	virtual String cmakeGenerator() const override;
+
 	static Vec<MSVCToolchain> detect();
 
 private:
@@ -31,6 +31,15 @@ struct Toolchain
 
 	virtual String premakeToolchainType() const;
 
+	/// <summary>CMake generator ("-G") matching the toolchain, empty for the CMake's default.</summary>
+	virtual String cmakeGenerator() const;
+
+	/// <summary>Whether its builds can share a GNU make jobserver ("--jobserver-auth=fifo:").</summary>
+	virtual bool supportsJobServer() const;
+
+	/// <summary>Whether builds with its CMake generator take their jobs from the shared jobserver as well.</summary>
+	virtual bool cmakeGeneratorSupportsJobServer() const;
+
 
 	virtual bool generateProjectFiles();
 
@@ -3,13 +3,69 @@
 #include <Pacc/PaccPCH.hpp>
 
 #include <Pacc/Helpers/HelperTypes.hpp>
+#include <Pacc/Generation/BuildQueueBuilder.hpp>
 
 struct Package;
 
 namespace viz
 {
 
-auto generateGraphContent(Package const& root_) -> String;
+enum class GraphFormat
+{
+	Dot, 	// Graphviz
+	Json
+};
+
+auto parseGraphFormat(StringView str_) -> Opt<GraphFormat>;
+
+/// <summary>
+/// 	Resolved package and project graph.
+/// 	Packages carry their last measured build duration and the critical path
+/// 	(the dependency chain with the longest total build time) is marked.
+/// </summary>
+/// <remarks>
+/// 	Packages are built as a whole, so durations are measured per package.
+/// 	If no package was built yet, every package counts as one step (the longest chain is marked).
+/// </remarks>
+struct BuildGraph
+{
+	struct PackageNode
+	{
+		Package const* 	package;
+		Opt<double> 	buildMs 	= {}; 	// last measured build duration
+		double 			finishMs 	= 0; 	// build time including the slowest dependency chain
+		Opt<std::size_t> next 		= {}; 	// next package on the slowest chain
+		bool 			critical 	= false;
+	};
+
+	struct ProjectNode
+	{
+		Project const* 	project;
+		std::size_t 	package;
+	};
+
+	struct Edge
+	{
+		std::size_t 	from; 	// dependent project
+		std::size_t 	to; 	// dependency project
+		AccessType 		access;
+		bool 			critical = false;
+	};
+
+	Vec<PackageNode> 	packages; // root first
+	Vec<ProjectNode> 	projects; // grouped by package
+	Vec<Edge> 			edges;
+
+	Vec<std::size_t> 	criticalPath; 	// package indices, from the root
+	double 				criticalPathMs = 0;
+	bool 				measured = false; // at least one build duration is known
+
+	/// <summary>Builds the graph from the queue of <c>BuildQueueBuilder::setup</c>.</summary>
+	static auto build(Package const& root_, BuildQueueBuilder::DepQueue const& queue_, StrUMap<double> const& buildDurations_)
+		-> BuildGraph;
+};
 
+/// <summary>Writes the graph in chunks, without building the whole output in memory.</summary>
+void writeGraph(std::ostream& out_, BuildGraph const& graph_, GraphFormat format_);
 
 }
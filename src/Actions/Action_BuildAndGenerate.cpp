@@ -4,6 +4,13 @@
 
 #include <Pacc/Readers/General.hpp>
 #include <Pacc/System/Process.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
+#include <Pacc/Build/CompileProfile.hpp>
+#include <Pacc/Build/InputFingerprint.hpp>
+#include <Pacc/Build/DistributedBuild.hpp>
+#include <Pacc/Build/JobServer.hpp>
+#include <Pacc/Generation/Logs.hpp>
+#include <Pacc/System/Environment.hpp>
 
 ///////////////////////////////////////////////////
 void setupBuildQueue(Package & pkg, BuildQueueBuilder& depQueue)
@@ -51,6 +58,129 @@ void handleBuildResult(ChildProcess::ExitCode exitStatus_, bool isDependency_)
 	lastLogNotice();
 }
 
+///////////////////////////////////////////////////
+/// <summary>Selects the reachable workers ("--distribute") and the number of jobs make runs at the same time.</summary>
+static void distributeCompilation(PaccApp const& app_, Toolchain const& toolchain_, BuildSettings& settings_)
+{
+	using fmt::fg, fmt::color;
+
+	if (toolchain_.type() != Toolchain::GNUMake)
+	{
+		fmt::print(fg(color::yellow), "Warning: distributed builds require a GNU Make toolchain, \"--distribute\" ignored.\n");
+		return;
+	}
+
+	auto addresses = app_.cfg.workers;
+	if (auto& flag = *app_.settings.flags.at("--workers"); flag.isSet() && flag.value != "true")
+	{
+		addresses.clear();
+		for (auto list = flag.value; !list.empty(); )
+		{
+			auto end = list.find(',');
+			if (auto address = list.substr(0, end); !address.empty())
+				addresses.emplace_back(address);
+
+			list.remove_prefix(end == StringView::npos ? list.size() : end + 1);
+		}
+	}
+
+	if (addresses.empty())
+	{
+		throw PaccException("No workers to distribute the build to.")
+			.withHelp("List their addresses in \"workers\" in \"{}\" or use \"--workers=host:port,unix:/path/to/socket\".", fsx::fwd(app_.cfg.path).string());
+	}
+
+	auto workers = distributed::probeWorkers(addresses);
+	if (workers.size() < addresses.size())
+	{
+		fmt::print(fg(color::yellow), "Warning: {} of {} workers did not respond (not running or a different pacc version).\n",
+				addresses.size() - workers.size(), addresses.size()
+			);
+	}
+
+	if (workers.empty())
+	{
+		fmt::print(fg(color::yellow), "Warning: no workers available, building locally.\n");
+		return;
+	}
+
+	// Sent by the launchers run by make
+	distributed::useToken(app_.cfg.workerToken);
+
+	auto slots = 0;
+	for (auto const& worker : workers)
+	{
+		slots += worker.slots;
+		settings_.workers.push_back(worker.address);
+	}
+
+	// Preprocessing and linking run locally
+	if (!settings_.cores)
+		settings_.cores = int(std::max(1u, std::thread::hardware_concurrency())) + slots;
+
+	fmt::print(fg(color::light_gray), "Distributing compilation to {} workers ({} slots), {} jobs at a time.\n", workers.size(), slots, *settings_.cores);
+}
+
+///////////////////////////////////////////////////
+/// <summary>
+/// 	Creates the jobserver of the command ("--cores") or joins the one of the make running pacc,
+/// 	so that all builds together run at most that many jobs.
+/// </summary>
+static auto shareJobServer(Toolchain const& toolchain_, BuildSettings& settings_) -> UPtr<JobServer>
+{
+	if (!toolchain_.supportsJobServer())
+		return nullptr;
+
+	auto jobServer = settings_.cores ? JobServer::create(*settings_.cores) : JobServer::join();
+	if (jobServer)
+		settings_.sharedJobServer = true;
+
+	return jobServer;
+}
+
+///////////////////////////////////////////////////
+/// <summary>
+/// 	Creates the pool that limits the links of all builds ("linkJobs" in settings.json or as many
+/// 	as fit in the available memory, "linkJobMemory" MiB each). Compilations keep all <c>jobs_</c>.
+/// </summary>
+static auto shareLinkPool(PaccApp const& app_, Toolchain const& toolchain_, BuildSettings& settings_, int jobs_) -> UPtr<JobServer>
+{
+	using fmt::fg, fmt::color;
+
+	if (toolchain_.type() != Toolchain::GNUMake)
+		return nullptr;
+
+	// Joined: the pool of the pacc (f.e. a package event) or make running this one
+	if (auto pool = JobServer::joinPool(distributed::LinkPoolVariable))
+	{
+		settings_.linkPool = true;
+		return pool;
+	}
+
+	auto linkJobs = app_.cfg.linkJobs;
+	if (!linkJobs)
+	{
+		auto memory = env::availableMemory();
+		if (!memory)
+			return nullptr;
+
+		linkJobs = int(std::max<std::uint64_t>(1, *memory / (std::uint64_t(app_.cfg.linkJobMemory) * 1024 * 1024)));
+	}
+
+	// No more links than jobs run anyway
+	if (*linkJobs >= jobs_)
+		return nullptr;
+
+	auto pool = JobServer::createPool(*linkJobs, distributed::LinkPoolVariable);
+	if (!pool)
+		return nullptr;
+
+	settings_.linkPool = true;
+
+	fmt::print(fg(color::light_gray), "Linking at most {} binaries at a time ({} jobs).\n", *linkJobs, jobs_);
+	return pool;
+}
+
 
 ///////////////////////////////////////////////////
 void PaccApp::generate()
@@ -75,6 +205,9 @@ auto PaccApp::runPremakeGeneration(StringView toolchainName_) -> void
 {
 	using fmt::fg, fmt::color;
 
+	auto span = tracing::Span("premake5", "generation");
+	span.arg("action", toolchainName_);
+
 	fmt::print(fg(color::gray), "Running Premake5... ");
 
 	auto command = fmt::format("\"{}\" {}", this->getPremake5Path().string(), toolchainName_);
@@ -96,11 +229,23 @@ auto PaccApp::runPremakeGeneration(StringView toolchainName_) -> void
 }
 
 ///////////////////////////////////////////////////
-void PaccApp::ensureProjectsAreBuilt(Package& pkg_, Vec<String> const& projectNames_, BuildSettings const& settings_)
+void PaccApp::ensureProjectsAreBuilt(Package& pkg_, Vec<String> const& projectNames_, BuildSettings const& settings_, InputFingerprints& fingerprints_)
 {
 	auto rootFolder = pkg_.root.parent_path();
 	auto prevWorkingDir = fs::current_path();
 
+	auto& tc = *cfg.currentToolchain();
+
+	struct StaleProject
+	{
+		String 				name;
+		Path 				artifact;
+		InputFingerprint 	fingerprint;
+	};
+
+	auto staleProjects 	= Vec<StaleProject>();
+	auto rebuild 		= false;
+
 	using fmt::fg, fmt::color;
 	for (auto const& projName : projectNames_)
 	{
@@ -111,33 +256,64 @@ void PaccApp::ensureProjectsAreBuilt(Package& pkg_, Vec<String> const& projectNa
 
 		auto binaryPath = rootFolder / "bin" / settings_.platformName / settings_.configName;
 
-		auto tc = *cfg.currentToolchain();
-
 		if (tc.type() == Toolchain::GNUMake)
 			binaryPath /= "lib" + projName + ".a";
 		else if (tc.type() == Toolchain::MSVC)
 			binaryPath /= (projName + ".lib");
 		// else: error
 
-		fmt::print("Binaries for project {} are located at {}\n", p->name, pkg_.getAbsoluteArtifactFilePath(*p, settings_).string());
+		auto artifact = pkg_.getAbsoluteArtifactFilePath(*p, settings_);
 
-		if (!fs::exists(binaryPath) && !fs::exists(pkg_.getAbsoluteArtifactFilePath(*p, settings_)))
-		{
+		fmt::print("Binaries for project {} are located at {}\n", p->name, artifact.string());
+
+		// The library is up to date only if it was built from the same sources and with the same flags
+		auto fingerprint = fingerprints_.of(pkg_, *p);
+
+		auto built = fs::exists(binaryPath) || fs::exists(artifact);
+		auto stored = built ? InputFingerprint::load(artifact) : std::nullopt;
+
+		if (built && stored == fingerprint)
+			continue;
+
+		if (!built)
 			fmt::print("Building dependency project \"{}\" from package \"{}\".\n", projName, pkg_.name);
+		else
+			fmt::print("Dependency project \"{}\" from package \"{}\" changed since it was built, rebuilding.\n", projName, pkg_.name);
 
-			fs::current_path(rootFolder);
-			try {
-				this->buildSpecifiedPackage(pkg_, *cfg.currentToolchain(), settings_, true);
-			}
-			catch(...)
-			{
-				// Ensure right working directory
-				fs::current_path(prevWorkingDir);
-				throw;
-			}
-			fs::current_path(prevWorkingDir);
+		// Objects compiled with other flags or toolchain are stale too
+		if (stored && stored->configuration != fingerprint.configuration)
+			rebuild = true;
 
-		}
+		staleProjects.push_back(StaleProject{ projName, std::move(artifact), std::move(fingerprint) });
+	}
+
+	if (staleProjects.empty())
+		return;
+
+	auto buildSettings = settings_;
+	buildSettings.rebuild 		= rebuild;
+	buildSettings.targetName 	= fmt::format("{}", fmt::join(staleProjects | std::views::transform(&StaleProject::name), ";"));
+
+	fs::current_path(rootFolder);
+	auto result = BuildProcessResult();
+	try {
+		result = this->buildSpecifiedPackage(pkg_, tc, buildSettings, true);
+	}
+	catch(...)
+	{
+		// Ensure right working directory
+		fs::current_path(prevWorkingDir);
+		throw;
+	}
+	fs::current_path(prevWorkingDir);
+
+	if (result.value_or(1) != 0)
+		return;
+
+	for (auto const& stale : staleProjects)
+	{
+		if (fs::exists(stale.artifact))
+			stale.fingerprint.save(stale.artifact);
 	}
 }
 
@@ -161,6 +337,9 @@ void PaccApp::ensureDependenciesBuilt(Package& pkg_, BuildQueueBuilder const &de
 
 	fmt::print(fg(color::light_gray), "Ensuring {} dependencies are built.\n", numDeps);
 
+	// Shared by all dependencies: each project is fingerprinted once and the file hash table is read and written once
+	auto fingerprints = InputFingerprints(*cfg.currentToolchain(), settings_);
+
 	for(auto const& stage : depQueue_.getQueue())
 	{
 		for (auto const& dep : stage)
@@ -169,10 +348,12 @@ void PaccApp::ensureDependenciesBuilt(Package& pkg_, BuildQueueBuilder const &de
 			{
 				auto const& pkgDep = dep.dep->package();
 
-				ensureProjectsAreBuilt(*pkgDep.package, pkgDep.projects, settings_);
+				ensureProjectsAreBuilt(*pkgDep.package, pkgDep.projects, settings_, fingerprints);
 			}
 		}
 	}
+
+	fingerprints.save();
 }
 
 ///////////////////////////////////////////////////
@@ -181,13 +362,49 @@ void PaccApp::buildPackage()
 	if (auto tc = cfg.currentToolchain())
 	{
 		auto settings	= this->determineBuildSettingsFromArgs();
+
+		if (this->settings.isFlagSet("--distribute"))
+			distributeCompilation(*this, *tc, settings);
+
+		// Shared by every build below (dependencies included), alive until the command ends
+		auto jobServer 	= shareJobServer(*tc, settings);
+		auto linkPool 	= shareLinkPool(*this, *tc, settings, jobServer ? jobServer->jobs() : settings.cores.value_or(1));
+
+		if (this->settings.isFlagSet("--watch"))
+		{
+			this->buildInWatchMode(*tc, settings);
+			return;
+		}
+
 		auto pkg		= this->loadPackage(fs::current_path(), "auto");
 
 		auto depQueue = BuildQueueBuilder{*this};
 		setupBuildQueue(*pkg, depQueue);
 		ensureDependenciesBuilt(*pkg, depQueue, settings);
 
+		// Only the package itself is profiled, dependencies are usually built already:
+		auto profiler = CompileProfiler::None;
+		if (this->settings.isFlagSet("--profile-compile"))
+		{
+			if (enableCompileProfiling(*pkg, *tc))
+				profiler = compileProfilerFor(*tc);
+			else
+				fmt::print(fg(fmt::color::yellow), "Warning: the current toolchain does not support compile profiling, \"--profile-compile\" ignored.\n");
+		}
+
+		auto buildStart = fs::file_time_type::clock::now();
+
 		this->buildSpecifiedPackage( *pkg, *tc, settings );
+
+		if (profiler != CompileProfiler::None)
+		{
+			auto jobs 		= jobServer ? jobServer->jobs() : settings.cores.value_or(1);
+			auto profile 	= collectCompileProfile(*pkg, profiler, buildStart, jobs);
+			profile.printSummary();
+
+			auto reportPath = saveBuildReport(pkg->name, "compile_profile.json", profile.toJSON().dump(1, '\t'));
+			fmt::print(fg(fmt::color::light_sky_blue), "\nCompile profile saved to \"{}\".\n", fsx::fwd(reportPath).string());
+		}
 	}
 	else
 	{
@@ -197,17 +414,34 @@ void PaccApp::buildPackage()
 }
 
 ///////////////////////////////////////////////////
-void PaccApp::buildSpecifiedPackage(Package& pkg_, Toolchain& toolchain_, BuildSettings const& settings_, bool isDependency_)
+auto PaccApp::buildSpecifiedPackage(Package& pkg_, Toolchain& toolchain_, BuildSettings const& settings_, bool isDependency_)
+	-> BuildProcessResult
 {
+	auto span = tracing::Span::formatted("build", "build {}", pkg_.name);
+	span.arg("dependency", isDependency_ ? "true" : "false").arg("configuration", settings_.configName);
+
 	this->execPackageEvent(pkg_, "build");
 
 	auto builder = pkg_.builder ? pkg_.builder : defaultPackageBuilder;
 
 	// Run build toolchain
 	auto verbosityLevel = int(settings.isFlagSet("--verbose") ? 1 : 0);
-	handleBuildResult( builder->run(pkg_, toolchain_, settings_, verbosityLevel), isDependency_ );
+	auto buildStart 	= ch::steady_clock::now();
+	auto slot 			= JobServer::Slot();
+	if (auto jobServer = JobServer::active(); jobServer && settings_.sharedJobServer)
+		slot = jobServer->acquire();
+
+	auto result 		= builder->run(pkg_, toolchain_, settings_, verbosityLevel);
+
+	// Shown by "pacc graph"
+	if (result.value_or(1) == 0)
+		saveBuildDuration(pkg_.rootFolder(), ch::duration<double, std::milli>(ch::steady_clock::now() - buildStart).count());
+
+	handleBuildResult( result, isDependency_ );
 
 	this->execPackageEvent(pkg_, "post:build");
+
+	return result;
 }
 
 ///////////////////////////////////////////////////
@@ -0,0 +1,37 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/App/App.hpp>
+#include <Pacc/App/Daemon.hpp>
+
+
+///////////////////////////////////////////////////
+void PaccApp::daemon()
+{
+	auto command = String("start");
+	if (auto commandArgIdx = settings.nthActionArgument(0))
+		command = args[*commandArgIdx];
+
+	if (command == "start")
+	{
+		pacc_daemon::serve(*this);
+	}
+	else if (command == "stop")
+	{
+		if (pacc_daemon::stop())
+			fmt::print("pacc daemon stopped.\n");
+		else
+			fmt::print("pacc daemon is not running.\n");
+	}
+	else if (command == "status")
+	{
+		if (pacc_daemon::isRunning())
+			fmt::print("pacc daemon is running (\"{}\").\n", pacc_daemon::socketPath().string());
+		else
+			fmt::print("pacc daemon is not running.\n");
+	}
+	else
+	{
+		throw PaccException("Unknown daemon command \"{}\".", command)
+			.withHelp("Use \"pacc daemon\" to start it, \"pacc daemon stop\" or \"pacc daemon status\".");
+	}
+}
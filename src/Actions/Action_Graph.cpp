@@ -2,7 +2,9 @@
 
 #include <Pacc/App/App.hpp>
 #include <Pacc/Visualization/Graph.hpp>
+#include <Pacc/Generation/Logs.hpp>
 
+void setupBuildQueue(Package & pkg, BuildQueueBuilder& depQueue);
 
 ///////////////////////////////////
 void PaccApp::visualizeGraph()
@@ -11,6 +13,9 @@ void PaccApp::visualizeGraph()
 
 	auto pkg = Package::load();
 
+	auto depQueue = BuildQueueBuilder{*this};
+	setupBuildQueue(*pkg, depQueue);
+
 	auto outFileName = String();
 
 	for (auto sw : OutputSwitches)
@@ -22,6 +27,21 @@ void PaccApp::visualizeGraph()
 		}
 	}
 
+	// Format: "--format=dot|json", by default based on the output file extension
+	auto format = viz::GraphFormat::Dot;
+	if (auto formatName = this->argValue("--format"); !formatName.empty())
+	{
+		auto parsed = viz::parseGraphFormat(formatName);
+		if (!parsed)
+		{
+			throw PaccException("Unknown graph format \"{}\".", formatName)
+				.withHelp("Use \"--format=dot\" (Graphviz) or \"--format=json\".");
+		}
+		format = *parsed;
+	}
+	else if (Path(outFileName).extension() == ".json")
+		format = viz::GraphFormat::Json;
+
 	auto outFile = std::ofstream{};
 	if (!outFileName.empty())
 	{
@@ -35,5 +55,6 @@ void PaccApp::visualizeGraph()
 
 	auto& out = outFile.is_open() ? outFile : std::cout;
 
-	out << viz::generateGraphContent(*pkg);
+	auto graph = viz::BuildGraph::build(*pkg, depQueue.getQueue(), loadBuildDurations());
+	viz::writeGraph(out, graph, format);
 }
@@ -110,12 +110,16 @@ auto PaccApp::uninstall() -> void
 		{
 			fsx::makeWritableAll(packagePath);
 			fs::remove(packagePath);
+			fsx::dirCache().invalidate(packagePath);
+			this->packageRegistry().remove(targetPath, packageName);
 			fmt::print("Package \"{}\" has been unlinked from the user environment.", packageName);
 		}
 		else if (fs::is_directory(packagePath))
 		{
 			fsx::makeWritableAll(packagePath);
 			fs::remove_all(packagePath);
+			fsx::dirCache().invalidate(packagePath);
+			this->packageRegistry().remove(targetPath, packageName);
 			fmt::print(fg(color::lime_green), "Uninstalled package \"{}\".\n", packageName);
 		}
 		else
@@ -42,6 +42,8 @@ void PaccApp::linkPackage()
 	else
 	{
 		fsx::createSymlink(fs::current_path(), targetSymlink, true);
+		fsx::dirCache().invalidate(targetSymlink);
+		this->packageRegistry().update(packagesDir, pkg->name);
 		fmt::print("Package \"{}\" has been linked inside the user environment.", pkg->name);
 	}
 }
@@ -54,6 +56,8 @@ static auto unlinkPackageByName(String const& name) -> void
 	if (fsx::isSymlinkOrJunction(symlinkPath))
 	{
 		fs::remove(symlinkPath);
+		fsx::dirCache().invalidate(symlinkPath);
+		useApp().packageRegistry().remove(symlinkPath.parent_path(), name);
 		fmt::print("Package \"{}\" has been unlinked from the user environment.", name);
 	}
 	else
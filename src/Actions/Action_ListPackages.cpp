@@ -35,55 +35,48 @@ void PaccApp::listPackages()
 
 	auto pkgs = Vec<PackageInfo>();
 
-	if (fs::is_directory(packagesRoot))
+	// Only the registry (top-level manifest fields) is needed, packages are not loaded.
+	auto entries = this->packageRegistry().packagesIn(packagesRoot);
+	pkgs.reserve(entries.size());
+
+	// Collect info
+	for (auto& entry : entries)
 	{
-		pkgs.reserve(100);
+		if (!filter.empty() && entry.name.find(filter) == String::npos)
+			continue;
+
+		if (entry.manifest.empty())
+			continue;
 
-		// Collect info
-		for (auto entry : fs::directory_iterator(packagesRoot))
+		auto pkgInfo = PackageInfo();
+
+		if (entry.version)
+			pkgInfo.ver = *entry.version;
+		else
 		{
-			if (!filter.empty() && entry.path().filename().string().find(filter) == String::npos)
+			// Could not read the metadata, load the package to report the problem:
+			try {
+				pkgInfo.ver = this->loadPackage(entry.location)->version;
+			}
+			catch (std::exception& e) {
+				fmt::print("{}\n", e.what());
+				continue;
+			}
+			catch (...) {
 				continue;
-
-			bool dir = fs::is_directory(entry);
-			bool sym = fs::is_symlink(entry);
-			if (dir || sym)
-			{
-				auto packageFile = findPackageFile(entry.path());
-				if (packageFile.empty())
-					continue;
-
-				std::unique_ptr<Package> pkg;
-				try {
-					pkg = this->loadPackage(entry.path());
-				}
-				catch (PaccException& e) {
-					fmt::print("{}\n", e.what());
-					continue;
-				}
-				catch (std::exception& e) {
-					fmt::print("{}\n", e.what());
-				}
-				catch (...) {
-					continue;
-				}
-
-
-				++totalCount;
-				auto pkgInfo = PackageInfo();
-				pkgInfo.ver = pkg->version;
-
-				pkgInfo.name = entry.path().filename().string();
-
-				if (fsx::isSymlinkOrJunction(entry))
-				{
-					++linksCount;
-					pkgInfo.linkTo = fsx::readSymlinkOrJunction(entry).string();
-				}
-
-				pkgs.emplace_back(std::move(pkgInfo));
 			}
 		}
+
+		++totalCount;
+		pkgInfo.name = std::move(entry.name);
+
+		if (entry.isLink)
+		{
+			++linksCount;
+			pkgInfo.linkTo = fsx::readSymlinkOrJunction(entry.location).string();
+		}
+
+		pkgs.emplace_back(std::move(pkgInfo));
 	}
 
 	// Print stats
@@ -0,0 +1,66 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/App/App.hpp>
+#include <Pacc/Generation/PchSynthesis.hpp>
+
+
+///////////////////////////////////////////////////
+void PaccApp::pch()
+{
+	using fmt::fg, fmt::color;
+
+	auto command = String("suggest");
+	if (auto commandArgIdx = settings.nthActionArgument(0))
+		command = args[*commandArgIdx];
+
+	if (command != "suggest")
+	{
+		throw PaccException("Unknown pch command \"{}\".", command)
+			.withHelp("Use \"pacc pch suggest\" to list the headers worth precompiling.");
+	}
+
+	auto pkg = Package::load();
+
+	auto targetName = String();
+	if (auto& target = *settings.flags.at("--target"); target.isSet())
+		targetName = String(target.value);
+
+	auto numListed = std::size_t(0);
+	for (auto const& project : pkg->projects)
+	{
+		if (project.type == Project::Interface || (!targetName.empty() && project.name != targetName))
+			continue;
+
+		++numListed;
+
+		auto headers = gen::suggestPchHeaders(*pkg, project);
+
+		fmt::print(fg(color::light_sky_blue), "\nProject \"{}\"", project.name);
+		if (project.pch.has_value())
+			fmt::print(fg(color::gray), project.pch->automatic ? " (\"pch\": \"auto\")" : " (has a precompiled header)");
+		fmt::print("\n");
+
+		if (headers.empty())
+		{
+			fmt::print(fg(color::gray), "  No header is included often enough to precompile it.\n");
+			continue;
+		}
+
+		// Most included first
+		rg::stable_sort(headers, [](auto const& lhs, auto const& rhs) { return lhs.sources > rhs.sources; });
+
+		for (auto const& usage : headers)
+		{
+			auto include = usage.angled ? fmt::format("<{}>", usage.name) : fmt::format("\"{}\"", usage.name);
+			fmt::print("  {:>3.0f}% {:>5} sources  {}\n", usage.weight * 100, usage.sources, include);
+		}
+	}
+
+	if (numListed == 0 && !targetName.empty())
+	{
+		throw PaccException("Project \"{}\" not found.", targetName)
+			.withHelp("Check the project names in the package manifest (case sensitive).");
+	}
+
+	fmt::print(fg(color::gray), "\nSet \"pch\": \"auto\" in a project to precompile its headers on generation.\n");
+}
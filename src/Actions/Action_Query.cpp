@@ -1,6 +1,27 @@
 #include "include/Pacc/PaccPCH.hpp"
 
 #include <Pacc/App/App.hpp>
+#include <Pacc/Helpers/JsonWriter.hpp>
+#include <Pacc/Helpers/Hash.hpp>
+#include <Pacc/System/FileView.hpp>
+#include <Pacc/Readers/General.hpp>
+#include <Pacc/System/Filesystem.hpp>
+
+void setupBuildQueue(Package & pkg, BuildQueueBuilder& depQueue);
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto collectPackages(Package const& root_, BuildQueueBuilder::DepQueue const& queue_) -> Vec<Package const*>;
+static void writeResolvedGraph(std::ostream& out_, Vec<Package const*> const& packages_, BuildSettings const& settings_);
+
+static auto graphSnapshotFileOf(Path const& packageFolder_) -> Path;
+static auto graphFingerprintFileOf(Path const& packageFolder_) -> Path;
+static auto computeGraphFingerprint(Vec<Path> const& manifests_, Vec<Path> const& searchFolders_, BuildSettings const& settings_) -> Opt<String>;
+static auto readGraphSnapshot(Path const& packageFolder_, Vec<Path> const& searchFolders_, BuildSettings const& settings_) -> Opt<FileView>;
+static void saveGraphFingerprint(Path const& packageFolder_, Vec<Package const*> const& packages_, Vec<Path> const& searchFolders_, BuildSettings const& settings_);
+
 
 ///////////////////////////////////
 void PaccApp::query()
@@ -28,15 +49,27 @@ void PaccApp::query()
 		}
 	}
 
-	if (args.size() < 2)
+	auto queryTypeIdx = settings.nthActionArgument(0);
+	if (!queryTypeIdx)
 	{
 		throw PaccException("No query type.")
-			.withHelp("Use \"pacc query package\" to query a package.");
+			.withHelp("Use \"pacc query package\" to query a package or \"pacc query graph\" to query the resolved dependency graph.");
 	}
 
 
 	auto& out = outFile.is_open() ? outFile : std::cout;
 
+	auto const& queryType = args[*queryTypeIdx];
+	if (queryType == "graph")
+	{
+		this->queryGraph(out);
+		return;
+	}
+	else if (queryType != "package")
+	{
+		throw PaccException("Unknown query type \"{}\".", queryType)
+			.withHelp("Use \"pacc query package\" or \"pacc query graph\".");
+	}
 
 	auto pkg = Package::load();
 
@@ -54,3 +87,344 @@ void PaccApp::query()
 
 	out << j.dump(1, '\t');
 }
+
+///////////////////////////////////
+void PaccApp::queryGraph(std::ostream& out_)
+{
+	auto settings 		= this->determineBuildSettingsFromArgs();
+	auto packageFolder 	= Package::preload().root.parent_path();
+	auto searchFolders 	= this->packageSearchFolders();
+
+	// Nothing changed since the last query, skip loading the packages:
+	if (auto snapshot = readGraphSnapshot(packageFolder, searchFolders, settings))
+	{
+		out_ << snapshot->view();
+		return;
+	}
+
+	auto pkg = Package::load();
+
+	auto depQueue = BuildQueueBuilder{*this};
+	setupBuildQueue(*pkg, depQueue);
+
+	auto packages = collectPackages(*pkg, depQueue.getQueue());
+
+	auto graph = std::ostringstream();
+	writeResolvedGraph(graph, packages, settings);
+	auto contents = std::move(graph).str();
+
+	// The snapshot is replaced first (other queries may be reading it), the fingerprint marks it as complete:
+	auto ec = std::error_code{};
+	fs::remove(graphFingerprintFileOf(packageFolder), ec);
+
+	if (fsx::replaceFile(graphSnapshotFileOf(packageFolder), contents))
+		saveGraphFingerprint(packageFolder, packages, searchFolders, settings);
+
+	out_ << contents;
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+/// <summary>The root first, then dependencies in the order of the queue.</summary>
+static auto collectPackages(Package const& root_, BuildQueueBuilder::DepQueue const& queue_) -> Vec<Package const*>
+{
+	auto result = Vec<Package const*>{ &root_ };
+	auto added 	= USet<Package const*>{ &root_ };
+
+	for (auto const& step : queue_)
+	{
+		for (auto const& pd : step)
+		{
+			if (pd.dep->isPackage())
+			{
+				auto const* pkg = pd.dep->package().package.get();
+				if (added.insert(pkg).second)
+					result.push_back(pkg);
+			}
+		}
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+static auto accessName(AccessType access_) -> StringView
+{
+	switch (access_)
+	{
+	case AccessType::Private: 	return "private";
+	case AccessType::Public: 	return "public";
+	case AccessType::Interface: return "interface";
+	}
+	return "";
+}
+
+///////////////////////////////////////////////////
+static void writeAccesses(JsonWriter& w_, VecOfStrAcc const& values_)
+{
+	w_.beginObject();
+	w_.key("private").stringArray(values_.private_);
+	w_.key("public").stringArray(values_.public_);
+	w_.key("interface").stringArray(values_.interface_);
+	w_.endObject();
+}
+
+///////////////////////////////////////////////////
+/// <summary>Own values (paths resolved when <c>resolve_</c> is set) and values computed from the dependencies.</summary>
+template <typename TStrings>
+static void writeStrings(JsonWriter& w_, StringView name_, TStrings const& strings_, Package const* resolve_ = nullptr)
+{
+	w_.key(name_).beginObject();
+
+	w_.key("self");
+	if (resolve_)
+	{
+		auto resolved = strings_.self;
+		for (auto* acc : getAccesses(resolved))
+		{
+			for (auto& path : *acc)
+				path = resolve_->resolvePath(path).string();
+		}
+		writeAccesses(w_, resolved);
+	}
+	else
+		writeAccesses(w_, strings_.self);
+
+	w_.key("computed");
+	writeAccesses(w_, flattenAccesses(strings_.computed));
+
+	w_.endObject();
+}
+
+///////////////////////////////////////////////////
+static void writeDependencies(JsonWriter& w_, Package const& pkg_, Configuration const& config_)
+{
+	constexpr AccessType Accesses[] = { AccessType::Private, AccessType::Public, AccessType::Interface };
+
+	w_.key("dependencies").beginArray();
+
+	auto const& deps = config_.dependencies.self;
+	Vec<Dependency> const* byAccess[] = { &deps.private_, &deps.public_, &deps.interface_ };
+
+	for (std::size_t i = 0; i < std::size(Accesses); ++i)
+	{
+		for (auto const& dep : *byAccess[i])
+		{
+			w_.beginObject();
+			w_.field("access", accessName(Accesses[i]));
+
+			if (dep.isRaw())
+				w_.field("raw", dep.raw());
+			else if (dep.isSelf())
+			{
+				w_.field("package", pkg_.name);
+				w_.key("projects").beginArray().value(dep.self().depProjName).endArray();
+			}
+			else if (dep.isPackage())
+			{
+				auto const& pkgDep = dep.package();
+				w_.field("package", pkgDep.package ? pkgDep.package->name : pkgDep.packageName);
+				w_.key("projects").stringArray(pkgDep.projects);
+			}
+
+			w_.endObject();
+		}
+	}
+
+	w_.endArray();
+}
+
+///////////////////////////////////////////////////
+static void writeConfiguration(JsonWriter& w_, Package const& pkg_, Configuration const& config_)
+{
+	writeStrings(w_, "defines", 		config_.defines);
+	writeStrings(w_, "includeFolders", 	config_.includeFolders, &pkg_);
+	writeStrings(w_, "linkerFolders", 	config_.linkerFolders, &pkg_);
+	writeStrings(w_, "linkedLibraries", config_.linkedLibraries);
+	writeStrings(w_, "compilerOptions", config_.compilerOptions);
+	writeStrings(w_, "linkerOptions", 	config_.linkerOptions);
+
+	writeDependencies(w_, pkg_, config_);
+}
+
+///////////////////////////////////////////////////
+static void writeArtifacts(JsonWriter& w_, Package const& pkg_, Project const& project_, BuildSettings const& settings_)
+{
+	constexpr StringView ArtifactNames[] = { "executable", "library", "libraryInterface", "debugSymbols" };
+
+	w_.key("artifact");
+	if (project_.getPrimaryArtifact().empty())
+		w_.null();
+	else
+		w_.value(fsx::fwd(pkg_.getAbsoluteArtifactFilePath(project_, settings_)).string());
+
+	w_.key("artifacts").beginObject();
+	for (std::size_t i = 0; i < std::size(ArtifactNames); ++i)
+	{
+		w_.key(ArtifactNames[i]).beginArray();
+		for (auto const& path : project_.artifacts[i])
+			w_.value(fsx::fwd(path).string());
+		w_.endArray();
+	}
+	w_.endObject();
+}
+
+///////////////////////////////////////////////////
+static void writeResolvedGraph(std::ostream& out_, Vec<Package const*> const& packages_, BuildSettings const& settings_)
+{
+	auto w = JsonWriter(out_);
+
+	w.beginObject();
+	w.field("root", packages_.front()->name);
+	w.field("configuration", settings_.configName);
+	w.field("platform", settings_.platformName);
+
+	w.key("packages").beginArray();
+	for (auto const* pkg : packages_)
+	{
+		w.beginObject();
+		w.field("name", pkg->name);
+		w.field("version", pkg->version.toString());
+		w.field("folder", fsx::fwd(pkg->rootFolder()).string());
+
+		w.key("projects").beginArray();
+		for (auto const& project : pkg->projects)
+		{
+			w.beginObject();
+			w.field("name", project.name);
+			w.field("type", toString(project.type));
+			w.field("language", project.language);
+			w.key("files").stringArray(project.files);
+
+			writeArtifacts(w, *pkg, project, settings_);
+			writeConfiguration(w, *pkg, project);
+
+			w.key("filters").beginObject();
+			for (auto const& [filter, config] : project.premakeFilters)
+			{
+				w.key(filter).beginObject();
+				writeConfiguration(w, *pkg, config);
+				w.endObject();
+			}
+			w.endObject();
+
+			w.endObject();
+		}
+		w.endArray();
+
+		w.endObject();
+	}
+	w.endArray();
+
+	w.endObject();
+}
+
+///////////////////////////////////////////////////
+static auto graphSnapshotFileOf(Path const& packageFolder_) -> Path
+{
+	return packageFolder_ / "build" / "pacc_query_graph.json";
+}
+
+///////////////////////////////////////////////////
+/// <summary>First line: the fingerprint, then the manifests it was computed from (one per line).</summary>
+static auto graphFingerprintFileOf(Path const& packageFolder_) -> Path
+{
+	return packageFolder_ / "build" / "pacc_query_graph.fingerprint";
+}
+
+///////////////////////////////////////////////////
+/// <summary>
+/// 	Hash of the manifests of all packages in the graph, the state of the folders the dependencies
+/// 	are found in and the query settings.
+/// </summary>
+/// <returns>nullopt if a manifest is missing (the graph has to be resolved again).</returns>
+static auto computeGraphFingerprint(Vec<Path> const& manifests_, Vec<Path> const& searchFolders_, BuildSettings const& settings_) -> Opt<String>
+{
+	auto hash = Fnv1a();
+	hash.add(PaccApp::PaccVersion);
+	hash.add(settings_.configName);
+	hash.add(settings_.platformName);
+
+	// Install, uninstall and link add or remove packages in these folders, which changes
+	// the packages the dependency names resolve to (the old manifests are still the same)
+	for (auto const& folder : searchFolders_)
+	{
+		auto ec 	= std::error_code{};
+		auto time 	= fs::last_write_time(folder, ec);
+
+		hash.add(folder.string());
+		hash.add(ec ? String("missing") : std::to_string(time.time_since_epoch().count()));
+	}
+
+	for (auto const& manifest : manifests_)
+	{
+		auto ec = std::error_code{};
+		if (!fs::is_regular_file(manifest, ec))
+			return std::nullopt;
+
+		hash.add(manifest.string());
+		hash.add(readFileContents(manifest)); // edited by the user, not mapped
+	}
+
+	return hash.hex();
+}
+
+///////////////////////////////////////////////////
+static auto readGraphSnapshot(Path const& packageFolder_, Vec<Path> const& searchFolders_, BuildSettings const& settings_) -> Opt<FileView>
+{
+	auto snapshotFile 		= graphSnapshotFileOf(packageFolder_);
+	auto fingerprintFile 	= graphFingerprintFileOf(packageFolder_);
+
+	auto ec = std::error_code{};
+	if (!fs::is_regular_file(snapshotFile, ec) || !fs::is_regular_file(fingerprintFile, ec))
+		return std::nullopt;
+
+	auto stored 	= std::ifstream(fingerprintFile);
+	auto expected 	= String();
+	std::getline(stored, expected);
+
+	auto manifests = Vec<Path>();
+	for (String line; std::getline(stored, line); )
+	{
+		if (!line.empty())
+			manifests.push_back(Path(line));
+	}
+
+	if (manifests.empty() || computeGraphFingerprint(manifests, searchFolders_, settings_) != expected)
+		return std::nullopt;
+
+	return FileView(snapshotFile);
+}
+
+///////////////////////////////////////////////////
+/// <remarks>
+/// 	Graphs with Lua or CMake packages are not fingerprinted (never served from the snapshot),
+/// 	because their configuration does not depend only on the manifest contents.
+/// </remarks>
+static void saveGraphFingerprint(Path const& packageFolder_, Vec<Package const*> const& packages_, Vec<Path> const& searchFolders_, BuildSettings const& settings_)
+{
+	auto manifests = Vec<Path>();
+	for (auto const* pkg : packages_)
+	{
+		if (pkg->isCMake || pkg->usesLuaConfig())
+			return;
+
+		manifests.push_back(pkg->root);
+		if (pkg->usesScriptFile())
+			manifests.push_back(pkg->scriptFile);
+	}
+
+	auto fingerprint = computeGraphFingerprint(manifests, searchFolders_, settings_);
+	if (!fingerprint)
+		return;
+
+	auto contents = *fingerprint + '\n';
+	for (auto const& manifest : manifests)
+		contents += fsx::fwd(manifest).string() + '\n';
+
+	fsx::replaceFile(graphFingerprintFileOf(packageFolder_), contents);
+}
@@ -0,0 +1,343 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/App/App.hpp>
+
+#include <Pacc/Visualization/Graph.hpp>
+#include <Pacc/System/FileWatcher.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/String.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+
+////////////////////////////////////
+// Forward declarations
+////////////////////////////////////
+void setupBuildQueue(Package & pkg, BuildQueueBuilder& depQueue);
+
+constexpr int DefaultDebounceMs = 300;
+
+/// <summary>Package graph kept loaded between the builds of the watch mode.</summary>
+struct WatchedGraph
+{
+	UPtr<Package> 				root;
+	UPtr<BuildQueueBuilder> 	queue;
+	viz::BuildGraph 			graph;
+	Vec<Package*> 				packages; 		// per package of the graph
+
+	Vec<Vec<String>> 	filePatterns; 	// per project of the graph: absolute patterns (files and include folders)
+	Vec<Path> 			manifestFolders;
+	USet<String> 		knownFiles; 	// files matched by the patterns, to detect added and removed files
+	Vec<std::size_t> 	buildOrder; 	// package indices, dependencies first
+};
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto loadWatchedGraph(PaccApp& app_) -> WatchedGraph;
+static void watchGraph(FileWatcher& watcher_, WatchedGraph& watched_, Path const& rootFolder_);
+static auto requiresReload(WatchedGraph const& watched_, Vec<Path> const& changes_, Path const& rootFolder_) -> bool;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+void PaccApp::buildInWatchMode(Toolchain& toolchain_, BuildSettings const& settings_)
+{
+	using fmt::fg, fmt::color;
+
+	auto debounce = ch::milliseconds(DefaultDebounceMs);
+	if (auto& flag = *settings.flags.at("--watch"); flag.value != "true")
+		debounce = ch::milliseconds(convertTo<int>(String(flag.value)).value_or(DefaultDebounceMs));
+
+	auto watcher 	= FileWatcher();
+	auto rootFolder = fsx::fwd(fs::current_path());
+
+	// Builds the package in its own folder (the toolchains run in the working directory)
+	auto buildInFolder = [&](Package& pkg_, BuildSettings const& buildSettings_, bool isDependency_)
+		{
+			fs::current_path(pkg_.rootFolder());
+			try {
+				this->buildSpecifiedPackage(pkg_, toolchain_, buildSettings_, isDependency_);
+			}
+			catch(...)
+			{
+				fs::current_path(rootFolder);
+				throw;
+			}
+			fs::current_path(rootFolder);
+		};
+
+	while (true)
+	{
+		// (Re)load the graph and build everything
+		auto watched 	= WatchedGraph();
+		auto generated 	= USet<Package const*>(); // packages with project files generated in this session
+
+		// Packages may have been installed, linked or renamed their manifest while watching
+		fsx::dirCache().clear();
+		this->packageRegistry().invalidate();
+
+		try {
+			watched = loadWatchedGraph(*this);
+
+			this->ensureDependenciesBuilt(*watched.root, *watched.queue, settings_);
+			buildInFolder(*watched.root, settings_, false);
+			generated.insert(watched.root.get());
+		}
+		catch(PaccException& exc) {
+			// Keep watching, f.e. until the manifest is fixed
+			dumpException(exc);
+		}
+
+		watcher.clear();
+		watchGraph(watcher, watched, rootFolder);
+
+		// Rebuild only what changed
+		while (true)
+		{
+			fmt::print(fg(color::light_sky_blue), "\nWatching for changes (press Ctrl+C to stop)...\n");
+
+			auto [changes, all] = watcher.waitForChanges(debounce);
+			if (all)
+			{
+				fmt::print(fg(color::light_sky_blue), "Too many changes at once (file events were lost), reloading the package graph.\n");
+				break;
+			}
+
+			if (requiresReload(watched, changes, rootFolder))
+			{
+				fmt::print(fg(color::light_sky_blue), "Package manifest changed, reloading the package graph.\n");
+				break;
+			}
+
+			auto const& graph = watched.graph;
+
+			// Projects that contain the changed files
+			auto changedProjects 	= USet<std::size_t>();
+			auto filesAddedOrRemoved = USet<std::size_t>(); // packages
+			for (auto const& changed : changes)
+			{
+				auto path 			= changed.string();
+				auto exists 		= fs::exists(changed);
+				auto wasKnown 		= watched.knownFiles.contains(path);
+				auto matchesAny 	= false;
+
+				for (std::size_t i = 0; i < graph.projects.size(); ++i)
+				{
+					auto matches = rg::any_of(watched.filePatterns[i], [&](String const& pattern) { return matchesGlob(pattern, path); });
+					if (!matches)
+						continue;
+
+					matchesAny = true;
+					changedProjects.insert(i);
+					if (exists != wasKnown)
+						filesAddedOrRemoved.insert(graph.projects[i].package);
+				}
+
+				if (matchesAny && exists)
+					watched.knownFiles.insert(path);
+				else
+					watched.knownFiles.erase(path);
+			}
+
+			if (changedProjects.empty())
+				continue;
+
+			// ... and everything that depends on them
+			auto affected 	= changedProjects;
+			auto pending 	= Vec<std::size_t>(changedProjects.begin(), changedProjects.end());
+			while (!pending.empty())
+			{
+				auto project = pending.back();
+				pending.pop_back();
+
+				for (auto const& edge : graph.edges)
+				{
+					if (edge.to == project && affected.insert(edge.from).second)
+						pending.push_back(edge.from);
+				}
+			}
+
+			// Projects that depend on rebuilt projects of other packages have to be linked again,
+			// the generated project files know only the dependencies within the package
+			for (auto const& edge : graph.edges)
+			{
+				auto const& from 	= graph.projects[edge.from];
+				auto const& to 		= graph.projects[edge.to];
+				auto links = (from.project->type == Project::App || from.project->type == Project::SharedLib);
+				if (from.package == to.package || !affected.contains(edge.to) || !links)
+					continue;
+
+				auto ec = std::error_code{};
+				fs::remove(graph.packages[from.package].package->getAbsoluteArtifactFilePath(*from.project, settings_), ec);
+			}
+
+			try {
+				for (auto pkgIdx : watched.buildOrder)
+				{
+					auto& pkg = *watched.packages[pkgIdx];
+
+					auto targets = Vec<String>();
+					for (auto projectIdx : affected)
+					{
+						auto const& node = graph.projects[projectIdx];
+						if (node.package == pkgIdx && node.project->type != Project::Interface)
+							targets.push_back(node.project->name);
+					}
+
+					if (targets.empty())
+						continue;
+
+					rg::sort(targets);
+					fmt::print(fg(color::light_gray), "\nRebuilding {} ({}).\n", pkg.name, fmt::join(targets, ", "));
+
+					auto buildSettings = settings_;
+					buildSettings.targetName 				= fmt::format("{}", fmt::join(targets, ";"));
+					buildSettings.regenerateProjectFiles 	= filesAddedOrRemoved.contains(pkgIdx) || !generated.contains(&pkg);
+
+					buildInFolder(pkg, buildSettings, pkgIdx != 0);
+					generated.insert(&pkg);
+				}
+			}
+			catch(PaccException& exc) {
+				dumpException(exc);
+			}
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static auto loadWatchedGraph(PaccApp& app_) -> WatchedGraph
+{
+	auto watched = WatchedGraph();
+
+	watched.root 	= app_.loadPackage(fs::current_path(), "auto");
+	watched.queue 	= std::make_unique<BuildQueueBuilder>(app_);
+	setupBuildQueue(*watched.root, *watched.queue);
+
+	watched.graph = viz::BuildGraph::build(*watched.root, watched.queue->getQueue(), {});
+
+	auto const& graph = watched.graph;
+
+	// The graph points to the packages as read-only
+	auto mutablePackages = UMap<Package const*, Package*>{ { watched.root.get(), watched.root.get() } };
+	for (auto const& step : watched.queue->getQueue())
+	{
+		for (auto const& pd : step)
+		{
+			if (pd.dep->isPackage())
+				mutablePackages.emplace(pd.dep->package().package.get(), pd.dep->package().package.get());
+		}
+	}
+
+	for (auto const& node : graph.packages)
+	{
+		watched.packages.push_back(mutablePackages.at(node.package));
+		watched.manifestFolders.push_back(fsx::fwd(node.package->rootFolder()));
+	}
+
+	// Patterns of the project files, changes in the include folders count as changes of the project too
+	watched.filePatterns.resize(graph.projects.size());
+	for (std::size_t i = 0; i < graph.projects.size(); ++i)
+	{
+		auto const& pkg 	= *graph.packages[graph.projects[i].package].package;
+		auto const& project = *graph.projects[i].project;
+		auto& patterns 		= watched.filePatterns[i];
+
+		for (auto const& file : project.files)
+			patterns.push_back(fsx::fwd(pkg.resolvePath(file)).string());
+
+		for (auto const* folders : { &project.includeFolders.self.public_, &project.includeFolders.self.private_, &project.includeFolders.self.interface_ })
+		{
+			for (auto const& folder : *folders)
+				patterns.push_back(fsx::fwd(pkg.resolvePath(folder)).string() + "/**");
+		}
+	}
+
+	// Packages are built after their dependencies
+	auto packageDeps = Vec<USet<std::size_t>>(graph.packages.size());
+	for (auto const& edge : graph.edges)
+	{
+		auto from 	= graph.projects[edge.from].package;
+		auto to 	= graph.projects[edge.to].package;
+		if (from != to)
+			packageDeps[from].insert(to);
+	}
+
+	auto visited = Vec<bool>(graph.packages.size(), false);
+	auto visit = [&](auto& self, std::size_t pkgIdx) -> void
+		{
+			if (visited[pkgIdx])
+				return;
+
+			visited[pkgIdx] = true;
+			for (auto dep : packageDeps[pkgIdx])
+				self(self, dep);
+
+			watched.buildOrder.push_back(pkgIdx);
+		};
+
+	for (std::size_t i = 0; i < graph.packages.size(); ++i)
+		visit(visit, i);
+
+	return watched;
+}
+
+///////////////////////////////////////////////////
+static void watchGraph(FileWatcher& watcher_, WatchedGraph& watched_, Path const& rootFolder_)
+{
+	// Manifests and installed packages
+	watcher_.watch(rootFolder_);
+	watcher_.watch(rootFolder_ / "pacc_packages");
+	for (auto const& folder : watched_.manifestFolders)
+		watcher_.watch(folder);
+
+	// Project files
+	for (auto const& patterns : watched_.filePatterns)
+	{
+		for (auto const& pattern : patterns)
+		{
+			auto [folder, recursive] = fsx::globBase(pattern);
+			watcher_.watch(folder, recursive);
+
+			// Remember matching files, to know which changes add or remove files
+			for (auto& file : fsx::glob(pattern))
+				watched_.knownFiles.insert(file.string());
+		}
+	}
+}
+
+///////////////////////////////////////////////////
+static auto requiresReload(WatchedGraph const& watched_, Vec<Path> const& changes_, Path const& rootFolder_) -> bool
+{
+	auto isManifestName = [](StringView name_) {
+			auto isOneOf = [&](auto const& names) { return rg::find(names, name_) != std::end(names); };
+			return isOneOf(PackageJSON) || isOneOf(PackageLUA) || isOneOf(PackageLUAScript);
+		};
+
+	auto packagesFolder = fsx::fwd(rootFolder_ / "pacc_packages");
+
+	for (auto const& changed : changes_)
+	{
+		auto folder = changed.parent_path();
+
+		// Package installed, removed or linked
+		if (changed == packagesFolder || folder == packagesFolder)
+			return true;
+
+		if (!isManifestName(changed.filename().string()))
+			continue;
+
+		if (folder == rootFolder_ || rg::find(watched_.manifestFolders, folder) != watched_.manifestFolders.end())
+			return true;
+	}
+
+	return false;
+}
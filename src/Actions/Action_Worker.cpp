@@ -0,0 +1,34 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/App/App.hpp>
+#include <Pacc/Build/DistributedBuild.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+#include <Pacc/Helpers/String.hpp>
+
+
+///////////////////////////////////////////////////
+void PaccApp::worker()
+{
+	auto address = String(distributed::DefaultWorkerAddress);
+	if (auto& flag = *settings.flags.at("--listen"); flag.isSet() && flag.value != "true")
+		address = String(flag.value);
+
+	auto slots = int(std::max(1u, std::thread::hardware_concurrency()));
+	if (auto& flag = *settings.flags.at("--cores"); flag.isSet())
+	{
+		auto cores = convertTo<int>(String(flag.value));
+		if (!cores || *cores < 1)
+		{
+			throw PaccException("Invalid number of cores \"{}\".", flag.value)
+				.withHelp("Use a positive number, f.e. \"--cores=8\".");
+		}
+
+		slots = *cores;
+	}
+
+	auto token = cfg.workerToken;
+	if (auto variable = std::getenv(String(distributed::TokenVariable).c_str()))
+		token = variable;
+
+	distributed::serveWorker(address, slots, token);
+}
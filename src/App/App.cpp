@@ -10,6 +10,7 @@
 
 #include <Pacc/System/Environment.hpp>
 #include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 #include <Pacc/System/Process.hpp>
 
 #include <Pacc/Generation/BuildQueueBuilder.hpp>
@@ -173,6 +174,9 @@ auto PaccApp::downloadPackage(fs::path const &target_, DownloadLocation const& l
 
 		fs::remove_all(gitFolderPath);
 	}
+
+	fsx::dirCache().invalidate(target_);
+	this->packageRegistry().update(target_.parent_path(), target_.filename().string());
 }
 
 
@@ -182,6 +186,10 @@ auto PaccApp::loadPaccConfig()
 {
 	using fmt::fg, fmt::color;
 
+	// Already loaded (commands served by the daemon)
+	if (paccConfigLoaded)
+		return;
+
 	fs::path const cfgPath = env::getPaccDataStorageFolder() / "settings.json";
 
 	cfg = PaccConfig::loadOrCreate(cfgPath);
@@ -194,6 +202,8 @@ auto PaccApp::loadPaccConfig()
 				"Warning: detected new toolchains, resetting the default one\n"
 			);
 	}
+
+	paccConfigLoaded = true;
 }
 
 ///////////////////////////////////////////////////
@@ -297,6 +307,9 @@ void PaccApp::execPackageEvent(Package& pkg_, String const& eventName_)
 		// add an event handler with an action that does not exist.
 		assert(executor && "Unknown event action");
 
+		auto span = tracing::Span::formatted("events", "event {}", eventName_);
+		span.arg("package", pkg_.name).arg("action", task->action);
+
 		executor->execute(pkg_, *task);
 	}
 }
@@ -3,6 +3,8 @@
 #include <Pacc/App/App.hpp>
 
 #include <Pacc/System/Environment.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 
 ////////////////////////////////////
 // Enables view of the underlying container of the priority_queue
@@ -44,6 +46,9 @@ auto PaccApp::detectPreferredPackageLoaderFor(fs::path const& path_) const
 auto PaccApp::loadPackage(fs::path const& path_)
 	-> UPtr<Package>
 {
+	auto span = tracing::Span("loadPackage", "load");
+	span.arg("path", path_.string());
+
 	return defaultPackageLoader->load(path_);
 }
 
@@ -51,6 +56,9 @@ auto PaccApp::loadPackage(fs::path const& path_)
 auto PaccApp::loadPackage(fs::path const& path_, String const& loaderName_)
 	-> UPtr<Package>
 {
+	auto span = tracing::Span("loadPackage", "load");
+	span.arg("path", path_.string()).arg("loader", loaderName_);
+
 	if (loaderName_ == "auto") {
 		return this->detectPreferredPackageLoaderFor(path_).load(path_);
 	}
@@ -64,6 +72,28 @@ auto PaccApp::loadPackage(fs::path const& path_, String const& loaderName_)
 	}
 }
 
+//////////////////////////////////////
+auto PaccApp::packageSearchFolders() const
+	-> Vec<fs::path>
+{
+	return {
+			fs::current_path() 					/ "pacc_packages",
+			// Folder above that is inside pacc_packages folder
+			fs::current_path() 					/ "../../pacc_packages",
+			env::getPaccDataStorageFolder() 	/ "packages"
+		};
+}
+
+//////////////////////////////////////
+auto PaccApp::packageRegistry()
+	-> PackageRegistry&
+{
+	if (!registry)
+		registry = std::make_unique<PackageRegistry>(env::getPaccDataStorageFolder() / "registry.json");
+
+	return *registry;
+}
+
 //////////////////////////////////////
 auto PaccApp::loadPackageByName(
 		String const&		name_,
@@ -73,20 +103,28 @@ auto PaccApp::loadPackageByName(
 	)
 	-> UPtr<Package>
 {
-	auto candidates = Vec<fs::path>{
-			fs::current_path() 					/ "pacc_packages",
-			// Folder above that is inside pacc_packages folder
-			fs::current_path() 					/ "../../pacc_packages",
-			env::getPaccDataStorageFolder() 	/ "packages"
-		};
+	auto& registry = this->packageRegistry();
+
+	// Package that is known to have an invalid version, loaded only when needed:
+	auto invalidVersionLocation = Opt<fs::path>();
 
 	// Get first matching candidate:
-	for(auto const& c : candidates)
+	for(auto const& c : this->packageSearchFolders())
 	{
-		auto pkgFolder = c / name_;
+		auto entry = registry.find(c, name_);
+		if (!entry)
+			continue;
+
+		// Version is known without loading the package:
+		if (entry->version && !verReq_.test(*entry->version))
+		{
+			invalidVersionLocation = entry->location;
+			continue;
+		}
+
 		auto pkg = UPtr<Package>();
 		try {
-			pkg = this->loadPackage(pkgFolder, loaderName_);
+			pkg = this->loadPackage(entry->location, loaderName_);
 		}
 		catch(...) {
 			// Could not load, ignore
@@ -102,6 +140,16 @@ auto PaccApp::loadPackageByName(
 		}
 	}
 
+	if (invalidVersion_ && !*invalidVersion_ && invalidVersionLocation)
+	{
+		try {
+			*invalidVersion_ = this->loadPackage(*invalidVersionLocation, loaderName_);
+		}
+		catch(...) {
+			// Could not load, ignore
+		}
+	}
+
 	// (TODO: help here)
 	// Found none.
 	throw PaccException("Could not find package \"{}\".", name_);
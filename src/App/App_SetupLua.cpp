@@ -33,14 +33,20 @@ auto loadPaccLuaSDK(sol::state& lua, Path const& searchPattern) -> void
 
 auto PaccApp::setupLua() -> void
 {
+	auto& flag = *settings.flags.at("--lua-lib");
+
+	// Already prepared with the bundled SDK (commands served by the daemon)
+	if (luaReady && !flag.isSet())
+		return;
+
 	lua = freshLuaInstance();
+	luaReady = false;
 
 	// Insert the pacc lua SDK
 	{
 		auto paccLuaSDKSearch = Path();
 
 		// Default value: the `lua` folder is a sibling of the `bin`, where the pacc executable is located.
-		auto& flag = *settings.flags.at("--lua-lib");
 		if (!flag.isSet())
 		{
 			paccLuaSDKSearch = env::getPaccAppPath().parent_path() / "../lua/?.lua";
@@ -64,4 +70,6 @@ auto PaccApp::setupLua() -> void
 
 		loadPaccLuaSDK(lua, paccLuaSDKSearch);
 	}
+
+	luaReady = !flag.isSet();
 }
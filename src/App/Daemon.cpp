@@ -0,0 +1,839 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/App/Daemon.hpp>
+
+#include <Pacc/App/App.hpp>
+#include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/PackageSystem/PackageCache.hpp>
+#include <Pacc/System/Environment.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/System/Socket.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+#include <Pacc/Helpers/Formatting.hpp>
+
+#ifdef PACC_SYSTEM_LINUX
+	#include <unistd.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <sys/inotify.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
+	#include <sys/wait.h>
+
+	extern char** environ;
+#endif
+
+namespace pacc_daemon
+{
+
+///////////////////////////////////////////////////
+auto socketPath() -> Path
+{
+	return env::getPaccDataStorageFolder() / "pacc.sock";
+}
+
+#ifdef PACC_SYSTEM_LINUX
+
+///////////////////////////////////////////////////
+// Private functions and types
+///////////////////////////////////////////////////
+
+using net::FileDescriptor, net::writeAll, net::readAll;
+
+// Reply sent when the daemon cannot serve the request (f.e. it runs a different pacc version)
+constexpr int32_t FallbackCode = std::numeric_limits<int32_t>::min();
+
+constexpr std::size_t NumStreams = 3; // stdin, stdout, stderr
+
+/// <summary>
+/// 	Command sent by the CLI.
+/// 	Encoded as NUL-terminated strings: kind, version, cwd, number of arguments, arguments, environment.
+/// </summary>
+struct Request
+{
+	String 			kind; 		// "run", "stop" or "ping"
+	String 			version;
+	Path 			cwd;
+	ProgramArgs 	args;
+	Vec<String> 	environment;
+
+	Array<int, NumStreams> streams = { -1, -1, -1 };
+};
+
+///////////////////////////////////////////////////
+static auto socketAddress(sockaddr_un& addr_) -> bool
+{
+	auto path = socketPath().string();
+
+	addr_ = {};
+	addr_.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr_.sun_path))
+		return false;
+
+	std::memcpy(addr_.sun_path, path.c_str(), path.size() + 1);
+	return true;
+}
+
+///////////////////////////////////////////////////
+static auto connectToDaemon() -> int
+{
+	auto addr = sockaddr_un{};
+	if (!socketAddress(addr))
+		return -1;
+
+	auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return -1;
+
+	if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+	{
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+///////////////////////////////////////////////////
+static auto encode(Request const& request_) -> String
+{
+	auto payload = String();
+	auto append = [&](StringView str_) {
+			payload.append(str_);
+			payload.push_back('\0');
+		};
+
+	append(request_.kind);
+	append(request_.version);
+	append(request_.cwd.string());
+	append(std::to_string(request_.args.size()));
+	for (auto const& arg : request_.args)
+		append(arg);
+	for (auto const& var : request_.environment)
+		append(var);
+
+	return payload;
+}
+
+///////////////////////////////////////////////////
+static auto decode(StringView payload_) -> Opt<Request>
+{
+	auto fields = Vec<String>();
+	while (!payload_.empty())
+	{
+		auto end = payload_.find('\0');
+		if (end == StringView::npos)
+			return std::nullopt;
+
+		fields.emplace_back(payload_.substr(0, end));
+		payload_.remove_prefix(end + 1);
+	}
+
+	if (fields.size() < 4)
+		return std::nullopt;
+
+	auto numArgs = std::size_t(0);
+	try {
+		numArgs = std::stoul(fields[3]);
+	}
+	catch(...) {
+		return std::nullopt;
+	}
+
+	if (fields.size() < 4 + numArgs)
+		return std::nullopt;
+
+	auto request = Request();
+	request.kind 	= std::move(fields[0]);
+	request.version = std::move(fields[1]);
+	request.cwd 	= Path(fields[2]);
+
+	auto firstArg = fields.begin() + 4;
+	request.args.assign(std::make_move_iterator(firstArg), std::make_move_iterator(firstArg + numArgs));
+	request.environment.assign(std::make_move_iterator(firstArg + numArgs), std::make_move_iterator(fields.end()));
+
+	return request;
+}
+
+///////////////////////////////////////////////////
+static auto sendRequest(int fd_, Request const& request_, bool withStreams_) -> bool
+{
+	auto payload 	= encode(request_);
+	auto size 		= uint32_t(payload.size());
+
+	// The size goes together with the descriptors of the standard streams
+	auto iov = iovec{ &size, sizeof(size) };
+	auto msg = msghdr{};
+	msg.msg_iov 	= &iov;
+	msg.msg_iovlen 	= 1;
+
+	alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * NumStreams)] = {};
+	if (withStreams_)
+	{
+		msg.msg_control 	= control;
+		msg.msg_controllen 	= sizeof(control);
+
+		auto cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level 	= SOL_SOCKET;
+		cmsg->cmsg_type 	= SCM_RIGHTS;
+		cmsg->cmsg_len 		= CMSG_LEN(sizeof(int) * NumStreams);
+
+		int const streams[NumStreams] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+		std::memcpy(CMSG_DATA(cmsg), streams, sizeof(streams));
+	}
+
+	auto sent = ssize_t(0);
+	do {
+		sent = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+	} while (sent < 0 && errno == EINTR);
+
+	if (sent != sizeof(size))
+		return false;
+
+	return writeAll(fd_, payload.data(), payload.size());
+}
+
+///////////////////////////////////////////////////
+static auto receiveRequest(int fd_) -> Opt<Request>
+{
+	auto size = uint32_t(0);
+	auto iov = iovec{ &size, sizeof(size) };
+	auto msg = msghdr{};
+	msg.msg_iov 	= &iov;
+	msg.msg_iovlen 	= 1;
+
+	alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * NumStreams)] = {};
+	msg.msg_control 	= control;
+	msg.msg_controllen 	= sizeof(control);
+
+	auto received = ssize_t(0);
+	do {
+		received = ::recvmsg(fd_, &msg, MSG_CMSG_CLOEXEC);
+	} while (received < 0 && errno == EINTR);
+
+	auto streams = Array<int, NumStreams>{ -1, -1, -1 };
+	for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+	{
+		if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS
+			&& cmsg->cmsg_len == CMSG_LEN(sizeof(int) * NumStreams))
+		{
+			std::memcpy(streams.data(), CMSG_DATA(cmsg), sizeof(int) * NumStreams);
+		}
+	}
+
+	auto closeStreams = [&] {
+			for (auto fd : streams)
+				if (fd >= 0) ::close(fd);
+		};
+
+	// Short reads of the 4 byte header are not expected on a local socket
+	if (received != sizeof(size) || size > 16 * 1024 * 1024)
+	{
+		closeStreams();
+		return std::nullopt;
+	}
+
+	auto payload = String(size, '\0');
+	auto request = Opt<Request>();
+	if (readAll(fd_, payload.data(), payload.size()))
+		request = decode(payload);
+
+	if (!request)
+	{
+		closeStreams();
+		return std::nullopt;
+	}
+
+	request->streams = streams;
+	return request;
+}
+
+///////////////////////////////////////////////////
+static auto reply(int fd_, int32_t code_) -> void
+{
+	writeAll(fd_, &code_, sizeof(code_));
+}
+
+///////////////////////////////////////////////////
+static auto sendControlRequest(StringView kind_) -> bool
+{
+	auto conn = FileDescriptor(connectToDaemon());
+	if (conn.fd < 0)
+		return false;
+
+	auto request = Request();
+	request.kind 	= String(kind_);
+	request.version = String(PaccApp::PaccVersion);
+
+	auto code = int32_t(0);
+	return sendRequest(conn.fd, request, false) && readAll(conn.fd, &code, sizeof(code));
+}
+
+///////////////////////////////////////////////////
+static auto isManifestFileName(StringView name_) -> bool
+{
+	auto isOneOf = [&](auto const& names) { return rg::find(names, name_) != std::end(names); };
+
+	return isOneOf(PackageJSON) || isOneOf(PackageLUA) || isOneOf(PackageLUAScript);
+}
+
+/// <summary>Command run in a child process of the daemon.</summary>
+struct Job
+{
+	pid_t 			pid 		= -1;
+	FileDescriptor 	conn; 					// receives the exit code
+	FileDescriptor 	misses; 				// manifests parsed by the command, closed when it ends
+	String 			manifests;
+	bool 			interrupted = false; 	// the client disconnected
+};
+
+/// <summary>State of the running daemon.</summary>
+class Server
+{
+public:
+	explicit Server(PaccApp& app_)
+		: app(app_)
+	{
+	}
+
+	void run();
+
+private:
+	void listen();
+	void watch(Path const& folder_);
+	void processFileEvents();
+	void handleFileEvent(inotify_event const& event_);
+	void reloadConfigIfChanged();
+
+	void handleConnection(FileDescriptor& conn_);
+	[[noreturn]] void runChild(Request& request_, int conn_, int missesFd_);
+	void serviceJob(Job& job_, pollfd const& misses_, pollfd const& conn_);
+	void reapJobs();
+	void warmUp(StringView manifests_);
+
+	PaccApp& 			app;
+	FileDescriptor 		listener;
+	FileDescriptor 		inotify;
+	Path 				dataFolder;
+	UMap<int, Path> 	watchedFolders; 	// by watch descriptor
+	StrUMap<int> 		watchDescriptors; 	// by folder
+	Vec<UPtr<Job>> 		jobs; 				// running commands
+	bool 				configChanged 	= false;
+	bool 				running 		= true;
+};
+
+///////////////////////////////////////////////////
+void Server::run()
+{
+	dataFolder = env::requirePaccDataStorageFolder();
+
+	this->listen();
+
+	inotify.fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify.fd < 0)
+		throw PaccException("Could not start the pacc daemon: inotify is not available ({}).", std::strerror(errno));
+
+	this->watch(dataFolder);
+
+	// Prepared once, reused by every command
+	app.loadPaccConfig();
+	packageCache().enabled = true;
+
+	// Disconnected clients must not terminate the daemon
+	::signal(SIGPIPE, SIG_IGN);
+
+	fmt::print("pacc daemon listening on \"{}\" (stop with \"pacc daemon stop\")\n", socketPath().string());
+	std::fflush(stdout);
+
+	// Commands run concurrently, a long build does not hold up the others
+	while (running || !jobs.empty())
+	{
+		auto fds = Vec<pollfd>{
+				{ listener.fd, POLLIN, 0 },
+				{ inotify.fd, POLLIN, 0 }
+			};
+
+		for (auto const& job : jobs)
+		{
+			fds.push_back({ job->misses.fd, POLLIN, 0 });
+			fds.push_back({ job->interrupted ? -1 : job->conn.fd, POLLIN, 0 }); // the client sends nothing more, so this means it disconnected
+		}
+
+		// A command that ended is reaped shortly after it closes its pipe
+		auto ended 		= rg::any_of(jobs, [](auto const& job_) { return job_->misses.fd < 0; });
+		auto numJobs 	= jobs.size();
+
+		if (::poll(fds.data(), fds.size(), ended ? 10 : -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			throw PaccException("pacc daemon: poll failed ({}).", std::strerror(errno));
+		}
+
+		if (fds[1].revents & POLLIN)
+			this->processFileEvents();
+
+		for (std::size_t i = 0; i < numJobs; ++i)
+			this->serviceJob(*jobs[i], fds[2 + 2 * i], fds[3 + 2 * i]);
+
+		this->reapJobs();
+
+		if (listener.fd >= 0 && (fds[0].revents & POLLIN))
+		{
+			auto conn = FileDescriptor(::accept4(listener.fd, nullptr, nullptr, SOCK_CLOEXEC));
+			if (conn.fd >= 0)
+				this->handleConnection(conn);
+		}
+	}
+
+	fmt::print("pacc daemon stopped\n");
+}
+
+///////////////////////////////////////////////////
+void Server::listen()
+{
+	auto path = socketPath();
+
+	if (isRunning())
+	{
+		throw PaccException("The pacc daemon is already running.")
+			.withHelp("Use \"pacc daemon stop\" to stop it.");
+	}
+
+	auto addr = sockaddr_un{};
+	if (!socketAddress(addr))
+		throw PaccException("Could not start the pacc daemon: socket path \"{}\" is too long.", path.string());
+
+	// Left behind by a daemon that did not exit cleanly
+	auto ec = std::error_code{};
+	fs::remove(path, ec);
+
+	listener.fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listener.fd < 0
+		|| ::bind(listener.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+		|| ::listen(listener.fd, 16) != 0)
+	{
+		throw PaccException("Could not start the pacc daemon on \"{}\" ({}).", path.string(), std::strerror(errno));
+	}
+
+	// Commands run with the daemon's user rights
+	::chmod(path.c_str(), S_IRUSR | S_IWUSR);
+}
+
+///////////////////////////////////////////////////
+void Server::watch(Path const& folder_)
+{
+	auto key = folder_.string();
+	if (watchDescriptors.contains(key))
+		return;
+
+	constexpr auto Mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO
+		| IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+	auto wd = ::inotify_add_watch(inotify.fd, key.c_str(), Mask);
+	if (wd < 0)
+		return;
+
+	watchedFolders[wd] = folder_;
+	watchDescriptors[std::move(key)] = wd;
+}
+
+///////////////////////////////////////////////////
+void Server::processFileEvents()
+{
+	alignas(inotify_event) char buffer[16 * 1024];
+
+	while (true)
+	{
+		auto numRead = ::read(inotify.fd, buffer, sizeof(buffer));
+		if (numRead <= 0)
+			break;
+
+		for (auto pos = buffer; pos < buffer + numRead; )
+		{
+			auto const& event = *reinterpret_cast<inotify_event const*>(pos);
+			this->handleFileEvent(event);
+			pos += sizeof(inotify_event) + event.len;
+		}
+	}
+}
+
+///////////////////////////////////////////////////
+void Server::handleFileEvent(inotify_event const& event_)
+{
+	if (event_.mask & IN_Q_OVERFLOW)
+	{
+		// Events were lost
+		packageCache().clear();
+		configChanged = true;
+		return;
+	}
+
+	auto it = watchedFolders.find(event_.wd);
+	if (it == watchedFolders.end())
+		return;
+
+	auto const& folder = it->second;
+
+	if (event_.mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+	{
+		packageCache().invalidateFolder(folder);
+
+		if (event_.mask & IN_IGNORED)
+		{
+			watchDescriptors.erase(folder.string());
+			watchedFolders.erase(it);
+		}
+		return;
+	}
+
+	auto name = StringView(event_.len > 0 ? event_.name : "");
+
+	if (folder == dataFolder && name == "settings.json")
+		configChanged = true;
+	else if (isManifestFileName(name))
+		packageCache().invalidateFolder(folder);
+}
+
+///////////////////////////////////////////////////
+void Server::reloadConfigIfChanged()
+{
+	if (!configChanged)
+		return;
+
+	configChanged = false;
+	app.paccConfigLoaded = false;
+
+	try {
+		app.loadPaccConfig();
+	}
+	catch(std::exception& exc) {
+		// Commands load it again and report the error
+		fmt::printErr(fmt::fg(fmt::color::red), "pacc daemon: could not reload settings.json: {}\n", exc.what());
+	}
+}
+
+///////////////////////////////////////////////////
+void Server::handleConnection(FileDescriptor& conn_)
+{
+	auto request = receiveRequest(conn_.fd);
+	if (!request)
+		return;
+
+	if (request->kind == "stop")
+	{
+		// New commands run in-process, the running ones finish first
+		running = false;
+		listener.close();
+
+		auto ec = std::error_code{};
+		fs::remove(socketPath(), ec);
+
+		reply(conn_.fd, 0);
+		return;
+	}
+
+	if (request->kind != "run" || request->version != PaccApp::PaccVersion)
+	{
+		for (auto fd : request->streams)
+			if (fd >= 0) ::close(fd);
+
+		reply(conn_.fd, request->kind == "ping" ? 0 : FallbackCode);
+		return;
+	}
+
+	// Apply the changes made since the last command
+	this->processFileEvents();
+	this->reloadConfigIfChanged();
+	fsx::dirCache().clear();
+
+	int misses[2];
+	if (::pipe2(misses, O_CLOEXEC) != 0)
+	{
+		reply(conn_.fd, FallbackCode);
+		return;
+	}
+
+	std::fflush(nullptr);
+	std::cout.flush();
+
+	auto pid = ::fork();
+	if (pid == 0)
+		this->runChild(*request, conn_.fd, misses[1]);
+
+	::close(misses[1]);
+	for (auto fd : request->streams)
+		if (fd >= 0) ::close(fd);
+
+	if (pid < 0)
+	{
+		::close(misses[0]);
+		reply(conn_.fd, FallbackCode);
+		return;
+	}
+
+	auto job = std::make_unique<Job>();
+	job->pid 		= pid;
+	job->conn.fd 	= std::exchange(conn_.fd, -1);
+	job->misses.fd 	= misses[0];
+	jobs.push_back(std::move(job));
+}
+
+///////////////////////////////////////////////////
+void Server::runChild(Request& request_, int conn_, int missesFd_)
+{
+	// Exit codes are reported by the daemon
+	::close(conn_);
+	listener.close();
+	inotify.close();
+
+	for (auto& job : jobs)
+	{
+		job->conn.close();
+		job->misses.close();
+	}
+
+	// Own process group, so that the whole command can be stopped
+	::setpgid(0, 0);
+	::signal(SIGPIPE, SIG_DFL);
+
+	for (std::size_t i = 0; i < NumStreams; ++i)
+	{
+		if (request_.streams[i] < 0)
+			continue;
+
+		::dup2(request_.streams[i], int(i));
+		::close(request_.streams[i]);
+	}
+
+	// Run with the environment of the client
+	::clearenv();
+	for (auto& var : request_.environment)
+		::putenv(var.data());
+
+	auto code = 1;
+	auto ec = std::error_code{};
+	fs::current_path(request_.cwd, ec);
+
+	if (ec)
+		fmt::printErr(fmt::fg(fmt::color::red), "pacc daemon: could not enter \"{}\": {}\n", request_.cwd.string(), ec.message());
+	else
+		code = runPacc(std::move(request_.args));
+
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(nullptr);
+
+	// Report the manifests parsed by this command, so that the next one gets them from memory
+	auto manifests = String();
+	for (auto const& root : packageCache().takeMisses())
+	{
+		manifests += root.string();
+		manifests += '\n';
+	}
+	writeAll(missesFd_, manifests.data(), manifests.size());
+
+	::_exit(code);
+}
+
+///////////////////////////////////////////////////
+void Server::serviceJob(Job& job_, pollfd const& misses_, pollfd const& conn_)
+{
+	if (conn_.revents != 0)
+	{
+		// Client was interrupted (f.e. Ctrl+C), stop the command
+		if (::kill(-job_.pid, SIGTERM) != 0)
+			::kill(job_.pid, SIGTERM);
+		job_.interrupted = true;
+	}
+
+	if (misses_.revents != 0)
+	{
+		char buffer[4096];
+		auto numRead = ::read(job_.misses.fd, buffer, sizeof(buffer));
+		if (numRead > 0)
+			job_.manifests.append(buffer, std::size_t(numRead));
+		else if (numRead == 0 || errno != EINTR)
+			job_.misses.close();
+	}
+}
+
+///////////////////////////////////////////////////
+void Server::reapJobs()
+{
+	for (std::size_t i = 0; i < jobs.size(); )
+	{
+		auto& job = *jobs[i];
+
+		auto status = 0;
+		if (job.misses.fd >= 0 || ::waitpid(job.pid, &status, WNOHANG) != job.pid)
+		{
+			++i;
+			continue;
+		}
+
+		auto code = 1;
+		if (WIFEXITED(status))
+			code = WEXITSTATUS(status);
+		else if (WIFSIGNALED(status))
+			code = 128 + WTERMSIG(status);
+
+		reply(job.conn.fd, code);
+
+		auto manifests = std::move(job.manifests);
+		jobs.erase(jobs.begin() + i);
+
+		this->warmUp(manifests);
+	}
+}
+
+///////////////////////////////////////////////////
+void Server::warmUp(StringView manifests_)
+{
+	auto& cache = packageCache();
+
+	while (!manifests_.empty())
+	{
+		auto end = manifests_.find('\n');
+		auto root = Path(String(manifests_.substr(0, end)));
+		manifests_.remove_prefix(end == StringView::npos ? manifests_.size() : end + 1);
+
+		auto folder = root.parent_path();
+
+		// Watch first, so that a change made during the load is not missed
+		this->watch(folder);
+
+		try {
+			// A script file could have been added in the meantime
+			if (!findPackageScriptFile(folder).empty())
+				continue;
+
+			auto pkg = Package::load(PackagePreloadInfo{ root, {} });
+			if (!pkg->isCMake)
+				cache.store(std::move(pkg));
+		}
+		catch(...) {
+			// Broken manifest, the next command reports it
+		}
+	}
+
+	// Recorded by the loads above
+	cache.takeMisses();
+}
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto forward(ProgramArgs const& args_) -> Opt<int>
+{
+	using Action = PaccMainAction;
+
+	if (args_.size() < 2 || std::getenv("PACC_NO_DAEMON"))
+		return std::nullopt;
+
+	try {
+		auto settings = RunSettings::fromArgs(args_);
+		switch (settings.mainAction)
+		{
+		case Action::None:
+		case Action::Version:
+		case Action::Help:
+		case Action::Daemon:
+		case Action::Run: 		// interactive, keeps the terminal of the client
+		case Action::Worker: 	// runs until interrupted
+			return std::nullopt;
+		default:
+			break;
+		}
+
+		// Watch mode runs until interrupted
+		if (settings.isFlagSet("--watch"))
+			return std::nullopt;
+	}
+	catch(...) {
+		// Invalid arguments are reported in-process
+		return std::nullopt;
+	}
+
+	auto conn = FileDescriptor(connectToDaemon());
+	if (conn.fd < 0)
+		return std::nullopt;
+
+	auto ec = std::error_code{};
+
+	auto request = Request();
+	request.kind 	= "run";
+	request.version = String(PaccApp::PaccVersion);
+	request.cwd 	= fs::current_path(ec);
+	request.args 	= args_;
+	for (auto var = environ; var && *var; ++var)
+		request.environment.emplace_back(*var);
+
+	if (ec || !sendRequest(conn.fd, request, true))
+		return std::nullopt;
+
+	auto code = int32_t(0);
+	if (!readAll(conn.fd, &code, sizeof(code)))
+	{
+		fmt::printErr(fmt::fg(fmt::color::red), "pacc: the daemon stopped before the command finished.\n");
+		return 1;
+	}
+
+	if (code == FallbackCode)
+		return std::nullopt;
+
+	return code;
+}
+
+///////////////////////////////////////////////////
+void serve(PaccApp& app_)
+{
+	auto server = Server(app_);
+	server.run();
+}
+
+///////////////////////////////////////////////////
+auto stop() -> bool
+{
+	return sendControlRequest("stop");
+}
+
+///////////////////////////////////////////////////
+auto isRunning() -> bool
+{
+	return sendControlRequest("ping");
+}
+
+#else
+
+///////////////////////////////////////////////////
+auto forward(ProgramArgs const& args_) -> Opt<int>
+{
+	return std::nullopt;
+}
+
+///////////////////////////////////////////////////
+void serve(PaccApp& app_)
+{
+	throw PaccException("The pacc daemon is supported only on Linux.");
+}
+
+///////////////////////////////////////////////////
+auto stop() -> bool
+{
+	return false;
+}
+
+///////////////////////////////////////////////////
+auto isRunning() -> bool
+{
+	return false;
+}
+
+#endif
+
+}
@@ -1,7 +1,7 @@
 #include "include/Pacc/PaccPCH.hpp"
 
 #include <Pacc/App/PaccConfig.hpp>
-#include <Pacc/Readers/General.hpp>
+#include <Pacc/System/FileView.hpp>
 #include <Pacc/Helpers/Json.hpp>
 
 #include <Pacc/Toolchains/MSVC.hpp>
@@ -29,7 +29,7 @@ PaccConfig PaccConfig::load(fs::path const& jsonPath_)
 	PaccConfig result;
 	result.path = jsonPath_;
 
-	json j = json::parse(readFileContents(jsonPath_));
+	json j = json::parse(FileView(jsonPath_));
 
 	result.detectedToolchains = result.readToolchains(j, "detectedToolchains");
 	auto customTcs = result.readToolchains(j, "customToolchains");
@@ -38,6 +38,8 @@ PaccConfig PaccConfig::load(fs::path const& jsonPath_)
 	result.toolchains.insert(result.toolchains.end(), customTcs.begin(), customTcs.end());
 
 	result.readSelectedToolchain(j);
+	result.readWorkers(j);
+	result.readLinkLimits(j);
 
 	return result;
 }
@@ -64,6 +66,34 @@ void PaccConfig::readSelectedToolchain(json const& input_)
 	}
 }
 
+/////////////////////////////////////////////////
+void PaccConfig::readWorkers(json const& input_)
+{
+	if (auto token = input_.find("workerToken"); token != input_.end() && token->is_string())
+		workerToken = token->get<String>();
+
+	auto it = input_.find("workers");
+
+	if (it == input_.end() || it->type() != json::value_t::array)
+		return;
+
+	for (auto const& address : *it)
+	{
+		if (address.is_string())
+			workers.push_back(address.get<String>());
+	}
+}
+
+/////////////////////////////////////////////////
+void PaccConfig::readLinkLimits(json const& input_)
+{
+	if (auto it = input_.find("linkJobs"); it != input_.end() && it->is_number_integer() && it->get<int>() > 0)
+		linkJobs = it->get<int>();
+
+	if (auto it = input_.find("linkJobMemory"); it != input_.end() && it->is_number_integer() && it->get<int>() > 0)
+		linkJobMemory = it->get<int>();
+}
+
 /////////////////////////////////////////////////
 PaccConfig::VecOfTc PaccConfig::readToolchains(json const& input_, String const& field_)
 {
@@ -127,7 +157,7 @@ void PaccConfig::updateToolchains(Vec< SPtr<Toolchain> > current_)
 	detectedToolchains = std::move(current_);
 	toolchains.insert(toolchains.begin(), detectedToolchains.begin(), detectedToolchains.end());
 
-	json j = json::parse(readFileContents(path));
+	json j = json::parse(FileView(path));
 
 	j["detectedToolchains"] = serializeToolchains(detectedToolchains);
 
@@ -142,7 +172,7 @@ void PaccConfig::updateSelectedToolchain(int index_)
 
 	selectedToolchain = index_;
 
-	json j = json::parse(readFileContents(path));
+	json j = json::parse(FileView(path));
 
 	j["selectedToolchain"] = int(selectedToolchain);
 
@@ -39,10 +39,28 @@ static auto setupFlagsByMainAction(ProgramFlagMap& flags, PaccMainAction mainAct
 		addFlag(flags, { "--all" });
 		break;
 	}
+	case Action::Graph:
+	{
+		addFlag(flags, { "--format" });
+		break;
+	}
 	case Action::Build:
+	{
+		addFlag(flags, { "--profile-compile" });
+		addFlag(flags, { "--watch" });
+		addFlag(flags, { "--distribute" });
+		addFlag(flags, { "--workers" });
+		[[fallthrough]];
+	}
 	case Action::Generate:
 	{
 		addFlag(flags, { "--compile-commands", "-cc" });
+		addFlag(flags, { "--unity" });
+		break;
+	}
+	case Action::Worker:
+	{
+		addFlag(flags, { "--listen" });
 		break;
 	}
 	}
@@ -103,6 +121,9 @@ auto RunSettings::fromArgs(Vec<String> const& args_) -> RunSettings
 
 		// Select the target
 		addFlag(settings.flags, { "--target" });
+
+		// Record a Chrome trace of the run, e.g. --trace=trace.json
+		addFlag(settings.flags, { "--trace" });
 	}
 
 
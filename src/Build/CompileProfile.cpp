@@ -0,0 +1,338 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Build/CompileProfile.hpp>
+#include <Pacc/Toolchains/GNUMake.hpp>
+#include <Pacc/Generation/Logs.hpp>
+#include <Pacc/System/FileView.hpp>
+#include <Pacc/Helpers/Parallel.hpp>
+
+#include <charconv>
+
+using Entry = CompileProfile::Entry;
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static void readClangTraces(CompileProfile& profile_, Path const& objFolder_, fs::file_time_type buildStart_);
+static void readGccReport(CompileProfile& profile_, Path const& log_, bool matchFiles_);
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto compileProfilerFor(Toolchain const& toolchain_) -> CompileProfiler
+{
+	if (auto gnuMake = dynamic_cast<GNUMakeToolchain const*>(&toolchain_))
+	{
+		if (gnuMake->cppCompilerName.find("clang") != String::npos)
+			return CompileProfiler::ClangTimeTrace;
+
+		return CompileProfiler::GccTimeReport;
+	}
+
+	return CompileProfiler::None;
+}
+
+///////////////////////////////////////////////////
+auto enableCompileProfiling(Package& package_, Toolchain const& toolchain_) -> bool
+{
+	auto option = StringView();
+	switch (compileProfilerFor(toolchain_))
+	{
+	case CompileProfiler::ClangTimeTrace: 	option = "-ftime-trace"; break;
+	case CompileProfiler::GccTimeReport: 	option = "-ftime-report"; break;
+	default: 								return false;
+	}
+
+	for (auto& project : package_.projects)
+		project.compilerOptions.self.private_.push_back(String(option));
+
+	return true;
+}
+
+///////////////////////////////////////////////////
+auto collectCompileProfile(Package const& package_, CompileProfiler profiler_, fs::file_time_type buildStart_, int jobs_) -> CompileProfile
+{
+	auto profile = CompileProfile();
+	profile.profiler = profiler_;
+
+	if (profiler_ == CompileProfiler::ClangTimeTrace)
+		readClangTraces(profile, package_.root.parent_path() / "build" / "obj", buildStart_);
+	else if (profiler_ == CompileProfiler::GccTimeReport)
+	{
+		// Reports of parallel jobs interleave, their order says nothing about the files
+		profile.unitsNamed = (jobs_ == 1);
+
+		if (auto log = findLatestBuildLog(package_.name))
+			readGccReport(profile, *log, profile.unitsNamed);
+	}
+
+	auto slowestFirst = [](Vec<Entry>& entries_) {
+			rg::sort(entries_, rg::greater{}, &Entry::milliseconds);
+		};
+
+	slowestFirst(profile.translationUnits);
+	slowestFirst(profile.headers);
+	slowestFirst(profile.templates);
+	slowestFirst(profile.phases);
+
+	return profile;
+}
+
+///////////////////////////////////////////////////
+auto CompileProfile::toJSON() const -> json
+{
+	auto entries = [](Vec<Entry> const& entries_)
+		{
+			auto result = json::array();
+			for (auto const& e : entries_)
+				result.push_back({ { "name", e.name }, { "ms", e.milliseconds }, { "count", e.count } });
+			return result;
+		};
+
+	auto j = json::object();
+	j["profiler"] 			= (profiler == CompileProfiler::ClangTimeTrace) ? "clang -ftime-trace" : "gcc -ftime-report";
+	j["translationUnits"] 	= entries(translationUnits);
+	j["headers"] 			= entries(headers);
+	j["templates"] 			= entries(templates);
+	j["phases"] 			= entries(phases);
+	j["unitsNamed"] 		= unitsNamed;
+	return j;
+}
+
+///////////////////////////////////////////////////
+void CompileProfile::printSummary(std::size_t limit_) const
+{
+	using fmt::fg, fmt::color;
+
+	auto printSection = [&](StringView title_, Vec<Entry> const& entries_)
+		{
+			if (entries_.empty())
+				return;
+
+			fmt::print(fg(color::light_sky_blue) | fmt::emphasis::bold, "\n{}:\n", title_);
+			for (std::size_t i = 0; i < std::min(limit_, entries_.size()); ++i)
+			{
+				auto const& e = entries_[i];
+				if (e.count > 1)
+					fmt::print("{:>10.1f} ms  {} ({}x)\n", e.milliseconds, e.name, e.count);
+				else
+					fmt::print("{:>10.1f} ms  {}\n", e.milliseconds, e.name);
+			}
+		};
+
+	if (translationUnits.empty())
+	{
+		fmt::print(fg(color::yellow), "No compile profiling data found (nothing was compiled?).\n");
+		return;
+	}
+
+	auto total = 0.0;
+	for (auto const& tu : translationUnits)
+		total += tu.milliseconds;
+
+	fmt::print(fg(color::gray), "\nCompiled {} translation units in {:.1f} ms (summed over all units).\n", translationUnits.size(), total);
+
+	if (!unitsNamed)
+		fmt::print(fg(color::yellow), "Translation units are numbered: gcc reports of parallel jobs cannot be matched to the files (build with \"--cores=1\" to name them).\n");
+
+	printSection("Slowest translation units", 				translationUnits);
+	printSection("Most expensive headers (cumulative parse time)", 	headers);
+	printSection("Most expensive template instantiations", 	templates);
+	printSection("Compilation phases (all units)", 			phases);
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static void addTo(StrUMap<Entry>& entries_, String const& name_, double milliseconds_)
+{
+	auto& e = entries_[name_];
+	e.milliseconds += milliseconds_;
+	e.count += 1;
+}
+
+///////////////////////////////////////////////////
+static auto toVec(StrUMap<Entry>& entries_) -> Vec<Entry>
+{
+	auto result = Vec<Entry>();
+	result.reserve(entries_.size());
+	for (auto& [name, e] : entries_)
+	{
+		e.name = name;
+		result.push_back(std::move(e));
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////
+static void readClangTraces(CompileProfile& profile_, Path const& objFolder_, fs::file_time_type buildStart_)
+{
+	struct TraceSummary
+	{
+		Opt<Entry> 		translationUnit;
+		StrUMap<Entry> 	headers;
+		StrUMap<Entry> 	templates;
+	};
+
+	// Only traces written by this build (others belong to object files that were not rebuilt):
+	auto traces = Vec<Path>();
+
+	auto ec = std::error_code{};
+	for (auto it = fs::recursive_directory_iterator(objFolder_, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+	{
+		if (it->path().extension() == ".json" && it->is_regular_file(ec) && it->last_write_time(ec) >= buildStart_)
+			traces.push_back(it->path());
+	}
+
+	// Traces are independent and can be large, read them in parallel:
+	auto summaries = Vec<TraceSummary>(traces.size());
+	parallelFor(traces.size(), [&](std::size_t i_)
+		{
+			auto& summary = summaries[i_];
+
+			auto j = json::parse(FileView(traces[i_]), nullptr, false);
+			if (j.is_discarded() || !j.contains("traceEvents"))
+				return;
+
+			auto total = 0.0;
+			for (auto const& event : j["traceEvents"])
+			{
+				if (event.value("ph", "") != "X")
+					continue;
+
+				auto name 	= event.value("name", "");
+				auto ms 	= event.value("dur", 0.0) / 1000.0;
+
+				if (name == "Total ExecuteCompiler")
+					total = ms;
+				else if (name == "ExecuteCompiler")
+					total = std::max(total, ms);
+				else if (name == "Source" || name == "InstantiateClass" || name == "InstantiateFunction")
+				{
+					auto detail = event.contains("args") ? event["args"].value("detail", "") : "";
+					addTo(name == "Source" ? summary.headers : summary.templates, detail, ms);
+				}
+			}
+
+			auto tuName = fsx::fwd(fs::relative(traces[i_], objFolder_).replace_extension("")).string();
+			summary.translationUnit = Entry{ std::move(tuName), total, 1 };
+		});
+
+	auto headers 	= StrUMap<Entry>();
+	auto templates 	= StrUMap<Entry>();
+
+	for (auto& summary : summaries)
+	{
+		if (!summary.translationUnit)
+			continue;
+
+		profile_.translationUnits.push_back(std::move(*summary.translationUnit));
+
+		for (auto const& [name, e] : summary.headers)
+		{
+			auto& merged = headers[name];
+			merged.milliseconds += e.milliseconds;
+			merged.count 		+= e.count;
+		}
+		for (auto const& [name, e] : summary.templates)
+		{
+			auto& merged = templates[name];
+			merged.milliseconds += e.milliseconds;
+			merged.count 		+= e.count;
+		}
+	}
+
+	profile_.headers 	= toVec(headers);
+	profile_.templates 	= toVec(templates);
+}
+
+///////////////////////////////////////////////////
+/// <summary>Reads numbers of a "-ftime-report" line (f.e. "0.38 ( 41%)   0.12 ( 60%)   0.50 ( 44%)  52M ( 55%)").</summary>
+static auto parseTimes(StringView line_) -> Vec<double>
+{
+	auto result = Vec<double>();
+
+	auto tokens = String(line_);
+	auto stream = std::istringstream(tokens);
+	for (String token; stream >> token; )
+	{
+		auto value 	= 0.0;
+		auto end 	= token.data() + token.size();
+		auto [ptr, err] = std::from_chars(token.data(), end, value);
+
+		// Skip percentages and memory sizes
+		if (err == std::errc{} && ptr == end)
+			result.push_back(value);
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+static void readGccReport(CompileProfile& profile_, Path const& log_, bool matchFiles_)
+{
+	constexpr StringView StdErrHeader = "\n\nSTDERR:\n\n";
+
+	auto file 		= FileView(log_);
+	auto content 	= file.view();
+
+	auto stdErrPos 	= content.find(StdErrHeader);
+	auto stdOut 	= content.substr(0, stdErrPos);
+	auto stdErr 	= (stdErrPos == StringView::npos) ? StringView() : content.substr(stdErrPos + StdErrHeader.size());
+
+	auto forEachLine = [](StringView text_, auto&& func_)
+		{
+			while (!text_.empty())
+			{
+				auto end = text_.find('\n');
+				func_(text_.substr(0, end));
+				text_ = (end == StringView::npos) ? StringView() : text_.substr(end + 1);
+			}
+		};
+
+	// Make prints the name of each compiled file:
+	auto sources = Vec<String>();
+	forEachLine(matchFiles_ ? stdOut : StringView(), [&](StringView line_)
+		{
+			auto ext = Path(line_).extension();
+			if (ext == ".cpp" || ext == ".cc" || ext == ".cxx" || ext == ".c++" || ext == ".c")
+				sources.push_back(String(line_));
+		});
+
+	// Reports follow the same order as the compiled files (on a single job):
+	auto phases = StrUMap<Entry>();
+	forEachLine(stdErr, [&](StringView line_)
+		{
+			auto colon = line_.find(':');
+			if (colon == StringView::npos)
+				return;
+
+			auto name = line_.substr(0, colon);
+			while (!name.empty() && std::isspace(uint8_t(name.front()))) name.remove_prefix(1);
+			while (!name.empty() && std::isspace(uint8_t(name.back()))) name.remove_suffix(1);
+
+			auto times = parseTimes(line_.substr(colon + 1));
+			if (times.size() < 3)
+				return;
+
+			auto wallMs = times[2] * 1000.0; // usr, sys, wall
+
+			if (name == "TOTAL")
+			{
+				auto idx = profile_.translationUnits.size();
+				auto tuName = (idx < sources.size()) ? sources[idx] : fmt::format("#{}", idx + 1);
+				profile_.translationUnits.push_back(Entry{ std::move(tuName), wallMs, 1 });
+			}
+			else if (name.starts_with("phase ") || name == "template instantiation")
+				addTo(phases, String(name), wallMs);
+		});
+
+	profile_.phases = toVec(phases);
+}
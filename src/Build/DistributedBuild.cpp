@@ -0,0 +1,769 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Build/DistributedBuild.hpp>
+#include <Pacc/Build/JobServer.hpp>
+
+#include <Pacc/System/Socket.hpp>
+#include <Pacc/Readers/General.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+#include <Pacc/Helpers/Formatting.hpp>
+#include <Pacc/Helpers/Parallel.hpp>
+#include <Pacc/Helpers/String.hpp>
+
+#ifdef PACC_SYSTEM_LINUX
+	#include <unistd.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <sys/socket.h>
+	#include <sys/wait.h>
+#endif
+
+#include <cstring>
+#include <regex>
+
+namespace distributed
+{
+
+#ifdef PACC_SYSTEM_LINUX
+
+using net::FileDescriptor;
+
+constexpr StringView ProtocolName 		= "pacc-worker";
+constexpr StringView ProtocolVersion 	= "2";
+
+constexpr std::size_t MaxHeaderSize 	= 1024 * 1024;
+constexpr std::size_t MaxFileSize 		= 1024 * 1024 * 1024;
+
+constexpr auto ConnectTimeout 	= ch::milliseconds(2000);
+constexpr auto RequestTimeout 	= ch::milliseconds(60'000); // the launcher sends the job right after the greeting
+
+// Options of the compile command that the launcher keeps local:
+// different outputs, explicit languages (f.e. headers) and files the worker does not have
+constexpr StringView LocalOnlyOptions[] = {
+		"-E", "-S", "-M", "-MM", "-include-pch", "-Xclang", "-mllvm", "-Xassembler", "-Xpreprocessor", "-Xlinker"
+	};
+constexpr StringView LocalOnlyPrefixes[] = {
+		"-x", "-B", "-specs", "--specs", "-wrapper", "-save-temps", "--save-temps", "-fplugin", "-ftime-trace",
+		"-fprofile-use", "-fprofile-sample-use", "-fauto-profile", "-fsanitize-blacklist", "-fsanitize-ignorelist",
+		"-fmodules", "-fmodule-file", "-fprebuilt-module-path"
+	};
+
+// Preprocessor options, not passed to the workers
+constexpr StringView PreprocessorOptionsWithValue[] = {
+		"-D", "-U", "-I", "-include", "-imacros", "-isystem", "-iquote", "-idirafter",
+		"-iprefix", "-iwithprefix", "-iwithprefixbefore", "-isysroot", "-MF", "-MT", "-MQ"
+	};
+constexpr StringView PreprocessorFlags[] = {
+		"-MD", "-MMD", "-MP", "-MG", "-nostdinc", "-nostdinc++", "-undef"
+	};
+constexpr StringView PreprocessorPrefixes[] = {
+		"-D", "-U", "-I", "-isystem", "-iquote", "-idirafter", "-MF", "-MT", "-MQ", "-Wp,"
+	};
+
+// Compiler options followed by a value (a target name)
+constexpr StringView OptionsWithValue[] = {
+		"-target", "-arch"
+	};
+
+// Options of a compiler command that does not link
+constexpr StringView NonLinkOptions[] = {
+		"-c", "-E", "-S", "-M", "-MM", "-fsyntax-only"
+	};
+
+constexpr StringView SourceExtensions[] = { ".c", ".cc", ".cpp", ".cxx", ".c++", ".cp", ".C" };
+
+/// <summary>Compile command recognized by the launcher.</summary>
+struct CompileJob
+{
+	String 		compiler; 		// file name, looked up on the PATH of the worker
+	String 		language; 		// "c" or "c++"
+	String 		output;
+	Vec<String> preprocess; 	// command that writes the preprocessed source to the standard output
+	Vec<String> compile; 		// options of the worker's compile command (without input and output)
+};
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto encodeFields(Vec<String> const& fields_) -> String;
+static auto decodeFields(StringView payload_) -> Vec<String>;
+static auto isSupportedCompiler(StringView name_) -> bool;
+static auto isAllowedOption(StringView option_) -> bool;
+static auto isTargetName(StringView value_) -> bool;
+static auto equalInConstantTime(StringView received_, StringView expected_) -> bool;
+static auto resolveExecutable(StringView name_) -> Path;
+static auto analyzeCommand(Vec<String> const& command_) -> Opt<CompileJob>;
+static auto compileRemotely(CompileJob const& job_, Vec<String> const& workers_) -> Opt<int>;
+static auto isLinkCommand(Vec<String> const& command_) -> bool;
+static auto runLocally(Vec<String> const& command_) -> int;
+static auto runLocallyAndWait(Vec<String> const& command_) -> int;
+static auto runJob(int conn_, StringView token_) -> int;
+static auto runProcess(Vec<String> const& command_, Path const& workingDirectory_, String& stdOut_, String& stdErr_) -> int;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto probeWorkers(Vec<String> const& addresses_) -> Vec<WorkerInfo>
+{
+	auto found = Vec<Opt<WorkerInfo>>(addresses_.size());
+
+	parallelFor(addresses_.size(), [&](std::size_t i)
+		{
+			auto conn = FileDescriptor(net::connectTo(addresses_[i], ConnectTimeout));
+			if (conn.fd < 0)
+				return;
+
+			net::setReceiveTimeout(conn.fd, ConnectTimeout);
+
+			auto greeting 	= net::readFrame(conn.fd, MaxHeaderSize);
+			auto fields 	= greeting ? decodeFields(*greeting) : Vec<String>();
+			if (fields.size() < 4 || fields[0] != ProtocolName || fields[1] != ProtocolVersion)
+				return;
+
+			found[i] = WorkerInfo{ addresses_[i], std::max(1, convertTo<int>(fields[3]).value_or(1)), fields[2] != "ready" };
+		});
+
+	auto result = Vec<WorkerInfo>();
+	for (auto& worker : found)
+	{
+		if (worker)
+			result.push_back(std::move(*worker));
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+auto runLauncher(ProgramArgs const& args_) -> int
+{
+	if (args_.size() < 3)
+	{
+		fmt::printErr(fmt::fg(fmt::color::red), "Usage: pacc {} <compiler> [compiler arguments]\n", LauncherAction);
+		return 1;
+	}
+
+	auto command = Vec<String>(args_.begin() + 2, args_.end());
+
+	auto workers = Vec<String>();
+	if (auto list = std::getenv(String(WorkersVariable).c_str()))
+	{
+		for (auto rest = StringView(list); !rest.empty(); )
+		{
+			auto end = rest.find(';');
+			if (auto address = rest.substr(0, end); !address.empty())
+				workers.emplace_back(address);
+
+			rest.remove_prefix(end == StringView::npos ? rest.size() : end + 1);
+		}
+	}
+
+	if (!workers.empty())
+	{
+		if (auto job = analyzeCommand(command))
+		{
+			if (auto exitCode = compileRemotely(*job, workers))
+				return *exitCode;
+		}
+	}
+
+	// Links that run at the same time could run out of memory, wait for a slot
+	if (isLinkCommand(command))
+	{
+		if (auto linkPool = JobServer::joinPool(LinkPoolVariable))
+		{
+			auto slot = linkPool->acquire();
+			return runLocallyAndWait(command);
+		}
+	}
+
+	return runLocally(command);
+}
+
+///////////////////////////////////////////////////
+void useToken(StringView token_)
+{
+	if (!token_.empty())
+		::setenv(String(TokenVariable).c_str(), String(token_).c_str(), 1);
+}
+
+///////////////////////////////////////////////////
+void serveWorker(StringView address_, int slots_, StringView token_)
+{
+	// Anyone who can connect runs the compiler
+	if (token_.empty() && !net::isLocalAddress(address_))
+	{
+		throw PaccException("A worker listening on \"{}\" requires a token.", address_)
+			.withHelp("Set the same \"workerToken\" in settings.json on the worker and the building machines (or {}), "
+				"or listen on a loopback address or a Unix socket.", TokenVariable);
+	}
+
+	auto listener = FileDescriptor(net::listenOn(address_));
+
+	// Disconnected clients must not terminate the worker
+	::signal(SIGPIPE, SIG_IGN);
+
+	fmt::print("pacc worker listening on \"{}\" with {} slots (stop with Ctrl+C)\n", address_, slots_);
+	std::fflush(stdout);
+
+	auto numRunning = 0;
+	while (true)
+	{
+		auto fds = pollfd{ listener.fd, POLLIN, 0 };
+
+		// Finished jobs are collected at least every 200 ms
+		if (::poll(&fds, 1, numRunning > 0 ? 200 : -1) < 0 && errno != EINTR)
+			throw PaccException("pacc worker: poll failed ({}).", std::strerror(errno));
+
+		while (numRunning > 0 && ::waitpid(-1, nullptr, WNOHANG) > 0)
+			--numRunning;
+
+		if (!(fds.revents & POLLIN))
+			continue;
+
+		auto conn = FileDescriptor(::accept4(listener.fd, nullptr, nullptr, SOCK_CLOEXEC));
+		if (conn.fd < 0)
+			continue;
+
+		// A busy worker is skipped by the launcher, which tries the next one
+		auto ready 		= (numRunning < slots_);
+		auto greeting 	= encodeFields({ String(ProtocolName), String(ProtocolVersion), ready ? "ready" : "busy", std::to_string(slots_) });
+		if (!net::writeFrame(conn.fd, greeting) || !ready)
+			continue;
+
+		std::fflush(nullptr);
+
+		// Each job in its own process, so that a crash affects only that job
+		auto pid = ::fork();
+		if (pid == 0)
+		{
+			listener.close();
+			::_exit(runJob(conn.fd, token_));
+		}
+
+		if (pid > 0)
+			++numRunning;
+	}
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static auto encodeFields(Vec<String> const& fields_) -> String
+{
+	auto payload = String();
+	for (auto const& field : fields_)
+	{
+		payload += field;
+		payload.push_back('\0');
+	}
+	return payload;
+}
+
+///////////////////////////////////////////////////
+static auto decodeFields(StringView payload_) -> Vec<String>
+{
+	auto fields = Vec<String>();
+	while (!payload_.empty())
+	{
+		auto end = payload_.find('\0');
+		if (end == StringView::npos)
+			break;
+
+		fields.emplace_back(payload_.substr(0, end));
+		payload_.remove_prefix(end + 1);
+	}
+	return fields;
+}
+
+///////////////////////////////////////////////////
+/// <summary>GCC and Clang drivers, optionally with a target prefix and a version suffix (f.e. "x86_64-linux-gnu-g++-12").</summary>
+static auto isSupportedCompiler(StringView name_) -> bool
+{
+	static auto const Pattern = std::regex(R"(^([A-Za-z0-9_.]+-)*(gcc|g\+\+|cc|c\+\+|clang|clang\+\+)(-[0-9][0-9.]*)?$)");
+
+	return std::regex_match(name_.begin(), name_.end(), Pattern);
+}
+
+///////////////////////////////////////////////////
+/// <summary>Code generation, language, warning, optimization and debug information options, the only ones workers accept.</summary>
+static auto isAllowedOption(StringView option_) -> bool
+{
+	static auto const Pattern = std::regex(
+			"-O([0-3sgz]|fast)?"
+			"|-g([0-3]|gdb[0-3]?|dwarf(-[2-5])?|line-tables-only|column-info|no-column-info)?"
+			"|-W(no-)?[A-Za-z0-9][A-Za-z0-9_+=.-]*" 	// not "-Wa,", "-Wl,", "-Wp,"
+			"|-w|-pedantic|-pedantic-errors|-ansi|-pthread|-pipe"
+			"|-std=[A-Za-z0-9+]+"
+			"|--target=[A-Za-z0-9_.-]+"
+			"|--param=[A-Za-z0-9_-]+=[0-9]+"
+			"|-m(?!llvm$)[A-Za-z0-9][A-Za-z0-9_=.,+-]*"
+			"|-f(debug|file|macro)-prefix-map=[^=]*=[^=]*"
+			"|-f(no-)?("
+				"PIC|pic|PIE|pie|exceptions|rtti|non-call-exceptions|asynchronous-unwind-tables|unwind-tables"
+				"|threadsafe-statics|common|plt|semantic-interposition|ident|gnu-unique|builtin|builtin-[a-z0-9_]+"
+				"|signed-char|unsigned-char|short-enums|char8_t|permissive|ms-extensions|declspec|operator-names"
+				"|elide-constructors|implicit-templates|implicit-inline-templates|gnu-keywords|gnu89-inline|concepts|coroutines"
+				"|strict-aliasing|strict-overflow|wrapv|trapv|delete-null-pointer-checks|omit-frame-pointer|optimize-sibling-calls"
+				"|inline|inline-functions|inline-small-functions|unroll-loops|unroll-all-loops|tree-vectorize|vectorize|slp-vectorize"
+				"|lto|lto=[a-z0-9]+|fat-lto-objects|data-sections|function-sections|merge-constants|merge-all-constants"
+				"|stack-protector|stack-protector-strong|stack-protector-all|stack-protector-explicit|stack-clash-protection"
+				"|cf-protection(=[a-z]+)?|fast-math|math-errno|finite-math-only|signed-zeros|trapping-math|rounding-math"
+				"|reciprocal-math|associative-math|fp-contract=[a-z]+|excess-precision=[a-z]+|openmp|openmp-simd"
+				"|sanitize=[a-z0-9,_-]+|sanitize-recover(=[a-z0-9,_-]+)?|sanitize-address-use-after-scope"
+				"|visibility=[a-z]+|visibility-inlines-hidden|trivial-auto-var-init=[a-z]+|zero-initialized-in-bss"
+				"|var-tracking|var-tracking-assignments|debug-types-section|standalone-debug|limit-debug-info"
+				"|diagnostics-color(=[a-z]+)?|color-diagnostics|ansi-escape-codes|diagnostics-show-option|diagnostics-show-caret"
+				"|show-column|message-length=[0-9]+|max-errors=[0-9]+|error-limit=[0-9]+|template-depth=[0-9]+"
+				"|template-backtrace-limit=[0-9]+|constexpr-depth=[0-9]+|constexpr-steps=[0-9]+|constexpr-ops-limit=[0-9]+"
+				"|constexpr-loop-limit=[0-9]+"
+			")"
+		);
+
+	return std::regex_match(option_.begin(), option_.end(), Pattern);
+}
+
+///////////////////////////////////////////////////
+/// <summary>Value of "-target" and "-arch" (f.e. "x86_64-linux-gnu").</summary>
+static auto isTargetName(StringView value_) -> bool
+{
+	return !value_.empty() && rg::all_of(value_, [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '-'; });
+}
+
+///////////////////////////////////////////////////
+/// <summary>Compares the tokens in a time that does not reveal where they differ.</summary>
+static auto equalInConstantTime(StringView received_, StringView expected_) -> bool
+{
+	auto difference = std::size_t(received_.size() != expected_.size());
+	for (std::size_t i = 0; i < expected_.size(); ++i)
+		difference |= std::size_t(expected_[i] ^ (i < received_.size() ? received_[i] : 0));
+
+	return difference == 0;
+}
+
+///////////////////////////////////////////////////
+static auto resolveExecutable(StringView name_) -> Path
+{
+	if (name_.find('/') != StringView::npos)
+		return ::access(String(name_).c_str(), X_OK) == 0 ? Path(name_) : Path();
+
+	auto pathVar = std::getenv("PATH");
+	for (auto rest = StringView(pathVar ? pathVar : ""); !rest.empty(); )
+	{
+		auto end 	= rest.find(':');
+		auto folder = rest.substr(0, end);
+		rest.remove_prefix(end == StringView::npos ? rest.size() : end + 1);
+
+		auto candidate = Path(folder.empty() ? "." : folder) / name_;
+		if (::access(candidate.c_str(), X_OK) == 0)
+			return candidate;
+	}
+
+	return {};
+}
+
+///////////////////////////////////////////////////
+static auto analyzeCommand(Vec<String> const& command_) -> Opt<CompileJob>
+{
+	auto isOneOf = [](auto const& list_, StringView arg_) {
+			return rg::find(list_, arg_) != std::end(list_);
+		};
+	auto startsWithOneOf = [](auto const& list_, StringView arg_) {
+			return rg::any_of(list_, [&](StringView prefix_) { return arg_.starts_with(prefix_); });
+		};
+
+	auto job = CompileJob();
+	job.compiler = Path(command_.front()).filename().string();
+
+	if (!isSupportedCompiler(job.compiler))
+		return std::nullopt;
+
+	job.preprocess.push_back(command_.front());
+
+	auto source 		= Opt<String>();
+	auto compileOnly 	= false;
+	auto depFile 		= false; 	// -MD, -MMD
+	auto depFileName 	= false; 	// -MF
+	auto depTarget 		= false; 	// -MT, -MQ
+
+	for (std::size_t i = 1; i < command_.size(); ++i)
+	{
+		auto const& arg = command_[i];
+
+		auto value = [&]() -> String const* {
+				return (i + 1 < command_.size()) ? &command_[++i] : nullptr;
+			};
+
+		if (arg == "-c")
+		{
+			compileOnly = true;
+		}
+		else if (arg.starts_with("-o"))
+		{
+			auto output = (arg == "-o") ? value() : &arg;
+			if (!output)
+				return std::nullopt;
+
+			job.output = (arg == "-o") ? *output : arg.substr(2);
+		}
+		else if (isOneOf(LocalOnlyOptions, arg) || startsWithOneOf(LocalOnlyPrefixes, arg) || arg.starts_with('@'))
+		{
+			return std::nullopt;
+		}
+		else if (isOneOf(PreprocessorOptionsWithValue, arg))
+		{
+			auto optionValue = value();
+			if (!optionValue)
+				return std::nullopt;
+
+			// Precompiled headers are local, the placeholder header of gmake2 is empty
+			if (arg == "-include" && (fs::exists(*optionValue + ".gch") || fs::exists(*optionValue + ".pch")))
+				return std::nullopt;
+
+			depFileName = depFileName || (arg == "-MF");
+			depTarget 	= depTarget || (arg == "-MT" || arg == "-MQ");
+
+			job.preprocess.push_back(arg);
+			job.preprocess.push_back(*optionValue);
+		}
+		else if (isOneOf(PreprocessorFlags, arg) || startsWithOneOf(PreprocessorPrefixes, arg))
+		{
+			depFile 	= depFile || (arg == "-MD" || arg == "-MMD");
+			depFileName = depFileName || arg.starts_with("-MF");
+			depTarget 	= depTarget || arg.starts_with("-MT") || arg.starts_with("-MQ");
+
+			job.preprocess.push_back(arg);
+		}
+		else if (isOneOf(OptionsWithValue, arg))
+		{
+			auto optionValue = value();
+			if (!optionValue || !isTargetName(*optionValue))
+				return std::nullopt;
+
+			for (auto* args : { &job.preprocess, &job.compile })
+			{
+				args->push_back(arg);
+				args->push_back(*optionValue);
+			}
+		}
+		else if (arg.starts_with('-'))
+		{
+			// Refused by the workers
+			if (!isAllowedOption(arg))
+				return std::nullopt;
+
+			// Also affects preprocessing, f.e. -std, -O2 (defines __OPTIMIZE__), -m64, -fPIC
+			job.preprocess.push_back(arg);
+			job.compile.push_back(arg);
+		}
+		else
+		{
+			// Exactly one source file, anything else (f.e. object files) means linking
+			if (source || !isOneOf(SourceExtensions, Path(arg).extension().string()))
+				return std::nullopt;
+
+			source = arg;
+		}
+	}
+
+	if (!compileOnly || !source || job.output.empty())
+		return std::nullopt;
+
+	// C++ drivers compile .c files as C++
+	auto isC 	= (Path(*source).extension() == ".c" && job.compiler.find("++") == String::npos);
+	job.language = isC ? "c" : "c++";
+
+	// Dependency file written while preprocessing, the same as the compiler would write it
+	if (depFile)
+	{
+		if (!depFileName)
+			job.preprocess.insert(job.preprocess.end(), { "-MF", Path(job.output).replace_extension(".d").string() });
+		if (!depTarget)
+			job.preprocess.insert(job.preprocess.end(), { "-MQ", job.output });
+	}
+
+	job.preprocess.insert(job.preprocess.end(), { "-E", *source });
+
+	return job;
+}
+
+///////////////////////////////////////////////////
+/// <returns>The exit code of the compiler, nullopt if no worker could compile it.</returns>
+static auto compileRemotely(CompileJob const& job_, Vec<String> const& workers_) -> Opt<int>
+{
+	auto compiler = resolveExecutable(job_.preprocess.front());
+	if (compiler.empty())
+		return std::nullopt;
+
+	auto preprocessCommand = job_.preprocess;
+	preprocessCommand.front() = compiler.string();
+
+	auto source = String();
+	auto errors = String();
+	auto exitCode = runProcess(preprocessCommand, "", source, errors);
+
+	// Preprocessor diagnostics are reported here, the worker reports only the compiler ones
+	std::fwrite(errors.data(), 1, errors.size(), stderr);
+	if (exitCode != 0)
+		return exitCode;
+
+	auto token = std::getenv(String(TokenVariable).c_str());
+
+	auto ec 		= std::error_code{};
+	auto request 	= Vec<String>{ job_.compiler, job_.language, fs::current_path(ec).string(), token ? token : "" };
+	request.insert(request.end(), job_.compile.begin(), job_.compile.end());
+
+	auto header = encodeFields(request);
+
+	// Every job starts at a different worker, so that they are spread evenly
+	auto first = std::size_t(::getpid()) % workers_.size();
+	for (std::size_t n = 0; n < workers_.size(); ++n)
+	{
+		auto const& address = workers_[(first + n) % workers_.size()];
+
+		auto conn = FileDescriptor(net::connectTo(address, ConnectTimeout));
+		if (conn.fd < 0)
+			continue;
+
+		auto greeting 	= net::readFrame(conn.fd, MaxHeaderSize);
+		auto fields 	= greeting ? decodeFields(*greeting) : Vec<String>();
+		if (fields.size() < 3 || fields[0] != ProtocolName || fields[1] != ProtocolVersion || fields[2] != "ready")
+			continue;
+
+		if (!net::writeFrame(conn.fd, header) || !net::writeFrame(conn.fd, source))
+			continue;
+
+		// Status, compiler output and the object file
+		auto status 	= net::readFrame(conn.fd, MaxHeaderSize);
+		auto stdOut 	= status ? net::readFrame(conn.fd, MaxFileSize) : std::nullopt;
+		auto stdErr 	= stdOut ? net::readFrame(conn.fd, MaxFileSize) : std::nullopt;
+		auto object 	= stdErr ? net::readFrame(conn.fd, MaxFileSize) : std::nullopt;
+		auto reply 		= object ? decodeFields(*status) : Vec<String>();
+		if (reply.size() < 3)
+			continue;
+
+		if (reply[0] != "done")
+		{
+			fmt::printErr(fmt::fg(fmt::color::yellow), "pacc: worker \"{}\" cannot compile \"{}\": {}\n", address, job_.output, reply[2]);
+			continue;
+		}
+
+		std::fwrite(stdOut->data(), 1, stdOut->size(), stdout);
+		std::fwrite(stdErr->data(), 1, stdErr->size(), stderr);
+
+		exitCode = convertTo<int>(reply[1]).value_or(1);
+		if (exitCode != 0)
+			return exitCode;
+
+		auto out = std::ofstream(job_.output, std::ios::binary);
+		if (!out.write(object->data(), std::streamsize(object->size())))
+		{
+			fmt::printErr(fmt::fg(fmt::color::red), "pacc: could not write \"{}\".\n", job_.output);
+			return 1;
+		}
+
+		return 0;
+	}
+
+	return std::nullopt;
+}
+
+///////////////////////////////////////////////////
+/// <summary>Command of a GCC or Clang driver that links (f.e. "g++ -o app main.o -lfoo").</summary>
+static auto isLinkCommand(Vec<String> const& command_) -> bool
+{
+	if (!isSupportedCompiler(Path(command_.front()).filename().string()))
+		return false;
+
+	return rg::none_of(command_.begin() + 1, command_.end(), [](String const& arg_) {
+			return rg::find(NonLinkOptions, StringView(arg_)) != std::end(NonLinkOptions);
+		});
+}
+
+///////////////////////////////////////////////////
+/// <summary>Replaces the launcher with the command.</summary>
+static auto runLocally(Vec<String> const& command_) -> int
+{
+	auto argv = Vec<char*>();
+	for (auto const& arg : command_)
+		argv.push_back(const_cast<char*>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	std::fflush(nullptr);
+	::execvp(argv.front(), argv.data());
+
+	fmt::printErr(fmt::fg(fmt::color::red), "pacc: could not run \"{}\" ({}).\n", command_.front(), std::strerror(errno));
+	return 127;
+}
+
+///////////////////////////////////////////////////
+/// <summary>Runs the command in a child process (the launcher holds a slot until it ends).</summary>
+static auto runLocallyAndWait(Vec<String> const& command_) -> int
+{
+	std::fflush(nullptr);
+
+	auto pid = ::fork();
+	if (pid < 0)
+	{
+		fmt::printErr(fmt::fg(fmt::color::red), "pacc: could not run \"{}\" ({}).\n", command_.front(), std::strerror(errno));
+		return 127;
+	}
+
+	if (pid == 0)
+		::_exit(runLocally(command_));
+
+	auto status = 0;
+	while (::waitpid(pid, &status, 0) < 0)
+	{
+		if (errno != EINTR)
+			return 127;
+	}
+
+	if (WIFSIGNALED(status))
+		return 128 + WTERMSIG(status);
+
+	return WEXITSTATUS(status);
+}
+
+///////////////////////////////////////////////////
+/// <summary>Compiles a job sent by the launcher (in the worker's child process).</summary>
+static auto runJob(int conn_, StringView token_) -> int
+{
+	auto reply = [&](StringView status_, int exitCode_, String const& message_, StringView stdOut_ = {}, StringView stdErr_ = {}, StringView object_ = {}) {
+			net::writeFrame(conn_, encodeFields({ String(status_), std::to_string(exitCode_), message_ }));
+			net::writeFrame(conn_, stdOut_);
+			net::writeFrame(conn_, stdErr_);
+			net::writeFrame(conn_, object_);
+			return (status_ == "done") ? 0 : 1;
+		};
+
+	net::setReceiveTimeout(conn_, RequestTimeout);
+
+	// Nothing is sent after a probe
+	auto header = net::readFrame(conn_, MaxHeaderSize);
+	auto source = header ? net::readFrame(conn_, MaxFileSize) : std::nullopt;
+	if (!source)
+		return 1;
+
+	auto fields = decodeFields(*header);
+	if (fields.size() < 4)
+		return reply("error", 1, "invalid request");
+
+	auto const& compiler = fields[0];
+	auto const& language = fields[1];
+	auto const& cwd 	 = fields[2];
+	auto const& token 	 = fields[3];
+
+	if (!token_.empty() && !equalInConstantTime(token, token_))
+		return reply("error", 1, "invalid token");
+
+	if (!isSupportedCompiler(compiler))
+		return reply("error", 1, fmt::format("compiler \"{}\" is not supported", compiler));
+
+	if (language != "c" && language != "c++")
+		return reply("error", 1, fmt::format("language \"{}\" is not supported", language));
+
+	auto compilerPath = resolveExecutable(compiler);
+	if (compilerPath.empty())
+		return reply("error", 1, fmt::format("compiler \"{}\" not found", compiler));
+
+	auto command = Vec<String>{ compilerPath.string() };
+	for (auto it = fields.begin() + 4; it != fields.end(); ++it)
+	{
+		auto withValue = rg::find(OptionsWithValue, StringView(*it)) != std::end(OptionsWithValue);
+		if (withValue && it + 1 != fields.end() && isTargetName(*(it + 1)))
+		{
+			command.push_back(*it);
+			command.push_back(*++it);
+			continue;
+		}
+
+		// Only options that change the object file, anything else could write or read other files (f.e. "-aux-info", "-Wa,...")
+		if (!isAllowedOption(*it))
+			return reply("error", 1, fmt::format("option \"{}\" is not allowed", *it));
+
+		command.push_back(*it);
+	}
+
+	auto ec 	= std::error_code{};
+	auto folder = fs::temp_directory_path(ec) / fmt::format("pacc-worker-{}", ::getpid());
+	fs::create_directories(folder, ec);
+
+	auto input = String(language == "c" ? "source.i" : "source.ii");
+	{
+		auto stream = std::ofstream(folder / input, std::ios::binary);
+		if (ec || !stream.write(source->data(), std::streamsize(source->size())))
+			return reply("error", 1, fmt::format("could not write to \"{}\"", folder.string()));
+	}
+
+	// Debug information refers to the working directory of the client
+	command.push_back(fmt::format("-fdebug-prefix-map={}={}", folder.string(), cwd));
+	command.insert(command.end(), { "-x", language == "c" ? "cpp-output" : "c++-cpp-output", "-c", input, "-o", "output.o" });
+
+	auto stdOut 	= String();
+	auto stdErr 	= String();
+	auto exitCode 	= runProcess(command, folder, stdOut, stdErr);
+
+	auto object = String();
+	if (exitCode == 0)
+	{
+		try {
+			object = readFileContents(folder / "output.o");
+		}
+		catch(...) {
+			exitCode = 1;
+			stdErr += "pacc worker: the compiler did not write the object file\n";
+		}
+	}
+
+	fs::remove_all(folder, ec);
+
+	return reply("done", exitCode, "", stdOut, stdErr, object);
+}
+
+///////////////////////////////////////////////////
+static auto runProcess(Vec<String> const& command_, Path const& workingDirectory_, String& stdOut_, String& stdErr_) -> int
+{
+	auto process = proc::Process(command_, workingDirectory_.string(),
+			[&](char const* bytes_, std::size_t n_) { stdOut_.append(bytes_, n_); },
+			[&](char const* bytes_, std::size_t n_) { stdErr_.append(bytes_, n_); }
+		);
+
+	return process.get_exit_status();
+}
+
+#else
+
+///////////////////////////////////////////////////
+auto probeWorkers(Vec<String> const& addresses_) -> Vec<WorkerInfo>
+{
+	return {};
+}
+
+///////////////////////////////////////////////////
+auto runLauncher(ProgramArgs const& args_) -> int
+{
+	fmt::printErr(fmt::fg(fmt::color::red), "pacc: distributed builds are supported only on Linux.\n");
+	return 1;
+}
+
+///////////////////////////////////////////////////
+void useToken(StringView token_)
+{
+}
+
+///////////////////////////////////////////////////
+void serveWorker(StringView address_, int slots_, StringView token_)
+{
+	throw PaccException("pacc worker is supported only on Linux.");
+}
+
+#endif
+
+}
@@ -0,0 +1,226 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Build/InputFingerprint.hpp>
+
+#include <Pacc/System/FileHasher.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/Hash.hpp>
+
+constexpr StringView FingerprintExtension = ".fingerprint";
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static void addConfiguration(Fnv1a& hash_, Configuration const& config_);
+static auto fingerprintFileOf(Path const& artifact_) -> Path;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto InputFingerprint::compute(Package const& pkg_, Project const& project_, Toolchain const& toolchain_, BuildSettings const& settings_,
+	FileHasher& hasher_, Vec<InputFingerprint> const& dependencies_) -> InputFingerprint
+{
+	auto result = InputFingerprint();
+
+	// Everything that changes the compiler and linker invocations
+	{
+		auto hash = Fnv1a();
+		hash.add(settings_.configName);
+		hash.add(settings_.platformName);
+
+		auto toolchain = json::object();
+		toolchain_.serialize(toolchain);
+		hash.add(toolchain.dump());
+
+		hash.add(static_cast<uint64_t>(project_.type));
+		hash.add(project_.language);
+		hash.add(project_.symbolVisibility.toString());
+		hash.add(project_.moduleDefinitionFile);
+
+		if (auto const& pch = project_.pch)
+		{
+			hash.add(pch->header);
+			hash.add(pch->source);
+			hash.add(pch->definition);
+			hash.add(uint64_t(pch->automatic));
+		}
+
+		if (auto const& unity = project_.unity)
+		{
+			hash.add(uint64_t(unity->enabled));
+			hash.add(uint64_t(unity->batchSize));
+			for (auto const& pattern : unity->exclude)
+				hash.add(pattern);
+		}
+
+		addConfiguration(hash, project_);
+		for (auto const& [filter, config] : project_.premakeFilters)
+		{
+			hash.add(filter);
+			addConfiguration(hash, config);
+		}
+
+		result.configuration = hash.hex();
+	}
+
+	// Contents of the project files and its headers
+	{
+		auto root = fsx::fwd(pkg_.rootFolder());
+
+		auto patterns = Vec<String>();
+		for (auto const& file : project_.files)
+			patterns.push_back(fsx::fwd(pkg_.resolvePath(file)).string());
+
+		for (auto const& [filter, config] : project_.premakeFilters)
+		{
+			for (auto const& file : config.files)
+				patterns.push_back(fsx::fwd(pkg_.resolvePath(file)).string());
+		}
+
+		for (auto const* folders : { &project_.includeFolders.self.public_, &project_.includeFolders.self.private_, &project_.includeFolders.self.interface_ })
+		{
+			for (auto const& folder : *folders)
+				patterns.push_back(fsx::fwd(pkg_.resolvePath(folder)).string() + "/**");
+		}
+
+		auto files = Vec<Path>();
+		for (auto const& pattern : patterns)
+		{
+			auto matched = fsx::glob(pattern);
+			files.insert(files.end(), std::make_move_iterator(matched.begin()), std::make_move_iterator(matched.end()));
+		}
+
+		rg::sort(files);
+		files.erase(std::unique(files.begin(), files.end()), files.end());
+
+		auto hashes = hasher_.hashAll(files);
+
+		auto hash = Fnv1a();
+		for (std::size_t i = 0; i < files.size(); ++i)
+		{
+			auto contents = hashes[i].value_or(Hash128{});
+
+			// Relative, so moving the package does not change the fingerprint
+			hash.add(fsx::fwd(files[i].lexically_relative(root)).string());
+			hash.add(contents.low);
+			hash.add(contents.high);
+		}
+
+		// Headers of the dependencies are included too, and their libraries are linked in
+		hash.add(uint64_t(dependencies_.size()));
+		for (auto const& dep : dependencies_)
+		{
+			hash.add(dep.configuration);
+			hash.add(dep.sources);
+		}
+
+		result.sources = hash.hex();
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+auto InputFingerprint::load(Path const& artifact_) -> Opt<InputFingerprint>
+{
+	auto in = std::ifstream(fingerprintFileOf(artifact_));
+	if (!in.is_open())
+		return std::nullopt;
+
+	auto result = InputFingerprint();
+	if (!std::getline(in, result.configuration) || !std::getline(in, result.sources))
+		return std::nullopt;
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+void InputFingerprint::save(Path const& artifact_) const
+{
+	std::ofstream(fingerprintFileOf(artifact_), std::ios::binary) << configuration << '\n' << sources << '\n';
+}
+
+
+///////////////////////////////////////////////////
+InputFingerprints::InputFingerprints(Toolchain const& toolchain_, BuildSettings const& settings_)
+	: toolchain(toolchain_), settings(settings_)
+{
+}
+
+///////////////////////////////////////////////////
+auto InputFingerprints::of(Package const& pkg_, Project const& project_) -> InputFingerprint const&
+{
+	if (auto it = computed.find(&project_); it != computed.end())
+		return it->second;
+
+	auto dependencies = Vec<InputFingerprint>();
+	for (auto const* deps : { &project_.dependencies.self.private_, &project_.dependencies.self.public_, &project_.dependencies.self.interface_ })
+	{
+		for (auto const& dep : *deps)
+		{
+			if (dep.isPackage())
+			{
+				auto const& pkgDep = dep.package();
+				if (!pkgDep.package)
+					continue;
+
+				for (auto const& name : pkgDep.projects)
+				{
+					if (auto p = pkgDep.package->findProject(name))
+						dependencies.push_back(this->of(*pkgDep.package, *p));
+				}
+			}
+			else if (dep.isSelf())
+			{
+				auto const& self = dep.self();
+				if (auto p = self.package->findProject(self.depProjName))
+					dependencies.push_back(this->of(*self.package, *p));
+			}
+		}
+	}
+
+	auto fingerprint = InputFingerprint::compute(pkg_, project_, toolchain, settings, hasher, dependencies);
+	return computed[&project_] = std::move(fingerprint);
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static void addConfiguration(Fnv1a& hash_, Configuration const& config_)
+{
+	auto addAccesses = [&](VecOfStrAcc const& values_) {
+			for (auto const* values : { &values_.private_, &values_.public_, &values_.interface_ })
+			{
+				hash_.add(uint64_t(values->size()));
+				for (auto const& value : *values)
+					hash_.add(value);
+			}
+		};
+
+	auto addStrings = [&](auto const& strings_) {
+			addAccesses(strings_.self);
+			addAccesses(flattenAccesses(strings_.computed));
+		};
+
+	addStrings(config_.defines);
+	addStrings(config_.includeFolders);
+	addStrings(config_.linkerFolders);
+	addStrings(config_.linkedLibraries);
+	addStrings(config_.compilerOptions);
+	addStrings(config_.linkerOptions);
+}
+
+///////////////////////////////////////////////////
+static auto fingerprintFileOf(Path const& artifact_) -> Path
+{
+	auto path = artifact_;
+	path += FingerprintExtension;
+	return path;
+}
@@ -0,0 +1,322 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Build/JobServer.hpp>
+
+#include <Pacc/Helpers/String.hpp>
+
+#ifndef PACC_SYSTEM_WINDOWS
+	#include <unistd.h>
+	#include <fcntl.h>
+	#include <sys/stat.h>
+#endif
+
+#include <cstdlib>
+#include <random>
+
+constexpr StringView FifoAuthPrefix = "--jobserver-auth=fifo:";
+
+static JobServer* activeServer = nullptr;
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto jobsInMakeFlags(StringView makeFlags_) -> int;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+JobServer::Slot::Slot(Slot&& other_) noexcept
+	: server(std::exchange(other_.server, nullptr))
+	, implicit(other_.implicit)
+	, token(other_.token)
+{
+}
+
+///////////////////////////////////////////////////
+auto JobServer::Slot::operator=(Slot&& other_) noexcept -> Slot&
+{
+	if (this != &other_)
+	{
+		if (server)
+			server->release(*this);
+
+		server 		= std::exchange(other_.server, nullptr);
+		implicit 	= other_.implicit;
+		token 		= other_.token;
+	}
+	return *this;
+}
+
+///////////////////////////////////////////////////
+JobServer::Slot::~Slot()
+{
+	if (server)
+		server->release(*this);
+}
+
+///////////////////////////////////////////////////
+auto JobServer::active() -> JobServer*
+{
+	return activeServer;
+}
+
+#ifndef PACC_SYSTEM_WINDOWS
+
+///////////////////////////////////////////////////
+auto JobServer::create(int jobs_) -> UPtr<JobServer>
+{
+	// The first job of every build is the slot held by pacc
+	auto server = createFifo("MAKEFLAGS", jobs_, jobs_ - 1);
+	if (!server)
+		return nullptr;
+
+	// A jobserver inherited from a parent make is replaced, as make does for "-j" in a sub-make
+	auto makeFlags = fmt::format("-j{} {}{}", jobs_, FifoAuthPrefix, server->fifo.string());
+	::setenv("MAKEFLAGS", makeFlags.c_str(), 1);
+
+	activeServer = server.get();
+	return server;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::join() -> UPtr<JobServer>
+{
+	auto makeFlags = std::getenv("MAKEFLAGS");
+	if (!makeFlags)
+		return nullptr;
+
+	// Pipe jobservers ("--jobserver-auth=R,W") are not supported, their descriptors are not passed to builds
+	auto flags = StringView(makeFlags);
+	auto start = flags.rfind(FifoAuthPrefix);
+	if (start == StringView::npos)
+		return nullptr;
+
+	auto path = flags.substr(start + FifoAuthPrefix.size());
+
+	auto server = openFifo(path.substr(0, path.find(' ')));
+	if (!server)
+		return nullptr;
+
+	server->numJobs = jobsInMakeFlags(flags);
+
+	activeServer = server.get();
+	return server;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::createPool(int jobs_, StringView variable_) -> UPtr<JobServer>
+{
+	auto server = createFifo(variable_, jobs_, jobs_);
+	if (!server)
+		return nullptr;
+
+	// Every slot is a token, the process that runs the job does not hold one
+	server->implicitTaken = true;
+
+	::setenv(server->variable.c_str(), server->fifo.c_str(), 1);
+	return server;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::joinPool(StringView variable_) -> UPtr<JobServer>
+{
+	auto path = std::getenv(String(variable_).c_str());
+	if (!path || !*path)
+		return nullptr;
+
+	auto server = openFifo(path);
+	if (server)
+		server->implicitTaken = true;
+
+	return server;
+}
+
+///////////////////////////////////////////////////
+JobServer::~JobServer()
+{
+	if (activeServer == this)
+		activeServer = nullptr;
+
+	if (fd >= 0)
+		::close(fd);
+
+	if (!owned)
+		return;
+
+	if (prevValue)
+		::setenv(variable.c_str(), prevValue->c_str(), 1);
+	else
+		::unsetenv(variable.c_str());
+
+	auto ec = std::error_code{};
+	fs::remove(fifo, ec);
+}
+
+///////////////////////////////////////////////////
+auto JobServer::acquire() -> Slot
+{
+	auto slot = Slot();
+	slot.server = this;
+
+	{
+		auto lock = std::lock_guard(mutex);
+		if (!implicitTaken)
+		{
+			implicitTaken = true;
+			slot.implicit = true;
+			return slot;
+		}
+	}
+
+	// Blocks until a build gives a token back
+	while (true)
+	{
+		auto numRead = ::read(fd, &slot.token, 1);
+		if (numRead == 1)
+			return slot;
+
+		if (numRead < 0 && errno == EINTR)
+			continue;
+
+		// Broken jobserver, run without a slot rather than not at all
+		slot.server = nullptr;
+		return slot;
+	}
+}
+
+///////////////////////////////////////////////////
+void JobServer::release(Slot& slot_)
+{
+	slot_.server = nullptr;
+
+	if (slot_.implicit)
+	{
+		auto lock = std::lock_guard(mutex);
+		implicitTaken = false;
+		return;
+	}
+
+	while (::write(fd, &slot_.token, 1) < 0 && errno == EINTR) {}
+}
+
+///////////////////////////////////////////////////
+/// <summary>Creates the named pipe with <c>tokens_</c> tokens in it.</summary>
+auto JobServer::createFifo(StringView variable_, int jobs_, int tokens_) -> UPtr<JobServer>
+{
+	if (jobs_ < 1)
+		return nullptr;
+
+	auto server = UPtr<JobServer>(new JobServer());
+	server->variable = String(variable_);
+
+	// Restored by the destructor, also when the creation fails below
+	if (auto value = std::getenv(server->variable.c_str()))
+		server->prevValue = String(value);
+
+	auto ec = std::error_code{};
+	server->fifo = fs::temp_directory_path(ec) / fmt::format("pacc-jobserver-{}-{:08x}", ::getpid(), std::random_device{}());
+
+	if (ec || ::mkfifo(server->fifo.c_str(), S_IRUSR | S_IWUSR) != 0)
+		return nullptr;
+
+	server->owned 	= true;
+	server->numJobs = jobs_;
+
+	// Read and write, so that opening does not wait for the other end
+	server->fd = ::open(server->fifo.c_str(), O_RDWR | O_CLOEXEC);
+	if (server->fd < 0)
+		return nullptr;
+
+	auto tokens = String(std::size_t(tokens_), '+');
+	if (::write(server->fd, tokens.data(), tokens.size()) != ssize_t(tokens.size()))
+		return nullptr;
+
+	return server;
+}
+
+///////////////////////////////////////////////////
+/// <summary>Opens the named pipe of a jobserver created by another process.</summary>
+auto JobServer::openFifo(StringView path_) -> UPtr<JobServer>
+{
+	auto server = UPtr<JobServer>(new JobServer());
+	server->fifo = Path(path_);
+
+	server->fd = ::open(server->fifo.c_str(), O_RDWR | O_CLOEXEC);
+	if (server->fd < 0)
+		return nullptr;
+
+	return server;
+}
+
+#else
+
+///////////////////////////////////////////////////
+auto JobServer::create(int jobs_) -> UPtr<JobServer>
+{
+	return nullptr;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::join() -> UPtr<JobServer>
+{
+	return nullptr;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::createPool(int jobs_, StringView variable_) -> UPtr<JobServer>
+{
+	return nullptr;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::joinPool(StringView variable_) -> UPtr<JobServer>
+{
+	return nullptr;
+}
+
+///////////////////////////////////////////////////
+JobServer::~JobServer()
+{
+	if (activeServer == this)
+		activeServer = nullptr;
+}
+
+///////////////////////////////////////////////////
+auto JobServer::acquire() -> Slot
+{
+	return Slot();
+}
+
+///////////////////////////////////////////////////
+void JobServer::release(Slot& slot_)
+{
+	slot_.server = nullptr;
+}
+
+#endif
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+/// <summary>Value of "-j" in MAKEFLAGS (f.e. " -j8 --jobserver-auth=fifo:/tmp/GMfifo1"), 0 if not found.</summary>
+static auto jobsInMakeFlags(StringView makeFlags_) -> int
+{
+	for (auto pos = makeFlags_.find("-j"); pos != StringView::npos; pos = makeFlags_.find("-j", pos + 2))
+	{
+		// Not a part of another flag (f.e. "--jobserver-auth")
+		if (pos > 0 && makeFlags_[pos - 1] != ' ')
+			continue;
+
+		auto end = makeFlags_.find(' ', pos);
+		if (auto jobs = convertTo<int>(String(makeFlags_.substr(pos + 2, end == StringView::npos ? end : end - pos - 2))))
+			return *jobs;
+	}
+	return 0;
+}
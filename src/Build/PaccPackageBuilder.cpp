@@ -15,11 +15,14 @@ auto PaccPackageBuilder::run(
 		int						verbosityLevel
 	) -> BuildProcessResult
 {
-	// Generate premake5 files
-	app->createPremake5Generator().generate(package);
+	if (settings.regenerateProjectFiles)
+	{
+		// Generate premake5 files
+		app->createPremake5Generator().generate(package);
 
-	// Run premake:
-	app->runPremakeGeneration(toolchain.premakeToolchainType());
+		// Run premake:
+		app->runPremakeGeneration(toolchain.premakeToolchainType());
+	}
 
 	// TODO: build should be implemented here, instead of in the toolchain
 	return toolchain.run(package, settings, verbosityLevel);
@@ -5,6 +5,7 @@
 #include <Pacc/System/Filesystem.hpp>
 #include <Pacc/System/Environment.hpp>
 #include <Pacc/App/App.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 
 
 using DepQueue		= BuildQueueBuilder::DepQueue;
@@ -13,10 +14,12 @@ using DepQueueStep	= BuildQueueBuilder::DepQueueStep;
 ///////////////////////////////////////////////////////////////
 // Private functions (forward declaration)
 ///////////////////////////////////////////////////////////////
-bool wasDependencyQueued(Dependency const& dep, DepQueue const& readyQueue_);
-bool projectHasPendingDependencies(Project const& project, DepQueue const& readyQueue_);
-bool packageHasPendingDependencies(PackageDependency & dep, DepQueue const& readyQueue_);
-bool selfPackageHasPendingDependencies(SelfDependency & dep, DepQueue const& readyQueue_);
+using QueuedDeps = USet<Dependency const*>;
+
+bool wasDependencyQueued(Dependency const& dep, QueuedDeps const& queued_);
+bool projectHasPendingDependencies(Project const& project, QueuedDeps const& queued_);
+bool packageHasPendingDependencies(PackageDependency & dep, QueuedDeps const& queued_);
+bool selfPackageHasPendingDependencies(SelfDependency & dep, QueuedDeps const& queued_);
 
 
 ///////////////////////////////////////////////////////////////
@@ -25,6 +28,8 @@ bool selfPackageHasPendingDependencies(SelfDependency & dep, DepQueue const& rea
 
 void BuildQueueBuilder::performConfigurationMerging()
 {
+	auto span = tracing::Span("performConfigurationMerging", "planning");
+
 	auto const& q = this->getQueue();
 
 	// fmt::print("Configuration steps: {}\n", q.size());
@@ -73,6 +78,9 @@ void BuildQueueBuilder::performConfigurationMerging()
 /////////////////////////////////////////////////
 void BuildQueueBuilder::recursiveLoad(Package & pkg_)
 {
+	auto span = tracing::Span("recursiveLoad", "planning");
+	span.arg("package", pkg_.name);
+
 	const std::array<AccessType, 3> methodsLoop = {
 			AccessType::Private,
 			AccessType::Public,
@@ -106,9 +114,8 @@ void BuildQueueBuilder::recursiveLoad(Package & pkg_)
 						auto& rawDep = dep.raw();
 						// fmt::print("Added raw dependency \"{}\"\n", rawDep);
 
-						auto& target = targetByAccessType(cfg->linkedLibraries.computed, dep.accessType);
 						// TODO: improve this:
-						target.push_back( rawDep );
+						cfg->linkedLibraries.addComputed(dep.accessType, rawDep);
 						break;
 					}
 					case Dependency::Self:
@@ -149,8 +156,12 @@ void BuildQueueBuilder::recursiveLoad(Package & pkg_)
 									throw; // Rethrow exception
 							}
 
-							if (this->isPackageLoaded(pkg->root))
-								continue; // ignore package, was loaded yet
+							// Package was loaded yet, share it:
+							if (auto loaded = this->findPackageByRoot(pkg->root))
+							{
+								pkgDep.package = std::move(loaded);
+								break;
+							}
 
 							// if (pkgDep.version.empty())
 							// 	fmt::print("Loaded dependency \"{}\"\n", pkgDep.packageName);
@@ -163,12 +174,9 @@ void BuildQueueBuilder::recursiveLoad(Package & pkg_)
 						// Assign loaded package:
 						pkgDep.package = pkgPtr;
 
-						// Insert in sorted order:
-						{
-							auto it = rg::upper_bound( loadedPackages, pkgPtr->root, {}, &Package::root );
+						packagesByRoot.emplace(packageKey(pkgPtr->root), pkgPtr);
+						loadedPackages.push_back(pkgPtr);
 
-							loadedPackages.insert(it, pkgPtr);
-						}
 						this->recursiveLoad(*pkgPtr);
 
 						break;
@@ -185,12 +193,14 @@ void BuildQueueBuilder::recursiveLoad(Package & pkg_)
 /////////////////////////////////////////////////
 DepQueue const& BuildQueueBuilder::setup()
 {
+	auto span = tracing::Span("setup", "planning");
+
 	std::size_t totalDeps 		= pendingDeps.size();
 	std::size_t totalCollected 	= 0;
 
 	while(totalCollected < totalDeps)
 	{
-		DepQueueStep step = this->collectReadyDependencies(queue, pendingDeps);
+		DepQueueStep step = this->collectReadyDependencies(pendingDeps);
 
 		// Could not collect any?
 		if (step.empty())
@@ -198,6 +208,9 @@ DepQueue const& BuildQueueBuilder::setup()
 
 		totalCollected += step.size();
 
+		for (auto const& dep : step)
+			queuedDeps.insert(dep.dep);
+
 		queue.push_back( std::move(step) );
 	}
 
@@ -205,7 +218,7 @@ DepQueue const& BuildQueueBuilder::setup()
 }
 
 /////////////////////////////////////////////////
-DepQueueStep BuildQueueBuilder::collectReadyDependencies(DepQueue const& ready_, PendingDeps & pending_)
+DepQueueStep BuildQueueBuilder::collectReadyDependencies(PendingDeps & pending_)
 {
 	PendingDeps newPending;
 	newPending.reserve(pending_.size());
@@ -217,11 +230,11 @@ DepQueueStep BuildQueueBuilder::collectReadyDependencies(DepQueue const& ready_,
 		bool ready = false;
 		if (dep.dep->isPackage())
 		{
-			ready = !packageHasPendingDependencies(dep.dep->package(), ready_);
+			ready = !packageHasPendingDependencies(dep.dep->package(), queuedDeps);
 		}
 		else if (dep.dep->isSelf())
 		{
-			ready = !selfPackageHasPendingDependencies(dep.dep->self(), ready_);
+			ready = !selfPackageHasPendingDependencies(dep.dep->self(), queuedDeps);
 		}
 
 		if (!ready)
@@ -235,21 +248,36 @@ DepQueueStep BuildQueueBuilder::collectReadyDependencies(DepQueue const& ready_,
 }
 
 /////////////////////////////////////////////////
-PackagePtr BuildQueueBuilder::findPackageByRoot(fs::path root_) const
+PackagePtr BuildQueueBuilder::findPackageByRoot(fs::path const& root_) const
 {
-	auto it = rg::lower_bound( loadedPackages, root_, {}, &Package::root );
+	auto it = packagesByRoot.find( packageKey(root_) );
 
-	if (it != loadedPackages.end() && (*it)->root == root_)
-		return *it;
+	if (it != packagesByRoot.end())
+		return it->second;
 
 	return nullptr;
 }
 
 
 /////////////////////////////////////////////////
-bool BuildQueueBuilder::isPackageLoaded(fs::path root_) const
+bool BuildQueueBuilder::isPackageLoaded(fs::path const& root_) const
 {
-	return rg::binary_search( loadedPackages, root_, {}, &Package::root );
+	return packagesByRoot.contains( packageKey(root_) );
+}
+
+/////////////////////////////////////////////////
+String const& BuildQueueBuilder::packageKey(fs::path const& root_) const
+{
+	auto [it, inserted] = canonicalRoots.try_emplace(root_.string());
+	if (inserted)
+	{
+		auto ec = std::error_code{};
+		auto canonical = fs::weakly_canonical(root_, ec);
+
+		it->second = fsx::fwd(ec ? root_.lexically_normal() : canonical).string();
+	}
+
+	return it->second;
 }
 
 
@@ -259,22 +287,13 @@ bool BuildQueueBuilder::isPackageLoaded(fs::path root_) const
 
 
 /////////////////////////////////////////////////
-bool wasDependencyQueued(Dependency const& dep, DepQueue const& readyQueue_)
+bool wasDependencyQueued(Dependency const& dep, QueuedDeps const& queued_)
 {
-	for (auto const& step : readyQueue_)
-	{
-		// TODO: Can be done better (binary search on sorted range)
-		auto it = rg::find(step, &dep, &BuildQueueBuilder::ProjectDep::dep );
-
-		if (it != step.end())
-			return true;
-	}
-
-	return false;
+	return queued_.contains(&dep);
 }
 
 /////////////////////////////////////////////////
-bool projectHasPendingDependencies(Project const& project, DepQueue const& readyQueue_)
+bool projectHasPendingDependencies(Project const& project, QueuedDeps const& queued_)
 {
 	auto selfDepsAcc = getAccesses(project.dependencies.self);
 
@@ -285,7 +304,7 @@ bool projectHasPendingDependencies(Project const& project, DepQueue const& ready
 			if (!selfDep.isPackage() && !selfDep.isSelf())
 				continue;
 
-			if (!wasDependencyQueued(selfDep, readyQueue_))
+			if (!wasDependencyQueued(selfDep, queued_))
 				return true;
 		}
 	}
@@ -293,7 +312,7 @@ bool projectHasPendingDependencies(Project const& project, DepQueue const& ready
 }
 
 /////////////////////////////////////////////////
-bool packageHasPendingDependencies(PackageDependency & dep, DepQueue const& readyQueue_)
+bool packageHasPendingDependencies(PackageDependency & dep, QueuedDeps const& queued_)
 {
 	auto& packagePtr = dep.package;
 
@@ -302,7 +321,7 @@ bool packageHasPendingDependencies(PackageDependency & dep, DepQueue const& read
 		// Find pointer to project:
 		auto& project = packagePtr->requireProject(projectName);
 
-		if (projectHasPendingDependencies(project, readyQueue_))
+		if (projectHasPendingDependencies(project, queued_))
 			return true;
 	}
 
@@ -310,14 +329,14 @@ bool packageHasPendingDependencies(PackageDependency & dep, DepQueue const& read
 }
 
 /////////////////////////////////////////////////
-bool selfPackageHasPendingDependencies(SelfDependency & dep, DepQueue const& readyQueue_)
+bool selfPackageHasPendingDependencies(SelfDependency & dep, QueuedDeps const& queued_)
 {
 	auto& packagePtr = dep.package;
 
 	// Find pointer to project:
 	auto& project = packagePtr->requireProject(dep.depProjName);
 
-	if (projectHasPendingDependencies(project, readyQueue_))
+	if (projectHasPendingDependencies(project, queued_))
 		return true;
 
 	return false;
@@ -2,6 +2,8 @@
 
 #include <Pacc/Generation/Logs.hpp>
 #include <Pacc/System/Environment.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/System/FileView.hpp>
 
 ////////////////////////////////////////////
 fs::path requireBuildLogsFolder()
@@ -51,6 +53,89 @@ auto getSortedBuildLogs(size_t limit) -> Vec<fs::path>
 	return logs;
 }
 
+////////////////////////////////////////////
+auto findLatestBuildLog(StringView packageName_) -> Opt<fs::path>
+{
+	auto suffix = fmt::format("_{}.log", packageName_);
+
+	auto latest = Opt<fs::path>();
+	for(auto it : fs::directory_iterator(requireBuildLogsFolder()))
+	{
+		auto name = it.path().filename().string();
+
+		// Names start with the time, so the greatest one is the newest
+		if (it.is_regular_file() && name.ends_with(suffix) && (!latest || name > latest->filename().string()))
+			latest = it.path();
+	}
+
+	return latest;
+}
+
+////////////////////////////////////////////
+auto saveBuildReport(StringView packageName_, StringView reportName_, String const& content_) -> fs::path
+{
+	fs::path p = requireBuildLogsFolder();
+
+	p /= fmt::format("{}_{}_{}", currentTimeForLog(), packageName_, reportName_);
+
+	std::ofstream{ p } << content_;
+	return p;
+}
+
+////////////////////////////////////////////
+static auto buildDurationsFile() -> fs::path
+{
+	return env::requirePaccDataStorageFolder() / "build_durations.json";
+}
+
+////////////////////////////////////////////
+auto buildDurationKey(Path const& packageFolder_) -> String
+{
+	auto ec = std::error_code{};
+	auto canonical = fs::weakly_canonical(packageFolder_, ec);
+	return fsx::fwd(ec ? packageFolder_ : canonical).string();
+}
+
+////////////////////////////////////////////
+auto loadBuildDurations() -> StrUMap<double>
+{
+	auto result = StrUMap<double>();
+
+	auto path = buildDurationsFile();
+	if (!fs::exists(path))
+		return result;
+
+	auto j = json::parse(FileView(path), nullptr, false);
+	if (!j.is_object())
+		return result;
+
+	for (auto const& [folder, ms] : j.items())
+	{
+		if (ms.is_number())
+			result[folder] = ms.get<double>();
+	}
+
+	return result;
+}
+
+////////////////////////////////////////////
+void saveBuildDuration(Path const& packageFolder_, double milliseconds_)
+{
+	auto path = buildDurationsFile();
+
+	auto j = json::object();
+	if (fs::exists(path))
+	{
+		j = json::parse(FileView(path), nullptr, false);
+		if (!j.is_object())
+			j = json::object();
+	}
+
+	j[buildDurationKey(packageFolder_)] = milliseconds_;
+
+	std::ofstream{ path } << j.dump(1, '\t');
+}
+
 ////////////////////////////////////////////
 auto currentTimeForLog() -> String
 {
@@ -0,0 +1,349 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Generation/PchSynthesis.hpp>
+
+#include <Pacc/Readers/General.hpp>
+#include <Pacc/System/Filesystem.hpp>
+
+namespace gen
+{
+
+constexpr StringView CppSourceExtensions[] = { ".cpp", ".cc", ".cxx", ".c++" };
+
+// A header is precompiled when at least this fraction of the sources (and at least 2 of them) include it
+constexpr double 		MinPchHeaderWeight 	= 0.25;
+constexpr std::size_t 	MinPchHeaderSources = 2;
+
+constexpr StringView AutoPchDefinition = "PACC_AUTO_PCH";
+
+struct IncludeDirective
+{
+	String 	name;
+	bool 	angled = true;
+
+	auto key() const -> String { return angled ? fmt::format("<{}>", name) : fmt::format("\"{}\"", name); }
+};
+
+/// <summary>Resolves includes of a project and remembers the external includes of each header of the package.</summary>
+struct IncludeScanner
+{
+	Path 		root;
+	Path 		packagesFolder;
+	Vec<Path> 	includeFolders;
+
+	StrUMap<Vec<IncludeDirective>> 	externalIncludes; 	// by header of the package, includes of included headers too
+	USet<String> 					visiting; 			// include cycles
+
+	auto scan(Path const& file_) -> Vec<IncludeDirective> const&;
+	auto resolveInternal(Path const& includingFolder_, IncludeDirective const& include_) const -> Opt<Path>;
+};
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto parseIncludes(String const& content_) -> Vec<IncludeDirective>;
+static void writeIfChanged(Path const& path_, String const& content_);
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto suggestPchHeaders(Package const& pkg_, Project const& project_, std::size_t maxHeaders_) -> Vec<HeaderUsage>
+{
+	auto scanner = IncludeScanner();
+	scanner.root 			= fsx::fwd(pkg_.rootFolder());
+	scanner.packagesFolder 	= scanner.root / "pacc_packages";
+
+	for (auto const* folders : { &project_.includeFolders.self.public_, &project_.includeFolders.self.private_, &project_.includeFolders.self.interface_ })
+	{
+		for (auto const& folder : *folders)
+			scanner.includeFolders.push_back(fsx::fwd(pkg_.resolvePath(folder)));
+	}
+
+	// Sources
+	auto sources = Vec<Path>();
+	{
+		auto seen = USet<String>();
+		for (auto const& pattern : project_.files)
+		{
+			for (auto& file : fsx::glob(fsx::fwd(pkg_.resolvePath(pattern)).string()))
+			{
+				auto extension = file.extension().string();
+				if (rg::find(CppSourceExtensions, extension) == std::end(CppSourceExtensions))
+					continue;
+
+				if (seen.insert(file.string()).second)
+					sources.push_back(std::move(file));
+			}
+		}
+	}
+
+	// Count the sources that include each header
+	auto usages 	= Vec<HeaderUsage>(); // in the order of first include
+	auto usageByKey = StrUMap<std::size_t>();
+
+	for (auto const& source : sources)
+	{
+		for (auto const& include : scanner.scan(source))
+		{
+			auto [it, inserted] = usageByKey.try_emplace(include.key(), usages.size());
+			if (inserted)
+				usages.push_back(HeaderUsage{ .name = include.name, .angled = include.angled });
+
+			++usages[it->second].sources;
+		}
+	}
+
+	auto minSources = std::max<std::size_t>(MinPchHeaderSources, std::size_t(std::ceil(MinPchHeaderWeight * double(sources.size()))));
+
+	auto ranked = Vec<std::size_t>();
+	for (std::size_t i = 0; i < usages.size(); ++i)
+	{
+		usages[i].weight = double(usages[i].sources) / double(sources.size());
+		if (usages[i].sources >= minSources)
+			ranked.push_back(i);
+	}
+
+	rg::stable_sort(ranked, [&](std::size_t lhs, std::size_t rhs) { return usages[lhs].sources > usages[rhs].sources; });
+	if (ranked.size() > maxHeaders_)
+		ranked.resize(maxHeaders_);
+
+	// Keep the order of includes, some headers depend on it
+	rg::sort(ranked);
+
+	auto result = Vec<HeaderUsage>();
+	result.reserve(ranked.size());
+	for (auto idx : ranked)
+		result.push_back(std::move(usages[idx]));
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+auto writeAutoPch(Package const& pkg_, Project const& project_) -> Opt<PrecompiledHeader>
+{
+	auto headers = suggestPchHeaders(pkg_, project_);
+	if (headers.empty())
+		return std::nullopt;
+
+	auto pch = PrecompiledHeader{
+			.header 	= fmt::format("build/pch/{}/pch.hpp", project_.name),
+			.source 	= fmt::format("build/pch/{}/pch.cpp", project_.name),
+			.definition = String(AutoPchDefinition),
+			.automatic 	= true
+		};
+
+	auto header = fmt::format("// Precompiled header of project \"{}\", generated by pacc. Do not edit.\n#pragma once\n\n", project_.name);
+	for (auto const& usage : headers)
+	{
+		header += fmt::format("#include {}\n", IncludeDirective{ usage.name, usage.angled }.key());
+	}
+
+	auto source = fmt::format("// Precompiled header source of project \"{}\", generated by pacc. Do not edit.\n#include \"{}\"\n", project_.name, pch.header);
+
+	auto root = pkg_.rootFolder();
+	fs::create_directories(root / "build/pch" / project_.name);
+
+	writeIfChanged(root / pch.header, header);
+	writeIfChanged(root / pch.source, source);
+
+	return pch;
+}
+
+///////////////////////////////////////////////////
+auto resolvePch(Package const& pkg_, Project const& project_) -> Opt<PrecompiledHeader>
+{
+	if (!project_.pch.has_value() || !project_.pch->automatic)
+		return project_.pch;
+
+	return writeAutoPch(pkg_, project_);
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto IncludeScanner::scan(Path const& file_) -> Vec<IncludeDirective> const&
+{
+	static auto const None = Vec<IncludeDirective>();
+
+	auto key = file_.string();
+	if (auto it = externalIncludes.find(key); it != externalIncludes.end())
+		return it->second;
+
+	if (!visiting.insert(key).second)
+		return None;
+
+	auto result 	= Vec<IncludeDirective>();
+	auto resultKeys = USet<String>();
+
+	auto add = [&](IncludeDirective const& include_) {
+			if (resultKeys.insert(include_.key()).second)
+				result.push_back(include_);
+		};
+
+	auto content = String();
+	try {
+		content = readFileContents(file_);
+	}
+	catch(...) {
+		// Unreadable file, no includes.
+	}
+
+	for (auto const& include : parseIncludes(content))
+	{
+		if (auto internal = this->resolveInternal(file_.parent_path(), include))
+		{
+			for (auto const& nested : this->scan(*internal))
+				add(nested);
+		}
+		else
+			add(include);
+	}
+
+	visiting.erase(key);
+	return externalIncludes[std::move(key)] = std::move(result);
+}
+
+///////////////////////////////////////////////////
+auto IncludeScanner::resolveInternal(Path const& includingFolder_, IncludeDirective const& include_) const -> Opt<Path>
+{
+	auto isInside = [](Path const& path_, Path const& folder_) {
+			auto relative = path_.lexically_relative(folder_);
+			return !relative.empty() && *relative.begin() != "..";
+		};
+
+	auto tryResolve = [&](Path const& folder_) -> Opt<Path> {
+			auto ec 		= std::error_code{};
+			auto candidate 	= fsx::fwd((folder_ / include_.name).lexically_normal());
+
+			if (!fs::is_regular_file(candidate, ec))
+				return std::nullopt;
+
+			// Dependencies are external
+			if (!isInside(candidate, root) || isInside(candidate, packagesFolder))
+				return std::nullopt;
+
+			return candidate;
+		};
+
+	// "name" is searched next to the including file first
+	if (!include_.angled)
+	{
+		if (auto resolved = tryResolve(includingFolder_))
+			return resolved;
+	}
+
+	for (auto const& folder : includeFolders)
+	{
+		if (auto resolved = tryResolve(folder))
+			return resolved;
+	}
+
+	return std::nullopt;
+}
+
+///////////////////////////////////////////////////
+static auto parseIncludes(String const& content_) -> Vec<IncludeDirective>
+{
+	auto result = Vec<IncludeDirective>();
+
+	auto isSpace = [](char c) { return c == ' ' || c == '\t'; };
+	auto skipSpaces = [&](StringView str_) {
+			while (!str_.empty() && isSpace(str_.front()))
+				str_.remove_prefix(1);
+			return str_;
+		};
+	auto readWord = [&](StringView& str_) {
+			str_ = skipSpaces(str_);
+			auto len = std::size_t(0);
+			while (len < str_.size() && (std::isalnum(static_cast<unsigned char>(str_[len])) || str_[len] == '_'))
+				++len;
+
+			auto word = str_.substr(0, len);
+			str_.remove_prefix(len);
+			return word;
+		};
+
+	auto depth 			= 0; 		// of conditional blocks
+	auto guardDepth 	= 0; 		// 1 if the whole file is in an include guard
+	auto numDirectives 	= 0;
+	auto guardName 		= StringView();
+	auto inComment 		= false;
+
+	auto content = StringView(content_);
+	while (!content.empty())
+	{
+		auto lineEnd 	= content.find('\n');
+		auto line 		= content.substr(0, lineEnd);
+		content.remove_prefix(lineEnd == StringView::npos ? content.size() : lineEnd + 1);
+
+		if (inComment)
+		{
+			auto commentEnd = line.find("*/");
+			if (commentEnd == StringView::npos)
+				continue;
+
+			inComment = false;
+			line.remove_prefix(commentEnd + 2);
+		}
+
+		line = skipSpaces(line);
+		if (line.starts_with("/*") && line.find("*/", 2) == StringView::npos)
+		{
+			inComment = true;
+			continue;
+		}
+
+		if (!line.starts_with('#'))
+			continue;
+
+		line.remove_prefix(1);
+		auto directive = readWord(line);
+		++numDirectives;
+
+		if (directive == "if" || directive == "ifdef" || directive == "ifndef")
+		{
+			if (numDirectives == 1 && directive == "ifndef")
+				guardName = readWord(line);
+
+			++depth;
+		}
+		else if (directive == "endif")
+			depth = std::max(depth - 1, 0);
+		else if (directive == "define")
+		{
+			if (numDirectives == 2 && !guardName.empty() && readWord(line) == guardName)
+				guardDepth = 1;
+		}
+		else if (directive == "include" && depth == guardDepth)
+		{
+			line = skipSpaces(line);
+			if (line.empty() || (line.front() != '<' && line.front() != '"'))
+				continue;
+
+			auto angled = (line.front() == '<');
+			auto nameEnd = line.find(angled ? '>' : '"', 1);
+			if (nameEnd == StringView::npos)
+				continue;
+
+			result.push_back(IncludeDirective{ String(line.substr(1, nameEnd - 1)), angled });
+		}
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+static void writeIfChanged(Path const& path_, String const& content_)
+{
+	if (!fs::exists(path_) || readFileContents(path_) != content_)
+		std::ofstream(path_, std::ios::binary) << content_;
+}
+
+}
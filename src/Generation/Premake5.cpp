@@ -3,11 +3,14 @@
 #include <Pacc/App/App.hpp>
 #include <Pacc/Generation/Premake5.hpp>
 #include <Pacc/Generation/OutputFormatter.hpp>
+#include <Pacc/Generation/UnityBuild.hpp>
+#include <Pacc/Generation/PchSynthesis.hpp>
 #include <Pacc/System/Filesystem.hpp>
 #include <Pacc/System/Environment.hpp>
 #include <Pacc/System/Process.hpp>
 #include <Pacc/Helpers/Exceptions.hpp>
 #include <Pacc/Helpers/String.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 
 using namespace fmt;
 
@@ -98,6 +101,7 @@ namespace gen
 void appendWorkspace		(OutputFormatter &fmt_, Package const& pkg_);
 void appendProject			(OutputFormatter &fmt_, Package const& pkg_, Project const& project_);
 void appendConfiguration	(OutputFormatter &fmt_, Package const& pkg_, Project const& project_, Configuration const& config_);
+void appendUnityBuild		(OutputFormatter &fmt_, Package const& pkg_, Project const& project_, Opt<PrecompiledHeader> const& pch_);
 template <typename T>
 void appendPropWithAccess	(OutputFormatter &fmt_, StringView propName, T const& values_, MultiAccess accesses_ = MultiAccess::NoInterface);
 template <typename T>
@@ -107,6 +111,9 @@ void appendStrings(OutputFormatter &fmt_, Vec<String> const& vec_);
 /////////////////////////////////////////////////
 void Premake5::generate(Package const & pkg_)
 {
+	auto span = tracing::Span("Premake5::generate", "generation");
+	span.arg("package", pkg_.name);
+
 	// Prepare output buffer
 	String out;
 	out.reserve(4 * 1024 * 1024);
@@ -248,9 +255,10 @@ void appendProject(OutputFormatter &fmt_, Package const& pkg_, Project const& pr
 			fmt_.write("cppdialect(\"C++17\")\n");
 		}
 
-		if (project_.pch.has_value())
+		auto resolvedPch = resolvePch(pkg_, project_);
+		if (resolvedPch.has_value())
 		{
-			auto const& pch = project_.pch.value();
+			auto const& pch = resolvedPch.value();
 			fmt_.write("-- Precompiled header:\n");
 
 			fmt_.write("pchheader(\"{}\")\n", pch.header);
@@ -259,6 +267,19 @@ void appendProject(OutputFormatter &fmt_, Package const& pkg_, Project const& pr
 			fmt_.write("defines ( {{ \"{}=\\\"{}\\\"\" }} )\n", pch.definition, pch.header);
 
 			fmt_.write("includedirs( {{ \".\" }} )\n\n");
+
+			// Sources do not include the synthesized header (gmake includes the precompiled header by itself)
+			if (pch.automatic)
+			{
+				fmt_.write("files( {{ \"{}\" }} )\n", pch.source);
+				fmt_.write("filter(\"action:vs*\")\n");
+				{
+					auto indent = IndentScope{fmt_};
+					fmt_.write("forceincludes( {{ \"{}\" }} )\n", pch.header);
+					fmt_.write("filter(\"\")\n");
+				}
+				fmt_.write("\n");
+			}
 		}
 
 		auto& app = useApp();
@@ -273,8 +294,10 @@ void appendProject(OutputFormatter &fmt_, Package const& pkg_, Project const& pr
 
 		appendConfiguration(fmt_, pkg_, project_, project_);
 
+		appendUnityBuild(fmt_, pkg_, project_, resolvedPch);
+
 		// TODO: keep insertion order
-		for (auto filterIt : project_.premakeFilters)
+		for (auto const& filterIt : project_.premakeFilters)
 		{
 			fmt_.write("\n");
 			fmt_.write("filter(\"{}\")\n", filterIt.first);
@@ -288,6 +311,47 @@ void appendProject(OutputFormatter &fmt_, Package const& pkg_, Project const& pr
 }
 
 
+/////////////////////////////////////////////////
+void appendUnityBuild(OutputFormatter &fmt_, Package const& pkg_, Project const& project_, Opt<PrecompiledHeader> const& pch_)
+{
+	// The project setting wins over the "--unity" switch
+	auto unity = project_.unity;
+	if (!unity.has_value() && useApp().settings.isFlagSet("--unity"))
+		unity = UnityBuild{};
+
+	if (!unity.has_value() || !unity->enabled || project_.type == Project::Interface)
+		return;
+
+	auto files = writeUnityBuild(pkg_, project_, *unity, pch_);
+	if (files.batches.empty())
+		return;
+
+	auto toStrings = [](Vec<Path> const& paths_) {
+			auto strings = Vec<String>();
+			strings.reserve(paths_.size());
+			for (auto const& path : paths_)
+				strings.push_back(fsx::fwd(path).string()); // backslashes would be escapes in Lua strings
+			return strings;
+		};
+
+	fmt_.write("\n-- Unity build:\n");
+	fmt_.write("files ({{\n");
+	{
+		auto indent = IndentScope{fmt_};
+		appendStrings(fmt_, toStrings(files.batches));
+	}
+	fmt_.write("}})\n");
+
+	// Sources included by the batches must not be compiled again.
+	// Listed as strings, a "files:" filter would split paths with spaces.
+	fmt_.write("removefiles ({{\n");
+	{
+		auto indent = IndentScope{fmt_};
+		appendStrings(fmt_, toStrings(files.batchedSources));
+	}
+	fmt_.write("}})\n");
+}
+
 /////////////////////////////////////////////////
 void appendConfiguration(OutputFormatter &fmt_, Package const& pkg_, Project const& project_, Configuration const& config_)
 {
@@ -315,13 +379,18 @@ void appendConfiguration(OutputFormatter &fmt_, Package const& pkg_, Project con
 	if (project_.isLibrary())
 		computedLinkMode = MultiAccess::Private; // append only private deps
 
-	// Computed first:
-	appendPropWithAccess(fmt_, "defines", 		config_.defines.computed);
-	appendPropWithAccess(fmt_, "links", 		config_.linkedLibraries.computed, computedLinkMode);
-	appendPropWithAccess(fmt_, "includedirs", 	config_.includeFolders.computed);
-	appendPropWithAccess(fmt_, "libdirs", 		config_.linkerFolders.computed, computedLinkMode);
-	appendPropWithAccess(fmt_, "buildoptions", 	config_.compilerOptions.computed);
-	appendPropWithAccess(fmt_, "linkoptions", 	config_.linkerOptions.computed);
+	// Computed first (flattened only here):
+	auto appendComputed = [&](StringView propName_, auto const& computed_, MultiAccess accesses_ = MultiAccess::NoInterface)
+		{
+			appendPropWithAccess(fmt_, propName_, flattenAccesses(computed_, accesses_), accesses_);
+		};
+
+	appendComputed("defines", 		config_.defines.computed);
+	appendComputed("links", 		config_.linkedLibraries.computed, computedLinkMode);
+	appendComputed("includedirs", 	config_.includeFolders.computed);
+	appendComputed("libdirs", 		config_.linkerFolders.computed, computedLinkMode);
+	appendComputed("buildoptions", 	config_.compilerOptions.computed);
+	appendComputed("linkoptions", 	config_.linkerOptions.computed);
 
 	appendPropWithAccess(fmt_, "files", 		config_.files);
 	appendPropWithAccess(fmt_, "defines", 		config_.defines.self);
@@ -0,0 +1,165 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Generation/UnityBuild.hpp>
+
+#include <Pacc/Readers/General.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/Hash.hpp>
+#include <Pacc/Helpers/String.hpp>
+
+namespace gen
+{
+
+constexpr StringView CppSourceExtensions[] 	= { ".cpp", ".cc", ".cxx", ".c++" };
+constexpr StringView CSourceExtensions[] 	= { ".c" };
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto nameHash(StringView name_) -> uint64_t;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto splitIntoUnityBatches(Vec<String> sources_, std::size_t batchSize_) -> Vec<Vec<String>>
+{
+	rg::sort(sources_);
+
+	// A batch can end once it has half of the requested size,
+	// after each file with the probability that makes the average size match the requested one
+	auto const minSize 		= std::max<std::size_t>(1, batchSize_ / 2);
+	auto const maxSize 		= std::max<std::size_t>(1, batchSize_ * 2);
+	auto const boundaryMod 	= batchSize_ - minSize + 1;
+
+	auto batches = Vec<Vec<String>>();
+	auto current = Vec<String>();
+
+	for (auto& source : sources_)
+	{
+		current.push_back(std::move(source));
+
+		auto boundary = current.size() >= minSize && nameHash(current.back()) % boundaryMod == 0;
+		if (boundary || current.size() >= maxSize)
+			batches.push_back(std::exchange(current, {}));
+	}
+
+	if (!current.empty())
+		batches.push_back(std::move(current));
+
+	return batches;
+}
+
+///////////////////////////////////////////////////
+auto writeUnityBuild(Package const& pkg_, Project const& project_, UnityBuild const& unity_, Opt<PrecompiledHeader> const& pch_) -> UnityBuildFiles
+{
+	auto result = UnityBuildFiles();
+
+	auto root = fsx::fwd(pkg_.rootFolder());
+
+	// Sources compiled separately
+	auto exclude = Vec<String>();
+	for (auto const& pattern : unity_.exclude)
+		exclude.push_back(fsx::fwd(pkg_.resolvePath(pattern)).string());
+
+	// The PCH source has to stay separate to create the precompiled header
+	if (pch_)
+		exclude.push_back(fsx::fwd(pkg_.resolvePath(pch_->source)).string());
+
+	// Sources, relative to the package (so batches stay the same when the package is moved):
+	auto cppSources = Vec<String>();
+	auto cSources 	= Vec<String>();
+	auto seen 		= USet<String>();
+
+	for (auto const& pattern : project_.files)
+	{
+		for (auto const& file : fsx::glob(fsx::fwd(pkg_.resolvePath(pattern)).string()))
+		{
+			auto path = file.string();
+			if (!seen.insert(path).second)
+				continue;
+
+			if (rg::any_of(exclude, [&](String const& excluded) { return matchesGlob(excluded, path); }))
+				continue;
+
+			auto extension 	= file.extension().string();
+			auto relative 	= fsx::fwd(file.lexically_relative(root)).string();
+
+			if (rg::find(CppSourceExtensions, extension) != std::end(CppSourceExtensions))
+				cppSources.push_back(std::move(relative));
+			else if (rg::find(CSourceExtensions, extension) != std::end(CSourceExtensions))
+				cSources.push_back(std::move(relative));
+		}
+	}
+
+	auto outputFolder = root / "build/unity" / project_.name;
+	fs::create_directories(outputFolder);
+
+	auto written = USet<String>();
+
+	auto writeBatches = [&](Vec<String> sources_, StringView extension_, bool includePch_)
+		{
+			for (auto const& batch : splitIntoUnityBatches(std::move(sources_), unity_.batchSize))
+			{
+				// Nothing to gain from a single file
+				if (batch.size() < 2)
+					continue;
+
+				auto hash = Fnv1a();
+				hash.add(batch.front());
+
+				auto fileName = fmt::format("unity_{}{}", hash.hex().substr(0, 12), extension_);
+
+				auto content = fmt::format("// Unity build of project \"{}\", generated by pacc. Do not edit.\n", project_.name);
+				if (includePch_ && pch_)
+					content += fmt::format("#include \"{}\"\n", pch_->header);
+
+				for (auto const& source : batch)
+				{
+					auto sourcePath = fsx::fwd(root / source);
+					content += fmt::format("#include \"{}\"\n", sourcePath.string());
+					result.batchedSources.push_back(std::move(sourcePath));
+				}
+
+				// Keep the modification time of unchanged batches
+				auto path = fsx::fwd(outputFolder / fileName);
+				if (!fs::exists(path) || readFileContents(path) != content)
+					std::ofstream(path, std::ios::binary) << content;
+
+				written.insert(fileName);
+				result.batches.push_back(std::move(path));
+			}
+		};
+
+	writeBatches(std::move(cppSources), ".cpp", true);
+	writeBatches(std::move(cSources), ".c", false);
+
+	// Remove batches of the previous generation
+	auto ec = std::error_code{};
+	for (auto it = fs::directory_iterator(outputFolder, ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+	{
+		auto fileName = it->path().filename().string();
+		if (fileName.starts_with("unity_") && !written.contains(fileName))
+			fs::remove(it->path(), ec);
+	}
+
+	return result;
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static auto nameHash(StringView name_) -> uint64_t
+{
+	auto hash = Fnv1a();
+	hash.addBytes(name_);
+	return hash.digest();
+}
+
+}
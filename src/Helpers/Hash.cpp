@@ -0,0 +1,100 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Helpers/Hash.hpp>
+
+#include <bit>
+#include <cstring>
+
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+constexpr std::size_t StripeSize = 32;
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto read64(char const* ptr_) -> uint64_t;
+static auto mixLane(uint64_t acc_, uint64_t input_) -> uint64_t;
+static auto avalanche(uint64_t hash_) -> uint64_t;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto fastHash128(StringView bytes_) -> Hash128
+{
+	auto ptr = bytes_.data();
+	auto end = ptr + bytes_.size();
+
+	uint64_t lanes[4] = { Prime1 + Prime2, Prime2, 0, uint64_t(0) - Prime1 };
+
+	// Independent lanes, no dependency between the words of a stripe
+	for (; std::size_t(end - ptr) >= StripeSize; ptr += StripeSize)
+	{
+		for (int i = 0; i < 4; ++i)
+			lanes[i] = mixLane(lanes[i], read64(ptr + i * 8));
+	}
+
+	// Both halves combine all lanes, each in a different way
+	auto low 	= std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+	auto high 	= std::rotl(lanes[3], 1) + std::rotl(lanes[2], 7) + std::rotl(lanes[1], 12) + std::rotl(lanes[0], 18);
+
+	low 	+= bytes_.size();
+	high 	^= bytes_.size() * Prime5;
+
+	// Remaining words and bytes
+	for (; std::size_t(end - ptr) >= 8; ptr += 8)
+	{
+		auto k = mixLane(0, read64(ptr));
+		low 	= std::rotl(low ^ k, 27) * Prime1 + Prime4;
+		high 	= std::rotl(high + k * Prime3, 29) * Prime2;
+	}
+
+	for (; ptr < end; ++ptr)
+	{
+		auto b = uint64_t(static_cast<uint8_t>(*ptr));
+		low 	= std::rotl(low ^ (b * Prime5), 11) * Prime1;
+		high 	= std::rotl(high + (b * Prime1), 13) * Prime3;
+	}
+
+	low 	= avalanche(low + high);
+	high 	= avalanche(high ^ low);
+
+	return Hash128{ low, high };
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static auto read64(char const* ptr_) -> uint64_t
+{
+	auto value = uint64_t(0);
+	std::memcpy(&value, ptr_, sizeof(value));
+	return value;
+}
+
+///////////////////////////////////////////////////
+static auto mixLane(uint64_t acc_, uint64_t input_) -> uint64_t
+{
+	return std::rotl(acc_ + input_ * Prime2, 31) * Prime1;
+}
+
+///////////////////////////////////////////////////
+static auto avalanche(uint64_t hash_) -> uint64_t
+{
+	hash_ ^= hash_ >> 33;
+	hash_ *= Prime2;
+	hash_ ^= hash_ >> 29;
+	hash_ *= Prime3;
+	hash_ ^= hash_ >> 32;
+	return hash_;
+}
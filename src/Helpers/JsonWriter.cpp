@@ -0,0 +1,213 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Helpers/JsonWriter.hpp>
+
+#include <cmath>
+
+constexpr std::size_t FlushThreshold = 64 * 1024;
+
+//////////////////////////////////////////////////
+JsonWriter::JsonWriter(std::ostream& out_, bool pretty_)
+	: out(out_), pretty(pretty_)
+{
+}
+
+//////////////////////////////////////////////////
+JsonWriter::~JsonWriter()
+{
+	this->flush();
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::beginObject() -> JsonWriter&
+{
+	this->beginValue();
+	buffer.push_back('{');
+	nonEmpty.push_back(false);
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::endObject() -> JsonWriter&
+{
+	auto hadElements = nonEmpty.back();
+	nonEmpty.pop_back();
+
+	if (hadElements)
+		this->newLine();
+
+	buffer.push_back('}');
+	this->flushIfFull();
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::beginArray() -> JsonWriter&
+{
+	this->beginValue();
+	buffer.push_back('[');
+	nonEmpty.push_back(false);
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::endArray() -> JsonWriter&
+{
+	auto hadElements = nonEmpty.back();
+	nonEmpty.pop_back();
+
+	if (hadElements)
+		this->newLine();
+
+	buffer.push_back(']');
+	this->flushIfFull();
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::key(StringView key_) -> JsonWriter&
+{
+	this->beginValue();
+	this->writeString(key_);
+	buffer.push_back(':');
+	if (pretty)
+		buffer.push_back(' ');
+
+	afterKey = true;
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::value(StringView value_) -> JsonWriter&
+{
+	this->beginValue();
+	this->writeString(value_);
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::value(bool value_) -> JsonWriter&
+{
+	this->beginValue();
+	fmt::format_to(std::back_inserter(buffer), "{}", value_ ? "true" : "false");
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::value(double value_) -> JsonWriter&
+{
+	this->beginValue();
+
+	// JSON has no representation of infinity and NaN
+	if (std::isfinite(value_))
+		fmt::format_to(std::back_inserter(buffer), "{}", value_);
+	else
+		fmt::format_to(std::back_inserter(buffer), "null");
+
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::value(int64_t value_) -> JsonWriter&
+{
+	this->beginValue();
+	fmt::format_to(std::back_inserter(buffer), "{}", value_);
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::value(std::size_t value_) -> JsonWriter&
+{
+	this->beginValue();
+	fmt::format_to(std::back_inserter(buffer), "{}", value_);
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::null() -> JsonWriter&
+{
+	this->beginValue();
+	fmt::format_to(std::back_inserter(buffer), "null");
+	return *this;
+}
+
+//////////////////////////////////////////////////
+auto JsonWriter::stringArray(Vec<String> const& values_) -> JsonWriter&
+{
+	this->beginArray();
+	for (auto const& v : values_)
+		this->value(v);
+	return this->endArray();
+}
+
+//////////////////////////////////////////////////
+void JsonWriter::flush()
+{
+	out.write(buffer.data(), std::streamsize(buffer.size()));
+	buffer.clear();
+}
+
+//////////////////////////////////////////////////
+void JsonWriter::beginValue()
+{
+	if (afterKey)
+	{
+		afterKey = false;
+		return;
+	}
+
+	if (nonEmpty.empty())
+		return;
+
+	if (nonEmpty.back())
+		buffer.push_back(',');
+
+	nonEmpty.back() = true;
+	this->newLine();
+}
+
+//////////////////////////////////////////////////
+void JsonWriter::newLine()
+{
+	if (!pretty)
+		return;
+
+	buffer.push_back('\n');
+	for (std::size_t i = 0; i < nonEmpty.size(); ++i)
+		buffer.push_back('\t');
+}
+
+//////////////////////////////////////////////////
+void JsonWriter::writeString(StringView str_)
+{
+	constexpr char HexDigits[] = "0123456789abcdef";
+
+	buffer.push_back('"');
+	for (char c : str_)
+	{
+		switch (c)
+		{
+		case '"': 	buffer.append(StringView("\\\"")); break;
+		case '\\': 	buffer.append(StringView("\\\\")); break;
+		case '\n': 	buffer.append(StringView("\\n")); break;
+		case '\r': 	buffer.append(StringView("\\r")); break;
+		case '\t': 	buffer.append(StringView("\\t")); break;
+		default:
+			if (uint8_t(c) < 0x20)
+			{
+				char escaped[] = { '\\', 'u', '0', '0', HexDigits[(c >> 4) & 0xF], HexDigits[c & 0xF] };
+				buffer.append(escaped, escaped + sizeof(escaped));
+			}
+			else
+				buffer.push_back(c);
+		}
+	}
+	buffer.push_back('"');
+}
+
+//////////////////////////////////////////////////
+void JsonWriter::flushIfFull()
+{
+	if (buffer.size() >= FlushThreshold)
+		this->flush();
+}
@@ -102,3 +102,41 @@ String replaceAll(StringView source_, StringView from_, StringView to_)
 
     return newString;
 }
+
+/////////////////////////////////////////////////
+bool matchesGlob(StringView pattern_, StringView path_)
+{
+	while (!pattern_.empty())
+	{
+		if (pattern_[0] == '*')
+		{
+			auto crossesFolders = pattern_.starts_with("**");
+			pattern_.remove_prefix(crossesFolders ? 2 : 1);
+
+			// "**/" matches no folder too
+			if (crossesFolders && pattern_.starts_with('/') && matchesGlob(pattern_.substr(1), path_))
+				return true;
+
+			for (std::size_t i = 0; ; ++i)
+			{
+				if (matchesGlob(pattern_, path_.substr(i)))
+					return true;
+
+				if (i == path_.size() || (!crossesFolders && path_[i] == '/'))
+					return false;
+			}
+		}
+
+		if (path_.empty())
+			return false;
+
+		auto matches = (pattern_[0] == '?') ? (path_[0] != '/') : (pattern_[0] == path_[0]);
+		if (!matches)
+			return false;
+
+		pattern_.remove_prefix(1);
+		path_.remove_prefix(1);
+	}
+
+	return path_.empty();
+}
@@ -0,0 +1,134 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/Helpers/Tracing.hpp>
+
+namespace tracing
+{
+
+////////////////////////////////////////
+void Tracer::enable(Path outputFile_)
+{
+	auto lock = std::lock_guard(mutex);
+
+	outputFile 	= std::move(outputFile_);
+	startTime 	= ch::steady_clock::now();
+	events.clear();
+	threadIds.clear();
+
+	// The main thread first:
+	this->currentThreadId();
+
+	isEnabled = true;
+}
+
+////////////////////////////////////////
+auto Tracer::now() const -> int64_t
+{
+	return ch::duration_cast<ch::microseconds>(ch::steady_clock::now() - startTime).count();
+}
+
+////////////////////////////////////////
+void Tracer::record(Event event_)
+{
+	if (!this->enabled())
+		return;
+
+	auto lock = std::lock_guard(mutex);
+
+	event_.threadId = this->currentThreadId();
+	events.push_back(std::move(event_));
+}
+
+////////////////////////////////////////
+void Tracer::finish()
+{
+	if (!isEnabled.exchange(false))
+		return;
+
+	auto lock = std::lock_guard(mutex);
+
+	auto traceEvents = json::array();
+
+	for (auto const& [nativeId, id] : threadIds)
+	{
+		traceEvents.push_back({
+				{ "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", id },
+				{ "args", { { "name", id == 0 ? String("main") : fmt::format("worker {}", id) } } }
+			});
+	}
+
+	for (auto const& event : events)
+	{
+		auto args = json::object();
+		for (auto const& [name, value] : event.args)
+			args[name] = value;
+
+		traceEvents.push_back({
+				{ "name", event.name }, { "cat", event.category }, { "ph", "X" },
+				{ "ts", event.start }, { "dur", event.duration },
+				{ "pid", 1 }, { "tid", event.threadId },
+				{ "args", std::move(args) }
+			});
+	}
+
+	auto j = json::object();
+	j["traceEvents"] 		= std::move(traceEvents);
+	j["displayTimeUnit"] 	= "ms";
+
+	std::ofstream(outputFile) << j.dump();
+
+	fmt::print(fmt::fg(fmt::color::gray), "Trace written to \"{}\" ({} events).\n", outputFile.string(), events.size());
+	events.clear();
+}
+
+////////////////////////////////////////
+auto Tracer::currentThreadId() -> int
+{
+	auto [it, inserted] = threadIds.try_emplace(std::this_thread::get_id(), int(threadIds.size()));
+	return it->second;
+}
+
+////////////////////////////////////////
+auto tracer() -> Tracer&
+{
+	static Tracer instance;
+	return instance;
+}
+
+////////////////////////////////////////
+Span::Span(StringView name_, StringView category_)
+{
+	auto& t = tracer();
+	if (!t.enabled())
+		return;
+
+	event = Tracer::Event{ String(name_), category_, t.now() };
+}
+
+////////////////////////////////////////
+Span::Span(Opt<Tracer::Event> event_)
+	: event(std::move(event_))
+{
+}
+
+////////////////////////////////////////
+Span::~Span()
+{
+	if (!event)
+		return;
+
+	auto& t = tracer();
+	event->duration = t.now() - event->start;
+	t.record(std::move(*event));
+}
+
+////////////////////////////////////////
+auto Span::arg(StringView name_, StringView value_) -> Span&
+{
+	if (event)
+		event->args.emplace_back(String(name_), String(value_));
+
+	return *this;
+}
+
+}
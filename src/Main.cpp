@@ -4,8 +4,11 @@
 
 #include <Pacc/App/Help.hpp>
 #include <Pacc/App/App.hpp>
+#include <Pacc/App/Daemon.hpp>
+#include <Pacc/Build/DistributedBuild.hpp>
 #include <Pacc/Helpers/Exceptions.hpp>
 #include <Pacc/Helpers/Formatting.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 #include <Pacc/Helpers/String.hpp>
 #include <Pacc/App/PaccConfig.hpp>
 #include <Pacc/System/Environment.hpp>
@@ -20,15 +23,33 @@ void handleArgs(ProgramArgs args_);
 ///////////////////////////////////////////////////
 int main(int argc, char *argv[])
 {
-	using namespace fmt::literals;
-
 	fmt::enableColors();
 
 	auto args = ProgramArgs{ argv, argv + argc };
 
+	// Compiler launcher of distributed builds, its arguments are the compiler's
+	if (args.size() > 1 && args[1] == distributed::LauncherAction)
+		return distributed::runLauncher(args);
+
+	// Served by a running "pacc daemon", if there is one
+	if (auto exitCode = pacc_daemon::forward(args))
+		return *exitCode;
+
+	return runPacc(std::move(args));
+}
+
+///////////////////////////////////////////////////
+auto runPacc(ProgramArgs args_) -> int
+{
+	using namespace fmt::literals;
+
+	// Write the trace (if enabled) on every exit path
+	struct TraceFinisher {
+		~TraceFinisher() { tracing::tracer().finish(); }
+	} traceFinisher;
 
 	try {
-		handleArgs(std::move(args));
+		handleArgs(std::move(args_));
 	}
 	catch(PaccException & exc)
 	{
@@ -51,6 +72,8 @@ int main(int argc, char *argv[])
 
 		return 1;
 	}
+
+	return 0;
 }
 
 ///////////////////////////////////////////////////
@@ -75,6 +98,11 @@ void handleArgs(ProgramArgs args_)
 
 		app.settings = RunSettings::fromArgs(app.args);
 
+		if (auto& traceFlag = *app.settings.flags.at("--trace"); traceFlag.isSet())
+			tracing::tracer().enable(traceFlag.value == "true" ? "pacc_trace.json" : fs::u8path(traceFlag.value));
+
+		auto actionSpan = tracing::Span::formatted("app", "pacc {}", app.args[app.settings.actionNameIndex]);
+
 		// Initial switch for trivial commands
 		switch (app.settings.mainAction)
 		{
@@ -181,6 +209,38 @@ void handleArgs(ProgramArgs args_)
 			app.run();
 			break;
 		}
+		case Action::Graph:
+		{
+			app.loadPaccConfig();
+
+			app.visualizeGraph();
+			break;
+		}
+		case Action::Query:
+		{
+			app.loadPaccConfig();
+
+			app.query();
+			break;
+		}
+		case Action::Daemon:
+		{
+			app.daemon();
+			break;
+		}
+		case Action::Pch:
+		{
+			app.loadPaccConfig();
+
+			app.pch();
+			break;
+		}
+		case Action::Worker:
+		{
+			app.loadPaccConfig();
+			app.worker();
+			break;
+		}
 		}
 	}
 }
@@ -2,6 +2,7 @@
 
 #include <Pacc/App/App.hpp>
 #include <Pacc/Helpers/Lua.hpp>
+#include <Pacc/System/Filesystem.hpp>
 #include <Pacc/PackageSystem/MainPackageLoader.hpp>
 
 /////////////////////////////////////////////
@@ -39,7 +40,7 @@ auto MainPackageLoader::load(fs::path const& root_) -> UPtr<Package>
 /////////////////////////////////////////////
 auto MainPackageLoader::canLoad(fs::path const& root_) const -> bool
 {
-	return fs::is_directory(root_) && !findPackageFile(root_).empty();
+	return fsx::dirCache().isDirectory(root_) && !findPackageFile(root_).empty();
 }
 
 
@@ -3,10 +3,12 @@
 #include <Pacc/App/App.hpp>
 
 #include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/PackageSystem/PackageCache.hpp>
 #include <Pacc/App/Errors.hpp>
 #include <Pacc/PackageSystem/Events.hpp>
 #include <Pacc/System/Environment.hpp>
 #include <Pacc/Readers/General.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 #include <Pacc/System/Filesystem.hpp>
 #include <Pacc/Readers/JsonReader.hpp>
 #include <Pacc/Generation/BuildQueueBuilder.hpp>
@@ -14,138 +16,6 @@
 #include <Pacc/Plugins/CMake.hpp>
 
 
-///////////////////////////////////////////////////
-// Private functions (forward declaration)
-///////////////////////////////////////////////////
-
-template <json::value_t type>
-auto expect(json const& j) -> json const*;
-
-template <json::value_t type>
-auto expectSub(json const& j, StringView subfieldName) -> json const*;
-
-template <json::value_t type>
-auto require(json const& j) -> json const&;
-
-template <json::value_t type>
-auto requireSub(json const& j, StringView subfieldName) -> json const&;
-
-auto selfOrSubfieldOpt(json const& self, StringView fieldName = "") -> json const*;
-auto selfOrSubfieldReq(json const& self, StringView fieldName = "") -> json const&;
-auto selfOrSubfield(json const& self, StringView fieldName, bool required = false) -> json const*;
-
-auto readDependencyAccess(Package &pkg_, Project & proj_, json const& deps_, Vec<Dependency> &target_) -> void;
-auto loadVecOfStrField(json const& j, StringView fieldName, bool direct = false, bool required = false) -> Vec<String>;
-auto loadVecOfStrAccField(json const& j, StringView fieldName, AccessType defaultAccess_ = AccessType::Private) -> VecOfStrAcc;
-
-void loadConfigurationFromJSON(Package & pkg_, Project & project_, Configuration& conf_, json const& root_);
-
-
-void readSingleTargetEventHandler(
-		PaccAppModule_EventHandlerActions const&	events_,
-		EventHandlingTarget&						target_,
-		String const&								key,
-		json const&									value,
-		int											handlerIndex = 0
-	)
-{
-	if (value.is_string())
-	{
-		auto action = value.get<String>(); // TODO: ensure is a string
-		auto [name, behavior] = splitBy(action, ':', true);
-
-		if (action.empty())
-		{
-			// TODO: consider throwing an error
-			return;
-		}
-
-		auto actionHandler = events_.findEventAction(name);
-		if (!actionHandler)
-		{
-			fmt::printLog(
-					fmt::fg(fmt::color::yellow),
-					"[Warning] Handler (id: {}) of the event \"{}\" for target \"{}\" uses unknown action \"{}\":\n    ",
-					handlerIndex, key, target_.name, name
-				);
-			fmt::printLog(fmt::bg(fmt::color::dark_red), "{}", name);
-			fmt::printLog(fmt::fg(fmt::color::dim_gray), ":{}\n\n", behavior);
-			return;
-		}
-
-		if (!actionHandler->canLoadFromAbbreviatedString)
-		{
-			fmt::printLog(
-					fmt::fg(fmt::color::yellow),
-					"Action \"{}\" cannot be loaded from an abbreviated string. Use a JSON object instead.\n",
-					key, target_.name
-				);
-			return;
-		}
-
-		target_.eventHandlers[key].push_back(actionHandler->load(behavior));
-	}
-	else if (value.is_object())
-	{
-		auto action = value.value<String>("action", "");
-
-		if (action.empty())
-		{
-			fmt::printLog(
-					fmt::fg(fmt::color::yellow),
-					"[Warning] Handler (id: {}) of the event \"{}\" for target \"{}\" has no \"action\" field specified.\n",
-					handlerIndex, key, target_.name
-				);
-			// TODO: consider throwing an error
-			return;
-		}
-
-		auto actionHandler = events_.findEventAction(action);
-		if (!actionHandler)
-		{
-			fmt::printLog(
-					fmt::fg(fmt::color::yellow),
-					"[Warning] Handler (id: {}) of the event \"{}\" for target \"{}\" uses unknown action \"{}\":\n    ",
-					handlerIndex, key, target_.name, action
-				);
-			fmt::printLog(fmt::fg(fmt::color::gray), "\"action\": \"");
-			fmt::printLog(fmt::bg(fmt::color::dark_red), "{}", action);
-			fmt::printLog(fmt::fg(fmt::color::gray), "\"\n\n");
-			return;
-		}
-
-		target_.eventHandlers[key].push_back(actionHandler->load(value));
-	}
-}
-
-// TODO: refactor
-void readTargetEventHandlers(
-		PaccAppModule_EventHandlerActions const&	events_,
-		json const&									scriptsContainer,
-		EventHandlingTarget&						target_
-	)
-{
-	if (!scriptsContainer.contains("events"))
-		return;
-	auto scripts = scriptsContainer["events"];
-
-	for (auto [key, value] : scripts.items())
-	{
-		if (value.is_array())
-		{
-			auto idx = 0;
-			for (auto const& item : value)
-			{
-				readSingleTargetEventHandler(events_, target_, key, item, idx);
-				++idx;
-			}
-		}
-		else readSingleTargetEventHandler(events_, target_, key, value);
-	}
-}
-
-
-
 ///////////////////////////////////////////////////
 // Public functions
 ///////////////////////////////////////////////////
@@ -157,8 +27,7 @@ auto findPackageFile(Path const& directory_, Opt<StringView> extension_)
 {
 	auto fileExists = [&] (Path const& path_)
 	{
-		auto fullPath = directory_ / path_;
-		return fs::exists(fullPath) && fs::is_regular_file(fullPath);
+		return fsx::dirCache().isRegularFile(directory_ / path_);
 	};
 
 	// Test JSON files:
@@ -184,8 +53,7 @@ auto findPackageScriptFile(Path const& directory_)
 {
 	auto fileExists = [&] (Path const& path_)
 	{
-		auto fullPath = directory_ / path_;
-		return fs::exists(fullPath) && fs::is_regular_file(fullPath);
+		return fsx::dirCache().isRegularFile(directory_ / path_);
 	};
 
 	auto it = rg::find_if(PackageLUAScript, fileExists);
@@ -195,6 +63,42 @@ auto findPackageScriptFile(Path const& directory_)
 	return {};
 }
 
+///////////////////////////////////////////////////
+auto readPackageMetadata(Path const& manifest_)
+	-> Opt<PackageMetadata>
+{
+	using Event = json::parse_event_t;
+
+	// Keep only the top-level fields we need, values of other keys are not stored:
+	auto topLevelOnly = [](int depth_, Event event_, json& parsed_)
+		{
+			if (event_ != Event::key || depth_ != 1)
+				return true;
+
+			auto const& key = parsed_.get_ref<String const&>();
+			return key == "name" || key == "version" || key == "cmake";
+		};
+
+	try {
+		auto j = json::parse(readFileContents(manifest_), topLevelOnly);
+
+		auto result = PackageMetadata();
+
+		// An array of projects, no package-level info:
+		if (!j.is_object())
+			return result;
+
+		result.name 	= j.value("name", "");
+		result.version 	= Version::fromString( j.value("version", "0") );
+		result.isCMake 	= j.value("cmake", false);
+
+		return result;
+	}
+	catch(...) {
+		return std::nullopt;
+	}
+}
+
 ///////////////////////////////////////////////////
 auto detectArtifactTypeFromPath(StringView path_)
 	-> Artifact
@@ -219,16 +123,10 @@ void TargetBase::inheritConfigurationFrom(Package const& fromPkg_, Project const
 		if (fromProject_.type == Project::Type::StaticLib || fromProject_.type == Project::Type::SharedLib)
 		{
 			// Add dependency output folder:
-			{
-				auto& target = targetByAccessType(linkerFolders.computed, mode_);
-				target.push_back(fsx::fwd(fromPkg_.predictOutputFolder(fromProject_)).string());
-			}
+			linkerFolders.addComputed(mode_, fsx::fwd(fromPkg_.predictOutputFolder(fromProject_)).string());
 
 			// Add dependency file to linker:
-			{
-				auto& target = targetByAccessType(linkedLibraries.computed, mode_);
-				target.push_back(fromProject_.outputArtifact().string());
-			}
+			linkedLibraries.addComputed(mode_, fromProject_.outputArtifact().string());
 		}
 	}
 
@@ -236,14 +134,10 @@ void TargetBase::inheritConfigurationFrom(Package const& fromPkg_, Project const
 
 
 	// Inherit all premake filters:
-	for(auto it : fromProject_.premakeFilters)
+	for(auto const& [filter, config] : fromProject_.premakeFilters)
 	{
-		// Ensure configuration exists:
-		if (premakeFilters.find(it.first) == premakeFilters.end())
-			premakeFilters[it.first] = {};
-
-		// Merge configuration:
-		computeConfiguration( premakeFilters.at(it.first), fromPkg_, fromProject_, it.second, mode_ );
+		// Creates the configuration if needed:
+		computeConfiguration( premakeFilters[filter], fromPkg_, fromProject_, config, mode_ );
 	}
 }
 
@@ -355,81 +249,6 @@ auto Project::getPrimaryArtifact() const
 	}
 }
 
-///////////////////////////////////////////////////
-void Package::loadPackageSpecificInfo(json const& json_)
-{
-	name 			= json_["name"].get<String>();
-	startupProject	= json_.value("startupProject", "");
-	version 		= Version::fromString( json_.value("version", "0") );
-
-	if (json_.contains("cmake"))
-		isCMake = json_.value("cmake", false);
-	else
-		isCMake = false;
-
-	readTargetEventHandlers(useApp(), json_, *this);
-}
-
-///////////////////////////////////////////////////
-void Package::loadWorkspaceInfo(json const& json_)
-{
-	using json_vt = json::value_t;
-
-	auto projectsNode = json_.find("projects");
-
-	// projects.reserve(projectsNode->size());
-
-	// Read projects:
-	for(auto it : projectsNode->items())
-	{
-		auto& jsonProject = it.value();
-
-		Project project;
-
-		project.name = jsonProject["name"].get<String>();
-		project.type = parseProjectType(jsonProject["type"].get<String>());
-
-		readTargetEventHandlers(useApp(), jsonProject, project);
-
-		if (auto it = jsonProject.find("pch"); it != jsonProject.end())
-		{
-			PrecompiledHeader pch;
-			// TODO: add validation
-			pch.header		= jsonProject["pch"]["header"];
-			pch.source		= jsonProject["pch"]["source"];
-			pch.definition 	= jsonProject["pch"]["definition"];
-			project.pch = std::move(pch);
-		}
-
-		// TODO: type and value validation
-		if (auto it = jsonProject.find("language"); it != jsonProject.end())
-			project.language = it->get<String>();
-
-		loadConfigurationFromJSON(*this, project, project, jsonProject);
-
-		json const* filters = expectSub<json_vt::object>(jsonProject, "filters");
-		if (filters)
-		{
-			for(auto filterIt : filters->items())
-			{
-				auto const& val = filterIt.value();
-				if (val.type() == json_vt::object)
-				{
-					// Create and reference the configuration:
-					Configuration& cfg = project.premakeFilters[filterIt.key()];
-					loadConfigurationFromJSON(*this, project, cfg, val);
-				}
-			}
-		}
-
-		projects.emplace_back(std::move(project));
-	}
-
-	if (isCMake) {
-		plugins::cmake::runBuildInfoQuery(root.parent_path());
-	}
-}
-
 ///////////////////////////////////////////////////
 auto Package::preload(Path dir_)
 	-> PackagePreloadInfo
@@ -462,11 +281,28 @@ auto Package::load(PackagePreloadInfo preloadInfo_)
 	// Decide what to do:
 	if (preloadInfo_.usesJsonConfig())
 	{
+		// Served by the daemon (script packages can change their contents on every load)
+		auto& cache		= packageCache();
+		auto cacheable	= cache.enabled && !preloadInfo_.usesScriptFile();
+
+		if (cacheable)
+		{
+			if (auto cached = cache.take(preloadInfo_.root))
+				return cached;
+		}
+
 		pkg = std::make_unique<Package>();
 		pkg->root		= std::move(preloadInfo_.root);
 		pkg->scriptFile	= std::move(preloadInfo_.scriptFile);
 
+		auto span = tracing::Span("readPackageJson", "load");
+		span.arg("path", pkg->root.string());
+
+		// Read, not mapped: the manifest may be truncated by an editor while it is read
 		Package::loadFromJSON(*pkg, readFileContents(pkg->root));
+
+		if (cacheable && !pkg->isCMake)
+			cache.recordMiss(pkg->root);
 	}
 	else // Lua config
 	{
@@ -482,12 +318,36 @@ auto Package::load(PackagePreloadInfo preloadInfo_)
 auto Package::findProject(StringView name_) const
 	-> Project const*
 {
-	auto it = rg::find(projects, name_, &Project::name);
+	if (numIndexedProjects != projects.size())
+		this->reindexProjects();
+
+	auto it = projectIndex.find(name_);
+	if (it == projectIndex.end())
+		return nullptr;
 
-	if (it != projects.end())
-		return &(*it);
+	// Project could have been renamed after indexing:
+	if (projects[it->second].name != name_)
+	{
+		this->reindexProjects();
 
-	return nullptr;
+		it = projectIndex.find(name_);
+		if (it == projectIndex.end())
+			return nullptr;
+	}
+
+	return &projects[it->second];
+}
+
+///////////////////////////////////////////////////
+void Package::reindexProjects() const
+{
+	projectIndex.clear();
+	projectIndex.reserve(projects.size());
+
+	for (std::size_t i = 0; i < projects.size(); ++i)
+		projectIndex.try_emplace(projects[i].name, i); // first project wins
+
+	numIndexedProjects = projects.size();
 }
 
 ///////////////////////////////////////////////////
@@ -557,73 +417,14 @@ auto Package::resolvePath( Path const& path_) const
 }
 
 ///////////////////////////////////////////////////
-void loadConfigurationFromJSON(Package & pkg_, Project & project_, Configuration& conf_, json const& root_)
-{
-	using fmt::fg, fmt::color;
-	using json_vt = json::value_t;
-
-	auto jv = JsonView{root_};
-
-	conf_.symbolVisibility 		= GNUSymbolVisibility::fromString(root_.value("symbolVisibility", "Default"));
-	conf_.moduleDefinitionFile 	= root_.value("moduleDefinitionFile", "");
-
-	bool isInterface = (project_.type == Project::Type::Interface);
-
-	AccessType defaultAccess = isInterface ? AccessType::Interface : AccessType::Private;
-
-	conf_.files		 			= loadVecOfStrField(root_, "files");
-	conf_.defines.self	 		= loadVecOfStrAccField(root_, "defines", 			defaultAccess);
-	conf_.includeFolders.self	= loadVecOfStrAccField(root_, "includeFolders",		defaultAccess);
-	conf_.linkerFolders.self	= loadVecOfStrAccField(root_, "linkerFolders", 		defaultAccess);
-	conf_.compilerOptions.self	= loadVecOfStrAccField(root_, "compilerOptions", 	defaultAccess);
-	conf_.linkerOptions.self	= loadVecOfStrAccField(root_, "linkerOptions", 		defaultAccess);
-
-	// Load dependencies:
-	auto depsIt = root_.find("dependencies");
-	if (depsIt != root_.end())
-	{
-		auto& deps = depsIt.value();
-		auto& projSelfDeps = conf_.dependencies.self;
-		if (deps.type() == json_vt::array)
-		{
-			readDependencyAccess(pkg_, project_, *depsIt, targetByAccessType(projSelfDeps, defaultAccess));
-		}
-		else if (deps.type() == json_vt::object)
-		{
-			if (isInterface)
-			{
-				if (deps.contains("public") || deps.contains("private"))
-					fmt::print(fg(color::yellow), "Interface project \"{}\" cannot include public or private dependencies (ignored).", project_.name);
-			}
-			else
-			{
-				if (deps.contains("public")) readDependencyAccess(pkg_, project_, deps["public"], projSelfDeps.public_);
-				if (deps.contains("private")) readDependencyAccess(pkg_, project_, deps["private"], projSelfDeps.private_);
-			}
-
-			if (deps.contains("interface")) readDependencyAccess(pkg_, project_, deps["interface"], projSelfDeps.interface_);
-		}
-		else
-			throw PaccException("Invalid type of \"dependencies\" field (must be an array or an object)");
-	}
-}
-
-///////////////////////////////////////////////////
-auto Package::loadFromJSON(Package& package_, String const& packageContent_)
+auto Package::loadFromJSON(Package& package_, StringView packageContent_)
 	-> bool
 {
-	using json_vt = json::value_t;
-
-	// Parse and make conformant:
-	json j;
-	auto view = PackageJsonReader{ j };
+	readPackageJson(package_, packageContent_);
 
-	j = json::parse(packageContent_);
-	view.makeConformant();
-
-	// Load JSON:
-	package_.loadPackageSpecificInfo(j);
-	package_.loadWorkspaceInfo(j);
+	if (package_.isCMake) {
+		plugins::cmake::runBuildInfoQuery(package_.root.parent_path());
+	}
 
 	return true;
 }
@@ -646,10 +447,7 @@ auto getNumElements(VecOfStrAcc const& v)
 /////////////////////////////////////////////////
 void computeConfiguration(Configuration& into_, Package const& fromPkg_, Project const& fromProject_, Configuration const& from_, AccessType mode_)
 {
-	auto resolvePath = [&](auto const& pathLikeElem)
-		{
-			return fromPkg_.resolvePath(Path(pathLikeElem)).string();
-		};
+	auto resolvePath = policies::ResolvePath{ fromPkg_.root.parent_path() };
 
 	mergeAccesses(into_.defines, 			from_.defines, 		 		mode_);
 	mergeAccesses(into_.includeFolders, 	from_.includeFolders,  		mode_, resolvePath);
@@ -658,256 +456,3 @@ void computeConfiguration(Configuration& into_, Package const& fromPkg_, Project
 	mergeAccesses(into_.compilerOptions, 	from_.compilerOptions, 		mode_);
 	mergeAccesses(into_.linkerOptions, 		from_.linkerOptions, 		mode_);
 }
-
-///////////////////////////////////////////////////
-// Private functions
-///////////////////////////////////////////////////
-
-///////////////////////////////////////////////////
-void readDependencyAccess(Package &pkg_, Project & proj_, json const& deps_, Vec<Dependency> &target_)
-{
-	using json_vt = json::value_t;
-
-	if (deps_.type() != json_vt::array)
-		throw PaccException("invalid type of dependencies subfield - array required");
-
-	target_.reserve(deps_.size());
-
-	for(auto item : deps_.items())
-	{
-		if (json const* rawDep = expect<json_vt::string>(item.value()))
-		{
-			String depPattern = rawDep->get<String>();
-			if (startsWith(depPattern, "file:"))
-			{
-				target_.push_back( Dependency::raw( depPattern.substr(5) ) );
-			}
-			else if (startsWith(depPattern, "self:"))
-			{
-				auto sd = SelfDependency { &proj_, depPattern.substr(5), &pkg_ };
-				target_.push_back( Dependency::self( std::move(sd) ) );
-			}
-			else
-			{
-				DownloadLocation loc = DownloadLocation::parse(depPattern);
-
-				PackageDependency pd;
-				pd.packageName 		= loc.repository;
-
-				try {
-					pd.version = VersionReq::fromString(loc.branch);
-				}
-				catch(...) {} // just ignore
-
-				pd.projects.push_back(loc.repository);
-				pd.downloadLocation = std::move(depPattern);
-
-				target_.push_back(
-						Dependency::package( std::move(pd) )
-					);
-			}
-		}
-		else if (json const* pkgDep = expect<json_vt::object>(item.value()))
-		{
-			// Required fields:
-			json const& name		= requireSub<json_vt::string>(*pkgDep, "name");
-			json const* projects	= expectSub<json_vt::array>(*pkgDep, "projects");
-			// Optional fields:
-			json const* version		= expectSub<json_vt::string>(*pkgDep, "version");
-
-			// Configure dependency:
-			PackageDependency pd;
-
-			// Required:
-			pd.packageName = name;
-
-			// Parse download location:
-			pd.downloadLocation = pkgDep->value("from", "");
-			auto loc = DownloadLocation::parse(pd.downloadLocation);
-
-			if (projects)
-			{
-				pd.projects.reserve(projects->size());
-				for(auto proj : projects->items())
-				{
-					json const& projName = require<json_vt::string>(proj.value());
-
-					pd.projects.push_back(projName.get<String>());
-				}
-			}
-			else
-			{
-				String originalName;
-
-				if (!loc.repository.empty())
-					originalName = loc.repository;
-				else
-					originalName = name;
-
-				pd.projects.emplace_back(std::move(originalName));
-			}
-
-			// Optional
-			if (version)
-			{
-				try {
-					pd.version = VersionReq::fromString(version->get<String>());
-				}
-				catch (...) {
-					pd.version.type = VersionReq::Any;
-				}
-			}
-
-			target_.push_back(
-					Dependency::package( std::move(pd) )
-				);
-		}
-		else
-			throw PaccException("Invalid dependency type");
-	}
-
-
-}
-
-
-///////////////////////////////////////////////////
-auto selfOrSubfieldOpt(json const &self, StringView fieldName)
-	-> json const*
-{
-	if (fieldName == "")
-		return &self;
-	else
-	{
-		if (auto it = self.find(fieldName); it != self.end())
-			return &it.value();
-	}
-
-	return nullptr;
-}
-
-///////////////////////////////////////////////////
-auto selfOrSubfieldReq(json const &self, StringView fieldName)
-	-> json const&
-{
-	json const* v = selfOrSubfieldOpt(self, fieldName);
-	if (!v)
-		throw PaccException("field {0} not found", fieldName);
-	else
-		return *v;
-}
-
-///////////////////////////////////////////////////
-auto selfOrSubfield(json const &self, StringView fieldName, bool required)
-	-> json const*
-{
-	if (required)
-		return &selfOrSubfieldReq(self, fieldName);
-	else
-		return selfOrSubfieldOpt(self, fieldName);
-}
-
-///////////////////////////////////////////////////
-auto loadVecOfStrField(json const &j, StringView fieldName, bool direct, bool required)
-	-> Vec<String>
-{
-	using JV = JsonView;
-
-	Vec<String> result;
-	String const elemName = String(fieldName) + " element";
-
-	// Either subfield or the `j` itself (direct => `j` is an array)
-	json const* val = selfOrSubfield(j, direct ? "" : fieldName, required);
-
-	// Can be null if `required` == false
-	if (!val)
-		return result;
-
-	if (val->type() == json::value_t::string)
-	{
-		result.push_back(*val);
-	}
-	else
-	{
-		JV(*val).requireType(fieldName, json::value_t::array);
-
-		// Read the array:
-		result.reserve(val->size());
-
-		for(auto elem : val->items())
-		{
-			JV{elem.value()}.requireType(elemName, json::value_t::string);
-			result.push_back(elem.value());
-		}
-	}
-	return result;
-}
-
-///////////////////////////////////////////////////
-auto loadVecOfStrAccField(json const &j, StringView fieldName, AccessType defaultAccess_)
-	-> VecOfStrAcc
-{
-	VecOfStrAcc result;
-	if (auto it = j.find(fieldName); it != j.end())
-	{
-		json::value_t type = it.value().type();
-		if (type == json::value_t::array || type == json::value_t::string)
-			targetByAccessType(result, defaultAccess_) = loadVecOfStrField(*it, fieldName, true);
-		else
-		{
-			result.private_ 	= loadVecOfStrField(*it, "private");
-			result.public_ 		= loadVecOfStrField(*it, "public");
-			result.interface_ 	= loadVecOfStrField(*it, "interface");
-		}
-	}
-	return result;
-}
-
-///////////////////////////////////////////////////
-template <json::value_t type>
-auto expect(json const &j)
-	-> json const*
-{
-	if (j.type() == type)
-		return &j;
-	else
-		return nullptr;
-}
-
-///////////////////////////////////////////////////
-template <json::value_t type>
-auto expectSub(json const &j, StringView subfieldName)
-	-> json const*
-{
-	auto it = j.find(subfieldName);
-	if (it != j.end() && it->type() == type)
-	{
-		return (&(*it));
-	}
-
-	return nullptr;
-}
-
-///////////////////////////////////////////////////
-template <json::value_t type>
-auto require(json const &j)
-	-> json const&
-{
-	if (j.type() == type)
-		return j;
-	else
-		throw PaccException("invalid type");
-}
-
-///////////////////////////////////////////////////
-template <json::value_t type>
-auto requireSub(json const &j, StringView subfieldName)
-	-> json const&
-{
-	auto it = j.find(subfieldName);
-	if (it != j.end() && it->type() == type)
-	{
-		return (*it);
-	}
-
-	throw PaccException("invalid subfield type");
-}
@@ -0,0 +1,77 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/PackageSystem/PackageCache.hpp>
+#include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/System/Filesystem.hpp>
+
+///////////////////////////////////////////////////
+static auto cacheKey(Path const& path_) -> String
+{
+	return fsx::fwd(fs::absolute(path_).lexically_normal()).string();
+}
+
+///////////////////////////////////////////////////
+PackageCache::PackageCache() = default;
+
+///////////////////////////////////////////////////
+PackageCache::~PackageCache() = default;
+
+///////////////////////////////////////////////////
+auto PackageCache::take(Path const& root_)
+	-> UPtr<Package>
+{
+	auto it = packages.find(cacheKey(root_));
+	if (it == packages.end())
+		return nullptr;
+
+	auto pkg = std::move(it->second);
+	packages.erase(it);
+
+	// Keep the path in the form it was requested with
+	pkg->root = root_;
+	return pkg;
+}
+
+///////////////////////////////////////////////////
+void PackageCache::store(UPtr<Package> package_)
+{
+	auto key = cacheKey(package_->root);
+	packages[std::move(key)] = std::move(package_);
+}
+
+///////////////////////////////////////////////////
+void PackageCache::invalidateFolder(Path const& folder_)
+{
+	auto folder = cacheKey(folder_);
+
+	std::erase_if(packages, [&](auto const& entry) {
+			return fsx::fwd(Path(entry.first).parent_path()).string() == folder;
+		});
+}
+
+///////////////////////////////////////////////////
+void PackageCache::clear()
+{
+	packages.clear();
+	misses.clear();
+}
+
+///////////////////////////////////////////////////
+void PackageCache::recordMiss(Path const& root_)
+{
+	misses.push_back(fs::absolute(root_).lexically_normal());
+}
+
+///////////////////////////////////////////////////
+auto PackageCache::takeMisses()
+	-> Vec<Path>
+{
+	return std::exchange(misses, {});
+}
+
+///////////////////////////////////////////////////
+auto packageCache() -> PackageCache&
+{
+	static PackageCache cache;
+	return cache;
+}
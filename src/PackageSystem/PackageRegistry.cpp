@@ -0,0 +1,290 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/PackageSystem/PackageRegistry.hpp>
+#include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/System/FileView.hpp>
+#include <Pacc/Helpers/Parallel.hpp>
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto folderKey(Path const& path_) -> String;
+static auto writeTimeOf(Path const& path_) -> int64_t;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+PackageRegistry::PackageRegistry(Path storageFile_)
+	: storageFile(std::move(storageFile_))
+{
+}
+
+///////////////////////////////////////////////////
+auto PackageRegistry::find(Path const& packagesFolder_, StringView name_)
+	-> Opt<Entry>
+{
+	auto folder = this->folderOf(packagesFolder_);
+	if (!folder)
+		return std::nullopt;
+
+	auto it = folder->packages.find(name_);
+	if (it == folder->packages.end())
+		return std::nullopt;
+
+	return this->refreshed(it->second);
+}
+
+///////////////////////////////////////////////////
+auto PackageRegistry::packagesIn(Path const& packagesFolder_)
+	-> Vec<Entry>
+{
+	auto result = Vec<Entry>();
+
+	auto folder = this->folderOf(packagesFolder_);
+	if (!folder)
+		return result;
+
+	// Copy first, refreshing can modify the folder:
+	auto entries = Vec<Entry>();
+	entries.reserve(folder->packages.size());
+	for (auto const& [name, entry] : folder->packages)
+		entries.push_back(entry);
+
+	result.reserve(entries.size());
+	for (auto& entry : entries)
+	{
+		if (auto current = this->refreshed(std::move(entry)))
+			result.push_back(std::move(*current));
+	}
+
+	rg::sort(result, {}, &Entry::name);
+	return result;
+}
+
+///////////////////////////////////////////////////
+void PackageRegistry::update(Path const& packagesFolder_, StringView name_)
+{
+	auto folder = this->folderOf(packagesFolder_);
+	if (!folder)
+		return;
+
+	if (auto entry = readEntry(packagesFolder_ / name_))
+		folder->packages.insert_or_assign(String(name_), std::move(*entry));
+	else
+		folder->packages.erase(String(name_));
+
+	// The change is already reflected, do not rescan the folder because of it:
+	folder->time = writeTimeOf(packagesFolder_);
+	this->save();
+}
+
+///////////////////////////////////////////////////
+void PackageRegistry::remove(Path const& packagesFolder_, StringView name_)
+{
+	auto folder = this->folderOf(packagesFolder_);
+	if (!folder)
+		return;
+
+	folder->packages.erase(String(name_));
+
+	folder->time = writeTimeOf(packagesFolder_);
+	this->save();
+}
+
+///////////////////////////////////////////////////
+void PackageRegistry::invalidate()
+{
+	for (auto& [path, folder] : folders)
+		folder.checked = false;
+}
+
+///////////////////////////////////////////////////
+auto PackageRegistry::readEntry(Path const& location_)
+	-> Opt<Entry>
+{
+	if (!fsx::dirCache().isDirectory(location_))
+		return std::nullopt;
+
+	auto entry = Entry();
+	entry.name 		= location_.filename().string();
+	entry.location 	= fs::absolute(location_).lexically_normal();
+	entry.isLink 	= fsx::isSymlinkOrJunction(location_);
+	entry.manifest 	= findPackageFile(entry.location);
+
+	if (entry.manifest.empty())
+		return entry; // f.e. a CMake package, has to be loaded to know the version.
+
+	entry.manifestTime = writeTimeOf(entry.manifest);
+
+	// Invalid manifest leaves the version unknown, loading will report the error.
+	if (entry.manifest.extension() == ".json")
+	{
+		if (auto metadata = readPackageMetadata(entry.manifest))
+			entry.version = metadata->version;
+	}
+
+	return entry;
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto PackageRegistry::folderOf(Path const& packagesFolder_)
+	-> Folder*
+{
+	if (!loaded)
+		this->load();
+
+	if (!fsx::dirCache().isDirectory(packagesFolder_))
+		return nullptr;
+
+	auto& folder = folders[folderKey(packagesFolder_)];
+
+	if (!folder.checked)
+	{
+		auto time = writeTimeOf(packagesFolder_);
+		if (time != folder.time)
+		{
+			this->rescan(folder, packagesFolder_, time);
+			this->save();
+		}
+		folder.checked = true;
+	}
+
+	return &folder;
+}
+
+///////////////////////////////////////////////////
+void PackageRegistry::rescan(Folder& folder_, Path const& path_, int64_t time_)
+{
+	folder_.packages.clear();
+	folder_.time = time_;
+
+	auto paths = Vec<Path>();
+
+	auto ec = std::error_code{};
+	for (auto it = fs::directory_iterator(path_, ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+		paths.push_back(it->path());
+
+	// Read the manifests in parallel:
+	auto entries = Vec<Opt<Entry>>(paths.size());
+	parallelFor(paths.size(), [&](std::size_t i_) { entries[i_] = readEntry(paths[i_]); });
+
+	for (auto& entry : entries)
+	{
+		if (entry)
+			folder_.packages.insert_or_assign(entry->name, std::move(*entry));
+	}
+}
+
+///////////////////////////////////////////////////
+auto PackageRegistry::refreshed(Entry entry_)
+	-> Opt<Entry>
+{
+	if (entry_.manifest.empty() || writeTimeOf(entry_.manifest) == entry_.manifestTime)
+		return entry_;
+
+	// Manifest changed (or was removed) since the last scan:
+	auto current 	= readEntry(entry_.location);
+	auto& folder 	= folders[folderKey(entry_.location.parent_path())];
+
+	if (current)
+		folder.packages.insert_or_assign(entry_.name, *current);
+	else
+		folder.packages.erase(entry_.name);
+
+	this->save();
+	return current;
+}
+
+///////////////////////////////////////////////////
+void PackageRegistry::load()
+{
+	loaded = true;
+
+	if (!fs::is_regular_file(storageFile))
+		return;
+
+	try {
+		auto j = json::parse(FileView(storageFile));
+
+		for (auto const& [key, jsonFolder] : j.at("folders").items())
+		{
+			auto& folder = folders[key];
+			folder.time = jsonFolder.at("time").get<int64_t>();
+
+			for (auto const& [name, jsonEntry] : jsonFolder.at("packages").items())
+			{
+				auto entry = Entry();
+				entry.name 			= name;
+				entry.location 		= jsonEntry.at("location").get<String>();
+				entry.manifest 		= jsonEntry.value("manifest", "");
+				entry.isLink 		= jsonEntry.value("link", false);
+				entry.manifestTime 	= jsonEntry.value("manifestTime", int64_t(0));
+
+				if (auto it = jsonEntry.find("version"); it != jsonEntry.end() && it->is_string())
+					entry.version = Version::fromString(it->get<String>());
+
+				folder.packages.insert_or_assign(name, std::move(entry));
+			}
+		}
+	}
+	catch(...) {
+		// Broken index, start from scratch.
+		folders.clear();
+	}
+}
+
+///////////////////////////////////////////////////
+void PackageRegistry::save() const
+{
+	auto j = json::object();
+	auto& jsonFolders = j["folders"] = json::object();
+
+	for (auto const& [key, folder] : folders)
+	{
+		auto& jsonFolder = jsonFolders[key] = json::object();
+		jsonFolder["time"] = folder.time;
+
+		auto& jsonPackages = jsonFolder["packages"] = json::object();
+		for (auto const& [name, entry] : folder.packages)
+		{
+			auto& jsonEntry = jsonPackages[name] = json::object();
+			jsonEntry["location"] 		= fsx::fwd(entry.location).string();
+			jsonEntry["manifest"] 		= fsx::fwd(entry.manifest).string();
+			jsonEntry["link"] 			= entry.isLink;
+			jsonEntry["manifestTime"] 	= entry.manifestTime;
+			if (entry.version)
+				jsonEntry["version"] = entry.version->toString();
+		}
+	}
+
+	// Other pacc processes map the file while reading it, it must not be truncated under them
+	fsx::replaceFile(storageFile, j.dump(1, '\t'));
+}
+
+///////////////////////////////////////////////////
+static auto folderKey(Path const& path_) -> String
+{
+	auto ec = std::error_code{};
+	auto canonical = fs::weakly_canonical(path_, ec);
+
+	return fsx::fwd(ec ? fs::absolute(path_).lexically_normal() : canonical).string();
+}
+
+///////////////////////////////////////////////////
+static auto writeTimeOf(Path const& path_) -> int64_t
+{
+	auto ec = std::error_code{};
+	auto time = fs::last_write_time(path_, ec);
+
+	return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
@@ -3,8 +3,13 @@
 #include <Pacc/Plugins/CMake.hpp>
 
 #include <Pacc/System/Process.hpp>
+#include <Pacc/System/Environment.hpp>
+#include <Pacc/Build/DistributedBuild.hpp>
 #include <Pacc/Helpers/Exceptions.hpp>
+#include <Pacc/System/FileView.hpp>
 #include <Pacc/Readers/General.hpp>
+#include <Pacc/Helpers/Hash.hpp>
+#include <Pacc/Helpers/Parallel.hpp>
 #include <Pacc/App/App.hpp>
 
 namespace plugins::cmake
@@ -12,6 +17,8 @@ namespace plugins::cmake
 
 constexpr StringView TargetHashSeparator		= "::@";
 constexpr StringView CacheProjectVersionKey	= "CMAKE_PROJECT_VERSION:STATIC=";
+constexpr StringView CacheBuildTypeKey			= "CMAKE_BUILD_TYPE:STRING=";
+constexpr StringView CacheGeneratorKey			= "CMAKE_GENERATOR:INTERNAL=";
 
 ///////////////////////////////////////
 static inline ProjectType projectTypeFromString(String const& str_)
@@ -46,6 +53,82 @@ static inline auto replyFolderOf(fs::path const& packagePath_)
 	return buildFolderOf(packagePath_) / ".cmake" / "api" / "v1" / "reply";
 }
 
+///////////////////////////////////////
+static inline auto queryFingerprintFileOf(fs::path const& packagePath_)
+{
+	return buildFolderOf(packagePath_) / "pacc_query.fingerprint";
+}
+
+///////////////////////////////////////
+static inline auto isMultiConfigGenerator(StringView generator_)
+{
+	return generator_.starts_with("Visual Studio") || generator_ == "Ninja Multi-Config" || generator_ == "Xcode";
+}
+
+///////////////////////////////////////
+/// <summary>Reads the value of the <c>key_</c> (with the type, f.e. "NAME:STRING=") from the CMakeCache.txt.</summary>
+static auto readCacheValue(fs::path const& packagePath_, StringView key_) -> Opt<String>
+{
+	auto cacheFile = buildFolderOf(packagePath_) / "CMakeCache.txt";
+	if (!fs::exists(cacheFile))
+		return std::nullopt;
+
+	auto cache = FileView(cacheFile);
+	auto view = cache.view();
+
+	// The key has to start a line
+	auto pos = view.find(key_);
+	while (pos != StringView::npos && pos > 0 && view[pos - 1] != '\n')
+		pos = view.find(key_, pos + 1);
+
+	if (pos == StringView::npos)
+		return std::nullopt;
+
+	auto valueStart = pos + key_.size();
+	auto value = view.substr(valueStart, view.find('\n', valueStart) - valueStart);
+	if (value.ends_with('\r'))
+		value.remove_suffix(1);
+
+	return String(value);
+}
+
+///////////////////////////////////////
+/// <summary>Generator of the toolchain or of the currently selected one.</summary>
+static auto selectGenerator(Toolchain const* toolchain_) -> String
+{
+	if (!toolchain_)
+		toolchain_ = useApp().cfg.currentToolchain();
+
+	return toolchain_ ? toolchain_->cmakeGenerator() : "";
+}
+
+///////////////////////////////////////
+/// <summary>Arguments of the configure step (generator and cache variables).</summary>
+static auto configureArgs(StringView generator_, BuildSettings const& settings_) -> String
+{
+	auto args = String("-D BUILD_SHARED_LIBS=0");
+
+	if (!generator_.empty())
+		args += fmt::format(" -G \"{}\"", generator_);
+
+	// Visual Studio names the x86 platform "Win32"
+	if (generator_.starts_with("Visual Studio"))
+		args += fmt::format(" -A {}", settings_.platformName == "x86" ? "Win32" : settings_.platformName);
+
+	// Multi-config generators select the configuration when building
+	if (!isMultiConfigGenerator(generator_))
+		args += fmt::format(" -D CMAKE_BUILD_TYPE={}", settings_.configName);
+
+	// Links run through the pacc launcher, which waits for a slot of the link pool (Makefile and Ninja generators, CMake 3.21+)
+	if (settings_.linkPool && !generator_.starts_with("Visual Studio") && !generator_.starts_with("Xcode"))
+	{
+		auto launcher = fmt::format("{};{}", env::getPaccAppPath().string(), distributed::LauncherAction);
+		args += fmt::format(" -D \"CMAKE_C_LINKER_LAUNCHER={0}\" -D \"CMAKE_CXX_LINKER_LAUNCHER={0}\"", launcher);
+	}
+
+	return args;
+}
+
 ///////////////////////////////////////
 void createQueryFile(fs::path const& packagePath_)
 {
@@ -58,9 +141,12 @@ void createQueryFile(fs::path const& packagePath_)
 }
 
 ///////////////////////////////////////
-json readReplyFile(fs::path const& root_)
+auto findReplyFile(fs::path const& root_) -> fs::path
 {
 	auto replyFolder = replyFolderOf(root_);
+	if (!fs::is_directory(replyFolder))
+		return {};
+
 	// find reply file
 	fs::path replyFile;
 	for (auto entry : fs::directory_iterator(replyFolder))
@@ -74,18 +160,66 @@ json readReplyFile(fs::path const& root_)
 		}
 	}
 
+	return replyFile;
+}
+
+///////////////////////////////////////
+json readReplyFile(fs::path const& root_)
+{
+	auto replyFile = findReplyFile(root_);
 	if (replyFile.empty())
 		return {};
 
-	return json::parse(readFileContents(replyFile));
+	return json::parse(FileView(replyFile));
+}
+
+///////////////////////////////////////
+/// <summary>
+/// 	Hash of everything the configure step reads: the generator, cache variables
+/// 	and all CMakeLists.txt and *.cmake files of the package (except the build folder).
+/// </summary>
+auto computeQueryFingerprint(fs::path const& packagePath_, StringView configureArgs_) -> String
+{
+	auto buildFolder = buildFolderOf(packagePath_);
+
+	auto inputs = Vec<fs::path>();
+
+	auto ec = std::error_code{};
+	for (auto it = fs::recursive_directory_iterator(packagePath_, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+	{
+		auto const& path = it->path();
+
+		if (it->is_directory(ec))
+		{
+			// Skip the build folder and hidden ones (f.e. ".git")
+			if (path == buildFolder || path.filename().string().starts_with('.'))
+				it.disable_recursion_pending();
+			continue;
+		}
+
+		if (path.filename() == "CMakeLists.txt" || path.extension() == ".cmake")
+			inputs.push_back(path);
+	}
+
+	// Iteration order is unspecified
+	rg::sort(inputs);
+
+	auto hash = Fnv1a{};
+	hash.add(configureArgs_);
+	for (auto const& input : inputs)
+	{
+		hash.add(fsx::fwd(input.lexically_relative(packagePath_)).string());
+		hash.add(readFileContents(input)); // edited by the user, not mapped
+	}
+
+	return hash.hex();
 }
 
 
 ///////////////////////////////////////
 auto runCMakeCommand(fs::path const& packagePath_, StringView command_)
 {
-	String generator = "Visual Studio 17 2022";
-	auto command = fmt::format("cmake -G=\"{}\" {} ..", generator, command_);
+	auto command = fmt::format("cmake {} ..", command_);
 	auto proc = ChildProcess{
 			command,
 			packagePath_ / "build", ch::seconds{2 * 60}
@@ -97,9 +231,13 @@ auto runCMakeCommand(fs::path const& packagePath_, StringView command_)
 }
 
 ///////////////////////////////////////
-auto runCMakeBuildCommand(fs::path const& packagePath_, StringView commandOpt_ = "")
+auto runCMakeBuildCommand(fs::path const& packagePath_, BuildSettings const& settings_, Toolchain const& toolchain_)
 {
-	auto command = fmt::format("cmake --build .", commandOpt_);
+	auto command = fmt::format("cmake --build . --config {}", settings_.configName);
+
+	// The generated build takes the jobs from the jobserver in MAKEFLAGS otherwise
+	if (!settings_.sharedJobServer || !toolchain_.cmakeGeneratorSupportsJobServer())
+		command += fmt::format(" --parallel {}", settings_.cores.value_or( int(std::max(1u, std::thread::hardware_concurrency())) ));
 	auto proc = ChildProcess{
 			command,
 			packagePath_ / "build", ch::seconds{15 * 60}
@@ -111,15 +249,39 @@ auto runCMakeBuildCommand(fs::path const& packagePath_, StringView commandOpt_ =
 }
 
 ///////////////////////////////////////
-BuildInfo runBuildInfoQuery(fs::path const& packagePath_)
+BuildInfo runBuildInfoQuery(fs::path const& packagePath_, BuildSettings const& settings_, Toolchain const* toolchain_)
 {
 	BuildInfo result;
+	auto ec = std::error_code{};
+
+	auto generator 	= selectGenerator(toolchain_);
+	auto args 		= configureArgs(generator, settings_);
+
+	// Configure only when its inputs changed since the last query:
+	auto fingerprint 		= computeQueryFingerprint(packagePath_, args);
+	auto fingerprintFile 	= queryFingerprintFileOf(packagePath_);
+
+	if (fs::exists(fingerprintFile) && FileView(fingerprintFile).view() == fingerprint && !findReplyFile(packagePath_).empty())
+		return result;
+
+	// CMake refuses to configure an existing build folder with a different generator:
+	if (auto cachedGenerator = readCacheValue(packagePath_, CacheGeneratorKey); cachedGenerator && !generator.empty() && *cachedGenerator != generator)
+	{
+		fs::remove(buildFolderOf(packagePath_) / "CMakeCache.txt", ec);
+		fs::remove_all(buildFolderOf(packagePath_) / "CMakeFiles", ec);
+	}
 
 	createQueryFile(packagePath_);
 
-	auto cmakeResult = runCMakeCommand(packagePath_, " -D BUILD_SHARED_LIBS=0 -D CMAKE_BUILD_TYPE=Debug");
+	auto cmakeResult = runCMakeCommand(packagePath_, args);
 	if (!cmakeResult.has_value() || cmakeResult.value() != 0)
+	{
+		// Do not reuse a reply of a failed configure
+		fs::remove(fingerprintFile, ec);
 		throw PaccException("CMake build info query failed");
+	}
+
+	std::ofstream(fingerprintFile, std::ios::binary) << fingerprint;
 
 	return result;
 }
@@ -127,10 +289,15 @@ BuildInfo runBuildInfoQuery(fs::path const& packagePath_)
 ///////////////////////////////////////
 UPtr<Package> PackageLoader::load(fs::path const& root_)
 {
-	runBuildInfoQuery(root_);
+	// Keep the configuration of the last configure, so that building does not have to configure again.
+	auto settings = BuildSettings();
+	if (auto buildType = readCacheValue(root_, CacheBuildTypeKey); buildType && !buildType->empty())
+		settings.configName = *buildType;
+
+	runBuildInfoQuery(root_, settings);
 
 	auto reply		= readReplyFile(root_);
-	auto targets	= this->discoverTargets(reply);
+	auto targets	= this->discoverTargets(reply, settings.configName);
 
 	auto package = std::make_unique<Package>();
 	package->root = root_;
@@ -140,11 +307,20 @@ UPtr<Package> PackageLoader::load(fs::path const& root_)
 
 	fmt::print("Package version: {}\n", package->version.toString());
 
-	for (auto const&[name, path] : targets)
+	// Target files are independent, parse them in parallel:
+	auto replyFolder = replyFolderOf(root_);
+	package->projects.resize(targets.size());
+	parallelFor(targets.size(), [&](std::size_t i_) {
+			this->loadProjectFromFile(replyFolder / targets[i_].second, package->projects[i_]);
+		});
+
+	for (auto const& project : package->projects)
 	{
-		Project p;
-		this->loadProjectFromFile(replyFolderOf(root_) / path, p);
-		package->projects.emplace_back(std::move(p));
+		for (std::size_t i = 0; i < project.artifacts.size(); ++i)
+		{
+			for (auto const& path : project.artifacts[i])
+				fmt::print("Project {} (type: {}) -> {}\n", project.name, toString(project.type), path.string());
+		}
 	}
 
 	return package; // TODO: move loading logic from Package class
@@ -158,7 +334,7 @@ bool PackageLoader::loadTarget(fs::path const& root_, String const& name_, Targe
 }
 
 ///////////////////////////////////////
-Vec< StringPair > PackageLoader::discoverTargets(json const& json_) const
+Vec< StringPair > PackageLoader::discoverTargets(json const& json_, StringView configName_) const
 {
 	Vec< StringPair > result;
 	result.reserve(16);
@@ -167,7 +343,7 @@ Vec< StringPair > PackageLoader::discoverTargets(json const& json_) const
 
 	for (auto conf : confs)
 	{
-		if (conf.value("name", "") == "Debug")
+		if (conf.value("name", "") == configName_)
 		{
 			for (auto target : conf["targets"])
 			{
@@ -187,7 +363,7 @@ Vec< StringPair > PackageLoader::discoverTargets(json const& json_) const
 ///////////////////////////////////////
 bool PackageLoader::loadProjectFromFile(fs::path const& file_, Project& project_)
 {
-	auto json = json::parse(readFileContents(file_));
+	auto json = json::parse(FileView(file_));
 
 	project_.name = json.value("name", "");
 	project_.type = projectTypeFromString(json.value("type", "STATIC_LIBRARY"));
@@ -203,7 +379,6 @@ bool PackageLoader::loadProjectFromFile(fs::path const& file_, Project& project_
 				Artifact artType = detectArtifactTypeFromPath(path);
 
 				project_.artifacts[(size_t)artType].push_back(path);
-				fmt::print("Project {} (type: {}) -> {}\n", project_.name, toString(project_.type), path);
 			}
 		}
 	}
@@ -214,25 +389,20 @@ bool PackageLoader::loadProjectFromFile(fs::path const& file_, Project& project_
 ///////////////////////////////////////
 Version PackageLoader::loadVersion(fs::path const& root_)
 {
-	// read cmake cache
-	auto cacheFile = buildFolderOf(root_) / "CMakeCache.txt";
-	if (!fs::exists(cacheFile))
-		return {};
-
-	auto cache = readFileContents(cacheFile);
-	auto pos = cache.find(CacheProjectVersionKey);
-	if (pos == String::npos)
+	auto version = readCacheValue(root_, CacheProjectVersionKey);
+	if (!version)
 		return {};
 
-	auto endOfLine = cache.find('\n', pos);
-	auto view = StringView(cache);
-	return Version::fromString(view.substr(pos + CacheProjectVersionKey.size(), endOfLine - pos - CacheProjectVersionKey.size()));
+	return Version::fromString(*version);
 }
 
 ///////////////////////////////////////
 BuildProcessResult PackageBuilder::run(Package const& pkg_, Toolchain& tc_, BuildSettings const& settings_, int verbosityLevel_)
 {
-	return runCMakeBuildCommand(pkg_.root, "--config Debug");
+	// Configure again if the build settings differ from the last query:
+	runBuildInfoQuery(pkg_.root, settings_, &tc_);
+
+	return runCMakeBuildCommand(pkg_.root, settings_, tc_);
 }
 
 }
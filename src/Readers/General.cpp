@@ -13,11 +13,9 @@ String readFileContents(fs::path const& path_)
 
 
 	String result;
-	String buf;
-	buf.resize(4 * 1024 * 1024);
-	while(input.read(buf.data(), buf.capacity()))
-		result.append(buf.data(), input.gcount());
-	result.append(buf.data(), input.gcount());
+	char buf[64 * 1024];
+	while(input.read(buf, sizeof(buf)) || input.gcount() > 0)
+		result.append(buf, std::size_t(input.gcount()));
 
 	return result;
 }
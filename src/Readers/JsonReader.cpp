@@ -1,80 +1,1009 @@
 #include "include/Pacc/PaccPCH.hpp"
 
 #include <Pacc/Readers/JsonReader.hpp>
+#include <Pacc/App/App.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+#include <Pacc/Helpers/String.hpp>
 
+namespace
+{
+
+constexpr StringView WrongTypeMsg 	= "field \"{}\" expected to be of type \"{}\", but \"{}\" given instead";
+constexpr StringView NoFieldMsg 	= "field \"{}\" expected to be of type \"{}\" does not exist";
+
+/// <summary>Values of a field that uses the project's default access (known when the project is complete).</summary>
+template <typename T>
+struct DefaultAccessValues
+{
+	AccessSplitVec<T>* 	target = nullptr;
+	Vec<T> 				values = {};
+};
+
+/// <summary>Project read so far.</summary>
+struct ProjectDraft
+{
+	Project 	project;
+	Opt<json> 	name;
+	Opt<json> 	type;
+	Opt<json> 	language;
+	Opt<json> 	events;
+	Opt<json> 	unity;
+
+	std::deque<DefaultAccessValues<String>> 		defaultAccessStrings;
+	std::deque<DefaultAccessValues<Dependency>> 	defaultAccessDependencies;
+
+	// Object-form dependencies with "public" or "private" (ignored in interface projects):
+	Vec<AccessSplitVec<Dependency>*> 				splitDependencies;
+};
+
+/// <summary>Dependency in the object form, read so far.</summary>
+struct DependencyDraft
+{
+	Opt<json> 			name;
+	Opt<json> 			version;
+	Opt<json> 			from;
+	Opt<Vec<String>> 	projects;
+};
+
+enum class Frame
+{
+	Skip, 					// ignored value
+	Buffer, 				// value kept as JSON
+	Root, 					// root object: workspace or a single project
+	Projects, 				// workspace projects array
+	Project,
+	Pch,
+	Filters,
+	Configuration, 			// filter configuration
+	Strings, 				// array of strings
+	AccessStrings, 			// { "public": [], "private": [], "interface": [] }
+	Dependencies, 			// array of dependencies
+	AccessDependencies, 	// { "public": [], "private": [], "interface": [] }
+	PackageDependency, 		// dependency in the object form
+	DependencyProjects, 	// "projects" of the dependency in the object form
+};
+
+struct State
+{
+	Frame 		frame;
+	String 		key 		= {}; 	// last key read (object frames)
+	String 		fieldName 	= {}; 	// used in error messages
+	bool 		speculative = false;
+
+	ProjectDraft* 					project 		= nullptr;
+	Configuration* 					config 			= nullptr;
+	Vec<String>* 					strings 		= nullptr;
+	VecOfStrAcc* 					accessStrings 	= nullptr;
+	Vec<Dependency>* 				dependencies 	= nullptr;
+	AccessSplitVec<Dependency>* 	accessDeps 		= nullptr;
+	json* 							node 			= nullptr;
+};
+
+////////////////////////////////////
+auto containerTypeName(bool isObject_) -> StringView
+{
+	return isObject_ ? "object" : "array";
+}
+
+////////////////////////////////////
+auto accessStringsField(Configuration& config_, StringView key_) -> VecOfStrAcc*
+{
+	if (key_ == "defines") 			return &config_.defines.self;
+	if (key_ == "includeFolders") 	return &config_.includeFolders.self;
+	if (key_ == "linkerFolders") 	return &config_.linkerFolders.self;
+	if (key_ == "compilerOptions") 	return &config_.compilerOptions.self;
+	if (key_ == "linkerOptions") 	return &config_.linkerOptions.self;
+
+	return nullptr;
+}
+
+////////////////////////////////////
+template <typename T>
+auto accessByName(AccessSplit<T>& split_, StringView name_) -> T*
+{
+	if (name_ == "public") 		return &split_.public_;
+	if (name_ == "private") 	return &split_.private_;
+	if (name_ == "interface") 	return &split_.interface_;
+
+	return nullptr;
+}
+
+////////////////////////////////////
+auto dependencyFromString(String pattern_, Package& pkg_, Project& project_) -> Dependency
+{
+	if (startsWith(pattern_, "file:"))
+		return Dependency::raw( pattern_.substr(5) );
+
+	if (startsWith(pattern_, "self:"))
+		return Dependency::self( SelfDependency{ &project_, pattern_.substr(5), &pkg_ } );
+
+	auto loc = DownloadLocation::parse(pattern_);
+
+	auto pd = PackageDependency();
+	pd.packageName = loc.repository;
+
+	try {
+		pd.version = VersionReq::fromString(loc.branch);
+	}
+	catch(...) {} // just ignore
+
+	pd.projects.push_back(loc.repository);
+	pd.downloadLocation = std::move(pattern_);
+
+	return Dependency::package( std::move(pd) );
+}
+
+////////////////////////////////////
+auto dependencyFromDraft(DependencyDraft draft_) -> Dependency
+{
+	// Required fields:
+	if (!draft_.name || !draft_.name->is_string())
+		throw PaccException("invalid subfield type");
+
+	auto pd = PackageDependency();
+	pd.packageName = draft_.name->get<String>();
+
+	// Parse download location:
+	pd.downloadLocation = draft_.from ? draft_.from->get<String>() : "";
+	auto loc = DownloadLocation::parse(pd.downloadLocation);
+
+	if (draft_.projects)
+		pd.projects = std::move(*draft_.projects);
+	else
+		pd.projects.push_back(!loc.repository.empty() ? loc.repository : pd.packageName);
 
-//////////////////////////////////////////////////
-void PackageJsonReader::makeConformant()
+	// Optional
+	if (draft_.version && draft_.version->is_string())
+	{
+		try {
+			pd.version = VersionReq::fromString(draft_.version->get<String>());
+		}
+		catch (...) {
+			pd.version.type = VersionReq::Any;
+		}
+	}
+
+	return Dependency::package( std::move(pd) );
+}
+
+////////////////////////////////////
+/// <summary>Reads "unity": either a boolean or { "batchSize": 8, "exclude": [] }.</summary>
+auto readUnityBuild(json const& value_) -> UnityBuild
 {
-	using JV 	= JsonView;
-	using jtype = json::value_t;
+	auto unity = UnityBuild();
+
+	if (value_.is_boolean())
+	{
+		unity.enabled = value_.get<bool>();
+		return unity;
+	}
+
+	if (!value_.is_object())
+		throw PaccException(WrongTypeMsg, "unity", "object", value_.type_name());
 
-	if (root.is_array())
+	if (auto it = value_.find("batchSize"); it != value_.end())
 	{
-		json projects = std::move(root);
+		if (!it->is_number_unsigned() || it->get<std::size_t>() == 0)
+			throw PaccException(WrongTypeMsg, "unity.batchSize", "positive integer", it->type_name());
 
-		root = json::object();
-		root["projects"] = std::move(projects);
+		unity.batchSize = it->get<std::size_t>();
 	}
 
-	if (root.is_object())
+	if (auto it = value_.find("exclude"); it != value_.end())
 	{
-		if (auto it = root.find("projects");
-			it != root.end())
+		if (!it->is_array())
+			throw PaccException(WrongTypeMsg, "unity.exclude", "array", it->type_name());
+
+		for (auto const& pattern : *it)
 		{
-			// Has to be an array
-			JV{*it}.requireType("projects", jtype::array);
+			if (!pattern.is_string())
+				throw PaccException(WrongTypeMsg, "unity.exclude element", "string", pattern.type_name());
 
-			// At least one project
-			if (it->size() < 1)
-				throw PaccException("empty workspace not allowed");
+			unity.exclude.push_back(pattern.get<String>());
+		}
+	}
+
+	return unity;
+}
+
+////////////////////////////////////
+auto requireStringField(Opt<json> const& value_, StringView name_) -> String
+{
+	if (!value_)
+		throw PaccException(NoFieldMsg, name_, "string");
+
+	if (!value_->is_string())
+		throw PaccException(WrongTypeMsg, name_, "string", value_->type_name());
+
+	return value_->get<String>();
+}
+
+////////////////////////////////////
+/// <summary>SAX handler that fills the package.</summary>
+class PackageReader
+{
+public:
+	using number_integer_t 	= json::number_integer_t;
+	using number_unsigned_t = json::number_unsigned_t;
+	using number_float_t 	= json::number_float_t;
+	using string_t 			= json::string_t;
+	using binary_t 			= json::binary_t;
+
+	explicit PackageReader(Package& package_)
+		: package(package_)
+	{
+	}
+
+	bool null() 										{ return this->value(json(nullptr)); }
+	bool boolean(bool val_) 							{ return this->value(json(val_)); }
+	bool number_integer(number_integer_t val_) 			{ return this->value(json(val_)); }
+	bool number_unsigned(number_unsigned_t val_) 		{ return this->value(json(val_)); }
+	bool number_float(number_float_t val_, string_t const&) { return this->value(json(val_)); }
+	bool string(string_t& val_) 						{ return this->value(json(std::move(val_))); }
+	bool binary(binary_t& val_) 						{ return this->value(json::binary(std::move(val_))); }
+
+	bool start_object(std::size_t) 						{ return this->start(true); }
+	bool start_array(std::size_t) 						{ return this->start(false); }
+	bool end_object() 									{ return this->end(); }
+	bool end_array() 									{ return this->end(); }
+
+	bool key(string_t& key_)
+	{
+		auto& top = stack.back();
+
+		// Split only when "public" or "private" is present, "interface" alone is valid in interface projects
+		if (top.frame == Frame::AccessDependencies && (key_ == "public" || key_ == "private"))
+		{
+			auto& split = top.project->splitDependencies;
+			if (split.empty() || split.back() != top.accessDeps)
+				split.push_back(top.accessDeps);
+		}
+
+		top.key = std::move(key_);
+		return true;
+	}
+
+	template <typename TException>
+	bool parse_error(std::size_t, String const&, TException const& exc_)
+	{
+		throw exc_;
+	}
+
+private:
+	Package& 			package;
+	Vec<State> 			stack;
+
+	ProjectDraft 		rootDraft; 			// root object read as a single project
+	ProjectDraft 		draft; 				// current workspace project
+	DependencyDraft 	dependency; 		// current object-form dependency
+	std::size_t 		numProjects = 0; 	// in the current projects array
 
-			// Validate projects: each of them has to be an object
-			for(auto projIt : it->items())
+	Opt<json> 			rootName, rootVersion, rootCMake, rootStartupProject, rootEvents;
+	bool 				hasProjects = false;
+	bool 				hasType 	= false;
+
+	// The root object can be either a workspace or a single project, it is not known until it ends.
+	// Errors in project fields are remembered (not thrown) until then.
+	bool 				speculating = false;
+	std::exception_ptr 	deferredError;
+
+	////////////////////////////////////
+	template <typename TFunc>
+	void guarded(bool speculative_, TFunc&& func_)
+	{
+		try {
+			func_();
+		}
+		catch(...) {
+			if (!speculative_)
+				throw;
+
+			if (!deferredError)
+				deferredError = std::current_exception();
+		}
+	}
+
+	////////////////////////////////////
+	auto isSpeculative() const -> bool
+	{
+		return speculating || (!stack.empty() && stack.back().speculative);
+	}
+
+	////////////////////////////////////
+	void push(State state_)
+	{
+		state_.speculative = state_.speculative || this->isSpeculative();
+		stack.push_back(std::move(state_));
+	}
+
+	////////////////////////////////////
+	void skip()
+	{
+		this->push(State{ Frame::Skip });
+	}
+
+	////////////////////////////////////
+	/// <summary>Starts buffering the container value into `target_`.</summary>
+	void capture(Opt<json>& target_, bool isObject_)
+	{
+		target_ = isObject_ ? json::object() : json::array();
+		this->push(State{ .frame = Frame::Buffer, .node = &*target_ });
+	}
+
+	////////////////////////////////////
+	bool value(json&& value_)
+	{
+		this->guarded(this->isSpeculative(), [&]{ this->onValue(std::move(value_)); });
+		return true;
+	}
+
+	////////////////////////////////////
+	bool start(bool isObject_)
+	{
+		auto depth = stack.size();
+
+		this->guarded(this->isSpeculative(), [&]{ this->onStart(isObject_); });
+
+		// Rejected (speculatively), ignore the value:
+		if (stack.size() == depth)
+			this->skip();
+
+		speculating = false;
+		return true;
+	}
+
+	////////////////////////////////////
+	bool end()
+	{
+		auto state = std::move(stack.back());
+		stack.pop_back();
+
+		this->guarded(state.speculative, [&]{ this->onEnd(state); });
+		return true;
+	}
+
+	////////////////////////////////////
+	void onValue(json&& value_)
+	{
+		if (stack.empty())
+			throw PaccException("Empty workspace not allowed, your pacc.json is invalid.");
+
+		auto& top = stack.back();
+		switch (top.frame)
+		{
+		case Frame::Skip:
+		case Frame::Filters: // Only objects are filters
+			break;
+		case Frame::Buffer:
+		{
+			if (top.node->is_array())
+				top.node->push_back(std::move(value_));
+			else
+				(*top.node)[top.key] = std::move(value_);
+			break;
+		}
+		case Frame::Root: 			this->rootValue(top.key, std::move(value_)); break;
+		case Frame::Project: 		this->projectValue(*top.project, top.key, std::move(value_)); break;
+		case Frame::Configuration: 	this->configValue(*top.project, *top.config, top.key, std::move(value_)); break;
+		case Frame::Pch:
+		{
+			auto& pch = *top.project->project.pch;
+			if (top.key == "header") 			pch.header 		= value_.get<String>();
+			else if (top.key == "source") 		pch.source 		= value_.get<String>();
+			else if (top.key == "definition") 	pch.definition 	= value_.get<String>();
+			break;
+		}
+		case Frame::Strings:
+		{
+			if (!value_.is_string())
+				throw PaccException(WrongTypeMsg, top.fieldName + " element", "string", value_.type_name());
+
+			top.strings->push_back(value_.get<String>());
+			break;
+		}
+		case Frame::AccessStrings:
+		{
+			if (auto target = accessByName(*top.accessStrings, top.key))
 			{
-				json &proj = projIt.value();
-				if (proj.type() != jtype::object)
-					throw PaccException("each workspace project has to be an JSON object");
+				if (!value_.is_string())
+					throw PaccException(WrongTypeMsg, top.key, "array", value_.type_name());
 
-				// Validate name and type
-				JV{proj}.expect("name", jtype::string);
-				JV{proj}.expect("type", jtype::string);
+				*target = { value_.get<String>() };
 			}
+			break;
+		}
+		case Frame::Dependencies:
+		{
+			if (!value_.is_string())
+				throw PaccException("Invalid dependency type");
 
-			// Treat as workspace:
-			auto name = root.find("name");
-			if (name != root.end())
-				JV{*name}.requireType("name", jtype::string);
+			top.dependencies->push_back( dependencyFromString(value_.get<String>(), package, top.project->project) );
+			break;
+		}
+		case Frame::AccessDependencies:
+		{
+			if (accessByName(*top.accessDeps, top.key))
+				throw PaccException("invalid type of dependencies subfield - array required");
+			break;
+		}
+		case Frame::PackageDependency:
+		{
+			if (top.key == "name") 			dependency.name 	= std::move(value_);
+			else if (top.key == "version") 	dependency.version 	= std::move(value_);
+			else if (top.key == "from") 	dependency.from 	= std::move(value_);
+			break;
+		}
+		case Frame::DependencyProjects:
+		{
+			if (!value_.is_string())
+				throw PaccException("invalid type");
+
+			dependency.projects->push_back(value_.get<String>());
+			break;
+		}
+		case Frame::Projects:
+			throw PaccException("each workspace project has to be an JSON object");
+		}
+	}
+
+	////////////////////////////////////
+	void onStart(bool isObject_)
+	{
+		if (stack.empty())
+		{
+			if (isObject_)
+				this->push(State{ .frame = Frame::Root, .project = &rootDraft });
 			else
+				this->push(State{ .frame = Frame::Projects });
+			return;
+		}
+
+		auto& top = stack.back();
+		switch (top.frame)
+		{
+		case Frame::Skip:
+			this->skip();
+			break;
+		case Frame::Buffer:
+		{
+			auto child = isObject_ ? json::object() : json::array();
+
+			json* node = nullptr;
+			if (top.node->is_array())
 			{
-				// Use first project's name
-				root["name"] = (*it)[0]["name"].get<String>();
+				top.node->push_back(std::move(child));
+				node = &top.node->back();
 			}
+			else
+				node = &((*top.node)[top.key] = std::move(child));
+
+			this->push(State{ .frame = Frame::Buffer, .node = node });
+			break;
+		}
+		case Frame::Root: 			this->rootStart(top.key, isObject_); break;
+		case Frame::Project: 		this->projectStart(*top.project, top.key, isObject_); break;
+		case Frame::Configuration: 	this->configStart(*top.project, *top.config, top.key, isObject_); break;
+		case Frame::Filters:
+		{
+			if (!isObject_)
+				return this->skip();
+
+			// Create and reference the configuration:
+			auto& config = top.project->project.premakeFilters[top.key];
+			this->push(State{ .frame = Frame::Configuration, .project = top.project, .config = &config });
+			break;
+		}
+		case Frame::Pch:
+		{
+			if (top.key == "header" || top.key == "source" || top.key == "definition")
+				throw PaccException(WrongTypeMsg, top.key, "string", containerTypeName(isObject_));
+
+			this->skip();
+			break;
+		}
+		case Frame::Strings:
+			throw PaccException(WrongTypeMsg, top.fieldName + " element", "string", containerTypeName(isObject_));
+		case Frame::AccessStrings:
+		{
+			auto target = accessByName(*top.accessStrings, top.key);
+			if (!target)
+				return this->skip();
+
+			if (isObject_)
+				throw PaccException(WrongTypeMsg, top.key, "array", "object");
+
+			target->clear();
+			this->push(State{ .frame = Frame::Strings, .fieldName = top.key, .strings = target });
+			break;
+		}
+		case Frame::Dependencies:
+		{
+			if (!isObject_)
+				throw PaccException("Invalid dependency type");
+
+			dependency = {};
+			this->push(State{ .frame = Frame::PackageDependency, .project = top.project, .dependencies = top.dependencies });
+			break;
+		}
+		case Frame::AccessDependencies:
+		{
+			auto target = accessByName(*top.accessDeps, top.key);
+			if (!target)
+				return this->skip();
+
+			if (isObject_)
+				throw PaccException("invalid type of dependencies subfield - array required");
 
-			// TODO: make each project conformant
+			this->push(State{ .frame = Frame::Dependencies, .project = top.project, .dependencies = target });
+			break;
 		}
-		else if (auto it = root.find("type");
-			it != root.end())
+		case Frame::PackageDependency:
 		{
-			if (!root.contains("name") || root["name"].type() != json::value_t::string)
+			if (top.key == "projects")
+			{
+				if (!isObject_)
+				{
+					dependency.projects.emplace();
+					this->push(State{ .frame = Frame::DependencyProjects });
+				}
+				else
+					this->skip(); // Not an array, use default projects.
+			}
+			else if (top.key == "name") 	this->capture(dependency.name, isObject_);
+			else if (top.key == "version") 	this->capture(dependency.version, isObject_);
+			else if (top.key == "from") 	this->capture(dependency.from, isObject_);
+			else
+				this->skip();
+			break;
+		}
+		case Frame::DependencyProjects:
+			throw PaccException("invalid type");
+		case Frame::Projects:
+		{
+			if (!isObject_)
+				throw PaccException("each workspace project has to be an JSON object");
+
+			draft = {};
+			this->push(State{ .frame = Frame::Project, .project = &draft });
+			break;
+		}
+		}
+	}
+
+	////////////////////////////////////
+	void onEnd(State& state_)
+	{
+		switch (state_.frame)
+		{
+		case Frame::Project:
+		{
+			this->finishProject(*state_.project);
+			++numProjects;
+			break;
+		}
+		case Frame::Projects:
+		{
+			// At least one project
+			if (numProjects < 1)
+				throw PaccException("empty workspace not allowed");
+
+			// Array of projects:
+			if (stack.empty())
+				package.name = package.projects.front().name;
+			break;
+		}
+		case Frame::PackageDependency:
+		{
+			state_.dependencies->push_back( dependencyFromDraft(std::move(dependency)) );
+			break;
+		}
+		case Frame::Root:
+			this->finishRoot();
+			break;
+		default:
+			break;
+		}
+	}
+
+	////////////////////////////////////
+	// Root object
+	////////////////////////////////////
+
+	////////////////////////////////////
+	auto rootField(StringView key_) -> Opt<json>*
+	{
+		if (key_ == "name") 			return &rootName;
+		if (key_ == "version") 			return &rootVersion;
+		if (key_ == "cmake") 			return &rootCMake;
+		if (key_ == "startupProject") 	return &rootStartupProject;
+		if (key_ == "events") 			return &rootEvents;
+
+		return nullptr;
+	}
+
+	////////////////////////////////////
+	void rootValue(StringView key_, json&& value_)
+	{
+		if (key_ == "projects")
+			throw PaccException(WrongTypeMsg, "projects", "array", value_.type_name());
+
+		if (auto field = this->rootField(key_))
+		{
+			*field = std::move(value_);
+			return;
+		}
+
+		if (key_ == "type")
+			hasType = true;
+
+		// Workspace, project fields are not used:
+		if (hasProjects)
+			return;
+
+		speculating = true;
+		this->guarded(true, [&]{ this->projectValue(rootDraft, key_, std::move(value_)); });
+		speculating = false;
+	}
+
+	////////////////////////////////////
+	void rootStart(StringView key_, bool isObject_)
+	{
+		if (key_ == "projects")
+		{
+			if (isObject_)
+				throw PaccException(WrongTypeMsg, "projects", "array", "object");
+
+			hasProjects = true;
+			numProjects = 0;
+			this->push(State{ .frame = Frame::Projects });
+			return;
+		}
+
+		if (auto field = this->rootField(key_))
+			return this->capture(*field, isObject_);
+
+		if (key_ == "type")
+			hasType = true;
+
+		if (hasProjects)
+			return this->skip();
+
+		// Cleared in `start()`, so the pushed frame and its children are speculative:
+		speculating = true;
+		this->projectStart(rootDraft, key_, isObject_);
+	}
+
+	////////////////////////////////////
+	void finishRoot()
+	{
+		if (hasProjects)
+		{
+			// Treat as workspace:
+			if (rootName)
+			{
+				if (!rootName->is_string())
+					throw PaccException(WrongTypeMsg, "name", "string", rootName->type_name());
+
+				package.name = rootName->get<String>();
+			}
+			else // Use first project's name
+				package.name = package.projects.front().name;
+
+			package.startupProject 	= rootStartupProject ? rootStartupProject->get<String>() : "";
+			package.version 		= Version::fromString( rootVersion ? rootVersion->get<String>() : "0" );
+			package.isCMake 		= rootCMake ? rootCMake->get<bool>() : false;
+
+			if (rootEvents)
+				readTargetEventHandlers(useApp(), *rootEvents, package);
+		}
+		else if (hasType)
+		{
+			// Single project:
+			if (!rootName || !rootName->is_string())
 				throw PaccException("Project doesn't contain string field \"name\".");
 
-			json singleProject = std::move(root);
+			package.name 			= rootName->get<String>();
+			package.isCMake 		= rootCMake ? rootCMake->get<bool>() : false;
+			package.version 		= Version::fromString(
+					(rootVersion && rootVersion->is_string()) ? rootVersion->get<String>() : "0.0.0"
+				);
 
-			root = json::object();
-			root["name"] 		= singleProject["name"];
-			root["cmake"] 		= singleProject.value("cmake", false);
-			root["version"]		= JV{singleProject}.stringFieldOr("version", "0.0.0");
-			root["projects"] 	= json::array();
-			root["projects"].push_back(std::move(singleProject));
+			if (deferredError)
+				std::rethrow_exception(deferredError);
 
-			// It is in workspace format now, process it again.
-			this->makeConformant();
+			rootDraft.name 		= rootName;
+			rootDraft.events 	= std::move(rootEvents);
+			this->finishProject(rootDraft);
 		}
 		else
 			throw PaccException("Invalid pacc.json format.")
 				.withHelp("Insert either \"projects\" (workspace) or \"type\" (single project) field.");
 	}
-	else
-		throw PaccException("Empty workspace not allowed, your pacc.json is invalid.");
+
+	////////////////////////////////////
+	// Projects
+	////////////////////////////////////
+
+	////////////////////////////////////
+	auto projectField(ProjectDraft& draft_, StringView key_) -> Opt<json>*
+	{
+		if (key_ == "name") 		return &draft_.name;
+		if (key_ == "type") 		return &draft_.type;
+		if (key_ == "language") 	return &draft_.language;
+		if (key_ == "events") 		return &draft_.events;
+		if (key_ == "unity") 		return &draft_.unity;
+
+		return nullptr;
+	}
+
+	////////////////////////////////////
+	void projectValue(ProjectDraft& draft_, StringView key_, json&& value_)
+	{
+		if (auto field = this->projectField(draft_, key_))
+			*field = std::move(value_);
+		else if (key_ == "pch")
+		{
+			if (!value_.is_string() || value_.get<String>() != "auto")
+				throw PaccException(WrongTypeMsg, "pch", "object", value_.type_name())
+					.withHelp("Use \"pch\": \"auto\" to precompile the headers included most often.");
+
+			draft_.project.pch = PrecompiledHeader{ .automatic = true };
+		}
+		else if (key_ != "filters") // Only an object is accepted, ignore otherwise
+			this->configValue(draft_, draft_.project, key_, std::move(value_));
+	}
+
+	////////////////////////////////////
+	void projectStart(ProjectDraft& draft_, StringView key_, bool isObject_)
+	{
+		if (auto field = this->projectField(draft_, key_))
+			return this->capture(*field, isObject_);
+
+		if (key_ == "pch")
+		{
+			if (!isObject_)
+				throw PaccException(WrongTypeMsg, "pch", "object", "array")
+					.withHelp("Use \"pch\": \"auto\" to precompile the headers included most often.");
+
+			draft_.project.pch = PrecompiledHeader{};
+			this->push(State{ .frame = Frame::Pch, .project = &draft_ });
+		}
+		else if (key_ == "filters")
+		{
+			if (isObject_)
+				this->push(State{ .frame = Frame::Filters, .project = &draft_ });
+			else
+				this->skip();
+		}
+		else
+			this->configStart(draft_, draft_.project, key_, isObject_);
+	}
+
+	////////////////////////////////////
+	void finishProject(ProjectDraft& draft_)
+	{
+		auto& project = draft_.project;
+
+		// Validate name and type
+		project.name = requireStringField(draft_.name, "name");
+		project.type = parseProjectType(requireStringField(draft_.type, "type"));
+
+		// TODO: type and value validation
+		if (draft_.language)
+			project.language = draft_.language->get<String>();
+
+		bool isInterface = (project.type == Project::Type::Interface);
+
+		AccessType defaultAccess = isInterface ? AccessType::Interface : AccessType::Private;
+
+		for (auto& strings : draft_.defaultAccessStrings)
+			targetByAccessType(*strings.target, defaultAccess) = std::move(strings.values);
+
+		for (auto& deps : draft_.defaultAccessDependencies)
+		{
+			auto& target = targetByAccessType(*deps.target, defaultAccess);
+			target.insert(target.end(), std::make_move_iterator(deps.values.begin()), std::make_move_iterator(deps.values.end()));
+		}
+
+		if (isInterface)
+		{
+			using fmt::fg, fmt::color;
+
+			for (auto deps : draft_.splitDependencies)
+			{
+				fmt::print(fg(color::yellow), "Interface project \"{}\" cannot include public or private dependencies (ignored).", project.name);
+				deps->public_.clear();
+				deps->private_.clear();
+			}
+		}
+
+		if (draft_.events)
+			readTargetEventHandlers(useApp(), *draft_.events, project);
+
+		if (draft_.unity)
+			project.unity = readUnityBuild(*draft_.unity);
+
+		package.projects.emplace_back(std::move(project));
+	}
+
+	////////////////////////////////////
+	// Configuration (of a project or a filter)
+	////////////////////////////////////
+
+	////////////////////////////////////
+	void configValue(ProjectDraft& draft_, Configuration& config_, StringView key_, json&& value_)
+	{
+		if (key_ == "files")
+		{
+			if (!value_.is_string())
+				throw PaccException(WrongTypeMsg, "files", "array", value_.type_name());
+
+			config_.files = { value_.get<String>() };
+		}
+		else if (auto field = accessStringsField(config_, key_))
+		{
+			// Other types are ignored
+			if (value_.is_string())
+				draft_.defaultAccessStrings.push_back({ field, { value_.get<String>() } });
+		}
+		else if (key_ == "dependencies")
+			throw PaccException("Invalid type of \"dependencies\" field (must be an array or an object)");
+		else if (key_ == "symbolVisibility")
+			config_.symbolVisibility = GNUSymbolVisibility::fromString(value_.get<String>());
+		else if (key_ == "moduleDefinitionFile")
+			config_.moduleDefinitionFile = value_.get<String>();
+	}
+
+	////////////////////////////////////
+	void configStart(ProjectDraft& draft_, Configuration& config_, StringView key_, bool isObject_)
+	{
+		if (key_ == "files")
+		{
+			if (isObject_)
+				throw PaccException(WrongTypeMsg, "files", "array", "object");
+
+			config_.files.clear();
+			this->push(State{ .frame = Frame::Strings, .fieldName = "files", .strings = &config_.files });
+		}
+		else if (auto field = accessStringsField(config_, key_))
+		{
+			if (isObject_)
+			{
+				*field = {};
+				this->push(State{ .frame = Frame::AccessStrings, .accessStrings = field });
+			}
+			else
+			{
+				auto& deferred = draft_.defaultAccessStrings.emplace_back(DefaultAccessValues<String>{ field });
+				this->push(State{ .frame = Frame::Strings, .fieldName = String(key_), .strings = &deferred.values });
+			}
+		}
+		else if (key_ == "dependencies")
+		{
+			auto& deps = config_.dependencies.self;
+			if (isObject_)
+				this->push(State{ .frame = Frame::AccessDependencies, .project = &draft_, .accessDeps = &deps });
+			else
+			{
+				auto& deferred = draft_.defaultAccessDependencies.emplace_back(DefaultAccessValues<Dependency>{ &deps });
+				this->push(State{ .frame = Frame::Dependencies, .project = &draft_, .dependencies = &deferred.values });
+			}
+		}
+		else if (key_ == "symbolVisibility" || key_ == "moduleDefinitionFile")
+			json(isObject_ ? json::value_t::object : json::value_t::array).get<String>(); // throws type error
+		else
+			this->skip();
+	}
+};
+
+} // namespace
+
+
+///////////////////////////////////////////////////
+void readPackageJson(Package& package_, StringView content_)
+{
+	auto reader = PackageReader{ package_ };
+
+	json::sax_parse(content_.begin(), content_.end(), &reader);
+}
+
+///////////////////////////////////////////////////
+static void readSingleTargetEventHandler(
+		PaccAppModule_EventHandlerActions const&	events_,
+		EventHandlingTarget&						target_,
+		String const&								key,
+		json const&									value,
+		int											handlerIndex = 0
+	)
+{
+	if (value.is_string())
+	{
+		auto action = value.get<String>(); // TODO: ensure is a string
+		auto [name, behavior] = splitBy(action, ':', true);
+
+		if (action.empty())
+		{
+			// TODO: consider throwing an error
+			return;
+		}
+
+		auto actionHandler = events_.findEventAction(name);
+		if (!actionHandler)
+		{
+			fmt::printLog(
+					fmt::fg(fmt::color::yellow),
+					"[Warning] Handler (id: {}) of the event \"{}\" for target \"{}\" uses unknown action \"{}\":\n    ",
+					handlerIndex, key, target_.name, name
+				);
+			fmt::printLog(fmt::bg(fmt::color::dark_red), "{}", name);
+			fmt::printLog(fmt::fg(fmt::color::dim_gray), ":{}\n\n", behavior);
+			return;
+		}
+
+		if (!actionHandler->canLoadFromAbbreviatedString)
+		{
+			fmt::printLog(
+					fmt::fg(fmt::color::yellow),
+					"Action \"{}\" cannot be loaded from an abbreviated string. Use a JSON object instead.\n",
+					key, target_.name
+				);
+			return;
+		}
+
+		target_.eventHandlers[key].push_back(actionHandler->load(behavior));
+	}
+	else if (value.is_object())
+	{
+		auto action = value.value<String>("action", "");
+
+		if (action.empty())
+		{
+			fmt::printLog(
+					fmt::fg(fmt::color::yellow),
+					"[Warning] Handler (id: {}) of the event \"{}\" for target \"{}\" has no \"action\" field specified.\n",
+					handlerIndex, key, target_.name
+				);
+			// TODO: consider throwing an error
+			return;
+		}
+
+		auto actionHandler = events_.findEventAction(action);
+		if (!actionHandler)
+		{
+			fmt::printLog(
+					fmt::fg(fmt::color::yellow),
+					"[Warning] Handler (id: {}) of the event \"{}\" for target \"{}\" uses unknown action \"{}\":\n    ",
+					handlerIndex, key, target_.name, action
+				);
+			fmt::printLog(fmt::fg(fmt::color::gray), "\"action\": \"");
+			fmt::printLog(fmt::bg(fmt::color::dark_red), "{}", action);
+			fmt::printLog(fmt::fg(fmt::color::gray), "\"\n\n");
+			return;
+		}
+
+		target_.eventHandlers[key].push_back(actionHandler->load(value));
+	}
+}
+
+///////////////////////////////////////////////////
+// TODO: refactor
+void readTargetEventHandlers(
+		PaccAppModule_EventHandlerActions const&	events_,
+		json const&									scripts_,
+		EventHandlingTarget&						target_
+	)
+{
+	for (auto const& [key, value] : scripts_.items())
+	{
+		if (value.is_array())
+		{
+			auto idx = 0;
+			for (auto const& item : value)
+			{
+				readSingleTargetEventHandler(events_, target_, key, item, idx);
+				++idx;
+			}
+		}
+		else readSingleTargetEventHandler(events_, target_, key, value);
+	}
 }
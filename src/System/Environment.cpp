@@ -10,6 +10,8 @@
 	#include <unistd.h>
 #endif
 
+#include <charconv>
+
 namespace env
 {
 
@@ -92,6 +94,104 @@ fs::path getPaccAppPath()
 	return fs::path(String(buf.data(), bytes));
 }
 
+#ifdef PACC_SYSTEM_LINUX
+
+///////////////////////////////////////////////////
+/// <summary>First number in the file (f.e. "memory.max"), std::nullopt if not a number (f.e. "max").</summary>
+static Opt<std::uint64_t> readNumber(fs::path const& path_)
+{
+	auto text = String();
+	if (!std::getline(std::ifstream(path_), text))
+		return std::nullopt;
+
+	auto value 	= std::uint64_t(0);
+	auto res 	= std::from_chars(text.data(), text.data() + text.size(), value);
+	if (res.ec != std::errc{})
+		return std::nullopt;
+
+	return value;
+}
+
+///////////////////////////////////////////////////
+/// <summary>Smallest unused part of the limits of the cgroup and its parents (cgroup v2, or v1 memory controller).</summary>
+static Opt<std::uint64_t> cgroupAvailableMemory()
+{
+	auto result = Opt<std::uint64_t>();
+	auto lower 	= [&](Opt<std::uint64_t> limit_, Opt<std::uint64_t> usage_) {
+			// v1 reports "no limit" as a huge number
+			if (limit_ && *limit_ < (std::uint64_t(1) << 60))
+				result = std::min(result.value_or(*limit_), *limit_ - std::min(*limit_, usage_.value_or(0)));
+		};
+
+	// Lines: "0::/path" (v2) or "4:memory:/path" (v1)
+	auto cgroups 	= std::ifstream("/proc/self/cgroup");
+	auto line 		= String();
+	while (std::getline(cgroups, line))
+	{
+		auto first 	= line.find(':');
+		auto second = line.find(':', first + 1);
+		if (first == String::npos || second == String::npos)
+			continue;
+
+		auto controllers 	= StringView(line).substr(first + 1, second - first - 1);
+		auto group 			= fs::path(line.substr(second + 1)).relative_path();
+
+		auto v2 = controllers.empty();
+		if (!v2 && controllers.find("memory") == StringView::npos)
+			continue;
+
+		// Containers often see their own cgroup as the root of the hierarchy
+		auto root = fs::path(v2 ? "/sys/fs/cgroup" : "/sys/fs/cgroup/memory");
+		if (!fs::exists(root / group))
+			group.clear();
+
+		for (auto folder = group.empty() ? root : root / group; ; folder = folder.parent_path())
+		{
+			if (v2)
+				lower(readNumber(folder / "memory.max"), readNumber(folder / "memory.current"));
+			else
+				lower(readNumber(folder / "memory.limit_in_bytes"), readNumber(folder / "memory.usage_in_bytes"));
+
+			if (folder == root || !folder.has_relative_path())
+				break;
+		}
+	}
+
+	return result;
+}
+
+#endif
+
+///////////////////////////////////////////////////
+Opt<std::uint64_t> availableMemory()
+{
+	#ifdef PACC_SYSTEM_LINUX
+		auto result = Opt<std::uint64_t>();
+
+		// Line: "MemAvailable:   12345678 kB"
+		auto meminfo 	= std::ifstream("/proc/meminfo");
+		auto line 		= String();
+		while (std::getline(meminfo, line))
+		{
+			if (!line.starts_with("MemAvailable:"))
+				continue;
+
+			auto begin 	= line.find_first_of("0123456789");
+			auto value 	= std::uint64_t(0);
+			if (begin != String::npos && std::from_chars(line.data() + begin, line.data() + line.size(), value).ec == std::errc{})
+				result = value * 1024;
+			break;
+		}
+
+		if (auto cgroup = cgroupAvailableMemory())
+			result = std::min(result.value_or(*cgroup), *cgroup);
+
+		return result;
+	#else
+		return std::nullopt;
+	#endif
+}
+
 
 
 }
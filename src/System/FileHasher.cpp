@@ -0,0 +1,291 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/System/FileHasher.hpp>
+
+#include <Pacc/System/Environment.hpp>
+#include <Pacc/System/FileView.hpp>
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/Parallel.hpp>
+
+#ifndef PACC_SYSTEM_WINDOWS
+	#include <sys/stat.h>
+#endif
+
+#include <cstring>
+
+constexpr StringView TableFileName 	= "file_hashes.bin";
+constexpr StringView TableMagic 	= "PACCFH01";
+
+// Files modified more recently are not remembered (see the class remarks)
+constexpr auto RacyInterval = ch::seconds(2);
+
+struct FileStatus
+{
+	uint64_t 	inode 	= 0;
+	uint64_t 	size 	= 0;
+	int64_t 	mtime 	= 0;
+	bool 		racy 	= false;
+};
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto statFile(Path const& file_) -> Opt<FileStatus>;
+static auto readContents(Path const& file_, String& buffer_) -> bool;
+static void readTable(Path const& tableFile_, StrUMap<FileHasher::Entry>& entries_);
+static void appendEntry(String& out_, String const& path_, FileHasher::Entry const& entry_);
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+FileHasher::FileHasher(Path tableFile_)
+	: tableFile(std::move(tableFile_))
+{
+	readTable(tableFile, entries);
+}
+
+///////////////////////////////////////////////////
+auto FileHasher::hash(Path const& file_) -> Opt<Hash128>
+{
+	return this->hashAll({ file_ }).front();
+}
+
+///////////////////////////////////////////////////
+auto FileHasher::hashAll(Vec<Path> const& files_) -> Vec<Opt<Hash128>>
+{
+	auto result = Vec<Opt<Hash128>>(files_.size());
+	auto hashed = Vec<Opt<Entry>>(files_.size()); // to remember
+
+	auto missing 	= Vec<char>(files_.size(), 0); // remembered, but no longer there
+
+	auto numRead 	= std::atomic_size_t{0};
+	auto bytesRead 	= std::atomic_size_t{0};
+
+	// The table is only read here, new entries are added afterwards
+	parallelFor(files_.size(), [&](std::size_t i)
+		{
+			auto key = fsx::fwd(files_[i]).string();
+			auto it = entries.find(key);
+
+			auto status = statFile(files_[i]);
+			if (!status)
+			{
+				missing[i] = (it != entries.end() || added.contains(key));
+				return;
+			}
+
+			if (it != entries.end())
+			{
+				auto const& entry = it->second;
+				if (entry.inode == status->inode && entry.size == status->size && entry.mtime == status->mtime)
+				{
+					result[i] = entry.hash;
+					return;
+				}
+			}
+
+			// Read, not mapped: a file truncated by an editor while mapped would crash the process
+			thread_local auto buffer = String();
+			if (!readContents(files_[i], buffer))
+				return;
+
+			auto contents = fastHash128(buffer);
+			bytesRead += buffer.size();
+
+			++numRead;
+			result[i] = contents;
+			if (!status->racy)
+				hashed[i] = Entry{ status->inode, status->size, status->mtime, contents };
+		});
+
+	for (std::size_t i = 0; i < files_.size(); ++i)
+	{
+		if (missing[i])
+		{
+			auto key = fsx::fwd(files_[i]).string();
+			added.erase(key);
+			removed.insert(std::move(key));
+		}
+		else if (hashed[i])
+		{
+			auto key = fsx::fwd(files_[i]).string();
+			removed.erase(key);
+			entries[key] 				= *hashed[i];
+			added[std::move(key)] 		= *hashed[i];
+		}
+	}
+
+	counters.read 		+= numRead;
+	counters.bytesRead 	+= bytesRead;
+	counters.reused 	+= std::size_t(rg::count_if(result, [](auto const& hash) { return hash.has_value(); })) - numRead;
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+void FileHasher::save()
+{
+	if (added.empty() && removed.empty())
+		return;
+
+	// Keep the entries that other processes added in the meantime,
+	// but drop the files found missing, so the table does not grow forever
+	auto merged = StrUMap<Entry>();
+	readTable(tableFile, merged);
+	for (auto const& path : removed)
+		merged.erase(path);
+	for (auto const& [path, entry] : added)
+		merged[path] = entry;
+
+	auto out = String(TableMagic);
+	out.reserve(merged.size() * 96);
+	for (auto const& [path, entry] : merged)
+		appendEntry(out, path, entry);
+
+	if (!fsx::replaceFile(tableFile, out))
+		return;
+
+	entries = std::move(merged);
+	added.clear();
+	removed.clear();
+}
+
+///////////////////////////////////////////////////
+auto FileHasher::defaultTableFile() -> Path
+{
+	return env::getPaccDataStorageFolder() / TableFileName;
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static auto statFile(Path const& file_) -> Opt<FileStatus>
+{
+	auto status = FileStatus();
+
+#ifdef PACC_SYSTEM_WINDOWS
+	auto ec = std::error_code{};
+	if (!fs::is_regular_file(file_, ec))
+		return std::nullopt;
+
+	status.size 	= fs::file_size(file_, ec);
+	auto mtime 		= fs::last_write_time(file_, ec);
+	if (ec)
+		return std::nullopt;
+
+	status.mtime 	= int64_t(mtime.time_since_epoch().count());
+	status.racy 	= (fs::file_time_type::clock::now() - mtime) < RacyInterval;
+#else
+	struct stat st;
+	if (::stat(file_.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return std::nullopt;
+
+	#ifdef PACC_SYSTEM_MACOSX
+		auto const& mtime = st.st_mtimespec;
+	#else
+		auto const& mtime = st.st_mtim;
+	#endif
+
+	auto mtimeNs = ch::seconds(mtime.tv_sec) + ch::nanoseconds(mtime.tv_nsec);
+
+	status.inode 	= uint64_t(st.st_ino);
+	status.size 	= uint64_t(st.st_size);
+	status.mtime 	= int64_t(mtimeNs.count());
+	status.racy 	= (ch::system_clock::now().time_since_epoch() - mtimeNs) < RacyInterval;
+#endif
+
+	return status;
+}
+
+///////////////////////////////////////////////////
+static auto readContents(Path const& file_, String& buffer_) -> bool
+{
+	auto in = std::ifstream(file_, std::ios::binary);
+	if (!in.is_open())
+		return false;
+
+	constexpr auto ChunkSize = std::size_t(64 * 1024);
+
+	buffer_.clear();
+	while (in)
+	{
+		auto offset = buffer_.size();
+		buffer_.resize(offset + ChunkSize);
+		in.read(buffer_.data() + offset, std::streamsize(ChunkSize));
+		buffer_.resize(offset + std::size_t(in.gcount()));
+	}
+
+	return !in.bad();
+}
+
+///////////////////////////////////////////////////
+/// <summary>
+/// 	Table format: magic, then the entries: inode, size, modification time, hash (low, high)
+/// 	and path length (native 64-bit and 32-bit integers) followed by the path.
+/// </summary>
+static void readTable(Path const& tableFile_, StrUMap<FileHasher::Entry>& entries_)
+{
+	auto ec = std::error_code{};
+	if (!fs::is_regular_file(tableFile_, ec))
+		return;
+
+	try {
+		auto view = FileView(tableFile_);
+		auto data = view.view();
+
+		if (!data.starts_with(TableMagic))
+			return;
+
+		data.remove_prefix(TableMagic.size());
+
+		auto read = [&](auto& value_) {
+				if (data.size() < sizeof(value_))
+					return false;
+
+				std::memcpy(&value_, data.data(), sizeof(value_));
+				data.remove_prefix(sizeof(value_));
+				return true;
+			};
+
+		while (!data.empty())
+		{
+			auto entry 		= FileHasher::Entry();
+			auto pathLength = uint32_t(0);
+
+			auto complete = read(entry.inode) && read(entry.size) && read(entry.mtime)
+				&& read(entry.hash.low) && read(entry.hash.high) && read(pathLength);
+
+			if (!complete || data.size() < pathLength)
+				break;
+
+			entries_[String(data.substr(0, pathLength))] = entry;
+			data.remove_prefix(pathLength);
+		}
+	}
+	catch(...) {
+		// Unreadable table, start over.
+	}
+}
+
+///////////////////////////////////////////////////
+static void appendEntry(String& out_, String const& path_, FileHasher::Entry const& entry_)
+{
+	auto write = [&](auto const& value_) {
+			out_.append(reinterpret_cast<char const*>(&value_), sizeof(value_));
+		};
+
+	write(entry_.inode);
+	write(entry_.size);
+	write(entry_.mtime);
+	write(entry_.hash.low);
+	write(entry_.hash.high);
+	write(uint32_t(path_.size()));
+	out_ += path_;
+}
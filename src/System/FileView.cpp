@@ -0,0 +1,130 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/System/FileView.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+
+#ifdef PACC_SYSTEM_WINDOWS
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+//////////////////////////////////////
+FileView::FileView(Path const& path_)
+{
+	auto failed = [&]{
+			return PaccException("failed to open file {} for reading", path_.string());
+		};
+
+#ifdef PACC_SYSTEM_WINDOWS
+	auto file = CreateFileW(path_.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		throw failed();
+
+	auto fileSize = LARGE_INTEGER{};
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		throw failed();
+	}
+
+	// Empty files cannot be mapped
+	if (fileSize.QuadPart > 0)
+	{
+		auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		auto address = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+		// The view keeps the mapping alive
+		if (mapping)
+			CloseHandle(mapping);
+
+		if (!address)
+		{
+			CloseHandle(file);
+			throw failed();
+		}
+
+		ptr 	= static_cast<char const*>(address);
+		len 	= static_cast<std::size_t>(fileSize.QuadPart);
+		mapped 	= true;
+	}
+
+	CloseHandle(file);
+#else
+	auto fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		throw failed();
+
+	struct stat st{};
+	if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+	{
+		::close(fd);
+		throw failed();
+	}
+
+	// Empty files cannot be mapped
+	if (st.st_size > 0)
+	{
+		auto address = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		if (address == MAP_FAILED)
+		{
+			::close(fd);
+			throw failed();
+		}
+
+		ptr 	= static_cast<char const*>(address);
+		len 	= static_cast<std::size_t>(st.st_size);
+		mapped 	= true;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	::close(fd);
+#endif
+}
+
+//////////////////////////////////////
+FileView::~FileView()
+{
+	this->close();
+}
+
+//////////////////////////////////////
+FileView::FileView(FileView&& other_) noexcept
+	: ptr(std::exchange(other_.ptr, "")),
+	len(std::exchange(other_.len, 0)),
+	mapped(std::exchange(other_.mapped, false))
+{
+}
+
+//////////////////////////////////////
+FileView& FileView::operator=(FileView&& other_) noexcept
+{
+	if (this != &other_)
+	{
+		this->close();
+		ptr 	= std::exchange(other_.ptr, "");
+		len 	= std::exchange(other_.len, 0);
+		mapped 	= std::exchange(other_.mapped, false);
+	}
+	return *this;
+}
+
+//////////////////////////////////////
+void FileView::close()
+{
+	if (!mapped)
+		return;
+
+#ifdef PACC_SYSTEM_WINDOWS
+	UnmapViewOfFile(ptr);
+#else
+	::munmap(const_cast<char*>(ptr), len);
+#endif
+
+	ptr 	= "";
+	len 	= 0;
+	mapped 	= false;
+}
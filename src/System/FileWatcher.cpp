@@ -0,0 +1,228 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/System/FileWatcher.hpp>
+
+#include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+
+#ifdef PACC_SYSTEM_LINUX
+	#include <unistd.h>
+	#include <poll.h>
+	#include <sys/inotify.h>
+#endif
+
+#ifdef PACC_SYSTEM_LINUX
+
+constexpr auto WatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+
+///////////////////////////////////////////////////
+FileWatcher::FileWatcher()
+{
+	fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0)
+		throw PaccException("Could not watch files: inotify is not available ({}).", std::strerror(errno));
+}
+
+///////////////////////////////////////////////////
+FileWatcher::~FileWatcher()
+{
+	::close(fd);
+}
+
+///////////////////////////////////////////////////
+void FileWatcher::watch(Path const& folder_, bool recursive_)
+{
+	this->addWatch(fs::absolute(folder_).lexically_normal(), recursive_, nullptr);
+}
+
+///////////////////////////////////////////////////
+void FileWatcher::clear()
+{
+	for (auto const& [wd, folder] : folders)
+		::inotify_rm_watch(fd, wd);
+
+	folders.clear();
+	watchDescriptors.clear();
+
+	// Drop the events of the removed watches
+	auto discarded 	= StrUMap<Path>();
+	auto overflowed = false;
+	this->readEvents(discarded, overflowed);
+}
+
+///////////////////////////////////////////////////
+auto FileWatcher::waitForChanges(ch::milliseconds debounce_)
+	-> Changes
+{
+	auto changes 	= StrUMap<Path>();
+	auto overflowed = false;
+
+	auto timeout = -1; // wait for the first change indefinitely
+	while (true)
+	{
+		auto pfd = pollfd{ fd, POLLIN, 0 };
+		auto ready = ::poll(&pfd, 1, timeout);
+		if (ready < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			throw PaccException("Could not watch files ({}).", std::strerror(errno));
+		}
+
+		// Quiet for the whole debounce time
+		if (ready == 0)
+			break;
+
+		this->readEvents(changes, overflowed);
+
+		if (!changes.empty() || overflowed)
+			timeout = int(debounce_.count());
+	}
+
+	auto result = Changes();
+	result.all = overflowed;
+	result.files.reserve(changes.size());
+	for (auto& [key, path] : changes)
+		result.files.push_back(std::move(path));
+
+	rg::sort(result.files);
+	return result;
+}
+
+///////////////////////////////////////////////////
+void FileWatcher::addWatch(Path const& folder_, bool recursive_, Vec<Path>* existingFiles_)
+{
+	auto key = fsx::fwd(folder_).string();
+	if (watchDescriptors.contains(key))
+		return;
+
+	auto wd = ::inotify_add_watch(fd, key.c_str(), WatchMask);
+	if (wd < 0)
+	{
+		using fmt::fg, fmt::color;
+
+		// Missing folders are ignored, changes in folders that could not be watched would go unnoticed
+		if (errno == ENOSPC)
+		{
+			if (!std::exchange(warnedLimit, true))
+				fmt::print(fg(color::yellow), "Warning: the inotify watch limit was reached, changes in some folders will not be noticed.\n"
+					"Raise it with \"sysctl fs.inotify.max_user_watches=<limit>\".\n");
+		}
+		else if (errno != ENOENT && errno != ENOTDIR)
+			fmt::print(fg(color::yellow), "Warning: could not watch folder \"{}\" ({}).\n", key, std::strerror(errno));
+
+		return;
+	}
+
+	folders[wd] = Folder{ fsx::fwd(folder_), recursive_ };
+	watchDescriptors[std::move(key)] = wd;
+
+	if (!recursive_ && !existingFiles_)
+		return;
+
+	auto ec = std::error_code{};
+	for (auto it = fs::directory_iterator(folder_, ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+	{
+		auto const& entry = *it;
+		if (entry.is_directory(ec))
+		{
+			// Hidden folders (".git" etc.) do not contain project files
+			if (recursive_ && !entry.path().filename().string().starts_with('.'))
+				this->addWatch(entry.path(), true, existingFiles_);
+		}
+		else if (existingFiles_)
+			existingFiles_->push_back(fsx::fwd(entry.path()));
+	}
+}
+
+///////////////////////////////////////////////////
+void FileWatcher::readEvents(StrUMap<Path>& changes_, bool& overflowed_)
+{
+	alignas(inotify_event) char buffer[16 * 1024];
+
+	auto addChange = [&](Path path_) {
+			auto key = path_.string();
+			changes_.try_emplace(std::move(key), std::move(path_));
+		};
+
+	while (true)
+	{
+		auto numRead = ::read(fd, buffer, sizeof(buffer));
+		if (numRead <= 0)
+			break;
+
+		for (auto pos = buffer; pos < buffer + numRead; )
+		{
+			auto const& event = *reinterpret_cast<inotify_event const*>(pos);
+			pos += sizeof(inotify_event) + event.len;
+
+			// Events were lost (not tied to a watch)
+			if (event.mask & IN_Q_OVERFLOW)
+			{
+				overflowed_ = true;
+				continue;
+			}
+
+			auto it = folders.find(event.wd);
+			if (it == folders.end())
+				continue;
+
+			if (event.mask & IN_IGNORED)
+			{
+				watchDescriptors.erase(it->second.path.string());
+				folders.erase(it);
+				continue;
+			}
+
+			if (event.len == 0)
+				continue;
+
+			auto path = fsx::fwd(it->second.path / event.name);
+
+			// New folder: watch it and report the files that were created before the watch was added
+			if ((event.mask & IN_ISDIR) && (event.mask & (IN_CREATE | IN_MOVED_TO)))
+			{
+				if (it->second.recursive)
+				{
+					auto existingFiles = Vec<Path>();
+					this->addWatch(path, true, &existingFiles);
+					for (auto& file : existingFiles)
+						addChange(std::move(file));
+				}
+			}
+
+			addChange(std::move(path));
+		}
+	}
+}
+
+#else
+
+///////////////////////////////////////////////////
+FileWatcher::FileWatcher()
+{
+	throw PaccException("Watching files is supported only on Linux.");
+}
+
+///////////////////////////////////////////////////
+FileWatcher::~FileWatcher() = default;
+
+///////////////////////////////////////////////////
+void FileWatcher::watch(Path const& folder_, bool recursive_)
+{
+}
+
+///////////////////////////////////////////////////
+void FileWatcher::clear()
+{
+}
+
+///////////////////////////////////////////////////
+auto FileWatcher::waitForChanges(ch::milliseconds debounce_)
+	-> Changes
+{
+	return {};
+}
+
+#endif
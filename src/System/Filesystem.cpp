@@ -1,11 +1,14 @@
 #include "include/Pacc/PaccPCH.hpp"
 
 #include <Pacc/System/Filesystem.hpp>
+#include <Pacc/Helpers/String.hpp>
 
 #ifdef PACC_SYSTEM_WINDOWS
 	#include <Windows.h>
 #endif
 
+#include <random>
+
 namespace fsx
 {
 
@@ -173,4 +176,202 @@ fs::path readSymlinkOrJunction(fs::path const& path)
 	return fs::path();
 }
 
+//////////////////////////////////////
+static auto cacheKey(fs::path const& path_) -> String
+{
+	auto key = fwd(fs::absolute(path_).lexically_normal()).string();
+
+	while (key.size() > 1 && key.back() == '/')
+		key.pop_back();
+
+#ifdef PACC_SYSTEM_WINDOWS
+	// Windows paths are case-insensitive
+	rg::transform(key, key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+
+	return key;
+}
+
+//////////////////////////////////////
+auto DirectoryCache::exists(fs::path const& path_) -> bool
+{
+	auto type = this->typeOf(path_);
+	return type != fs::file_type::not_found && type != fs::file_type::none;
+}
+
+//////////////////////////////////////
+auto DirectoryCache::isRegularFile(fs::path const& path_) -> bool
+{
+	return this->typeOf(path_) == fs::file_type::regular;
+}
+
+//////////////////////////////////////
+auto DirectoryCache::isDirectory(fs::path const& path_) -> bool
+{
+	return this->typeOf(path_) == fs::file_type::directory;
+}
+
+//////////////////////////////////////
+void DirectoryCache::invalidate(fs::path const& path_)
+{
+	auto key = cacheKey(path_);
+
+	auto lock = std::lock_guard{mutex};
+	listings.erase(key);
+	listings.erase(cacheKey(fs::path(key).parent_path()));
+}
+
+//////////////////////////////////////
+void DirectoryCache::clear()
+{
+	auto lock = std::lock_guard{mutex};
+	listings.clear();
+}
+
+//////////////////////////////////////
+auto DirectoryCache::typeOf(fs::path const& path_) -> fs::file_type
+{
+	auto key 		= cacheKey(path_);
+	auto separator 	= key.rfind('/');
+
+	// Filesystem root (or a drive), nothing to list it from:
+	if (separator == String::npos || separator + 1 == key.size())
+	{
+		auto ec = std::error_code{};
+		return fs::status(path_, ec).type();
+	}
+
+	auto dir 	= key.substr(0, separator == 0 ? 1 : separator);
+	auto name 	= StringView(key).substr(separator + 1);
+
+	auto lock = std::lock_guard{mutex};
+	auto const& listing = this->listingOf(dir);
+
+	auto it = listing.entries.find(name);
+	if (it == listing.entries.end())
+		return fs::file_type::not_found;
+
+	return it->second;
+}
+
+//////////////////////////////////////
+auto DirectoryCache::listingOf(String const& dir_) -> Listing const&
+{
+	auto it = listings.find(dir_);
+	if (it != listings.end())
+		return it->second;
+
+	auto listing = Listing{};
+
+	auto ec = std::error_code{};
+	for (auto it = fs::directory_iterator(dir_, ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+	{
+		// The entry answers from the type read with the listing, only symlinks and unreported types are stat'ed:
+		auto entryEc 	= std::error_code{};
+		auto type 		= fs::file_type::unknown;
+		if (it->is_directory(entryEc))
+			type = fs::file_type::directory;
+		else if (it->is_regular_file(entryEc))
+			type = fs::file_type::regular;
+		else if (entryEc)
+			type = fs::file_type::not_found; // f.e. a broken symlink
+
+		auto name = it->path().filename().string();
+#ifdef PACC_SYSTEM_WINDOWS
+		rg::transform(name, name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+		listing.entries.emplace(std::move(name), type);
+	}
+
+	return listings.emplace(dir_, std::move(listing)).first->second;
+}
+
+//////////////////////////////////////
+auto dirCache() -> DirectoryCache&
+{
+	static DirectoryCache cache;
+	return cache;
+}
+
+//////////////////////////////////////
+auto globBase(StringView pattern_) -> std::pair<fs::path, bool>
+{
+	auto wildcard = pattern_.find_first_of("*?");
+	if (wildcard == StringView::npos)
+		return { fs::path(pattern_).parent_path(), false };
+
+	auto slash 		= pattern_.rfind('/', wildcard);
+	auto folder 	= (slash == StringView::npos) ? StringView(".") : pattern_.substr(0, slash);
+	auto recursive 	= pattern_.find("**") != StringView::npos || pattern_.find('/', wildcard) != StringView::npos;
+
+	return { fs::path(folder), recursive };
+}
+
+//////////////////////////////////////
+auto glob(StringView pattern_) -> Vec<fs::path>
+{
+	auto result = Vec<fs::path>();
+
+	// No wildcards
+	if (pattern_.find_first_of("*?") == StringView::npos)
+	{
+		if (fs::is_regular_file(pattern_))
+			result.push_back(fwd(pattern_));
+
+		return result;
+	}
+
+	auto [folder, recursive] = globBase(pattern_);
+
+	auto ec = std::error_code{};
+	auto tryAdd = [&](fs::directory_entry const& entry) {
+			auto path = fwd(entry.path());
+			if (entry.is_regular_file(ec) && matchesGlob(pattern_, path.string()))
+				result.push_back(std::move(path));
+		};
+
+	if (recursive)
+	{
+		for (auto it = fs::recursive_directory_iterator(folder, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+			tryAdd(*it);
+	}
+	else
+	{
+		for (auto it = fs::directory_iterator(folder, ec); !ec && it != fs::directory_iterator(); it.increment(ec))
+			tryAdd(*it);
+	}
+
+	rg::sort(result);
+	return result;
+}
+
+//////////////////////////////////////
+auto replaceFile(fs::path const& path_, StringView contents_) -> bool
+{
+	auto ec = std::error_code{};
+	fs::create_directories(path_.parent_path(), ec);
+
+	auto tempFile = path_;
+	tempFile += fmt::format(".{:08x}.tmp", std::random_device{}());
+	{
+		auto stream = std::ofstream(tempFile, std::ios::binary);
+		stream.write(contents_.data(), std::streamsize(contents_.size()));
+		if (!stream)
+		{
+			stream.close();
+			fs::remove(tempFile, ec);
+			return false;
+		}
+	}
+
+	fs::rename(tempFile, path_, ec);
+	if (ec)
+	{
+		fs::remove(tempFile, ec);
+		return false;
+	}
+
+	return true;
+}
+
 }
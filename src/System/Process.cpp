@@ -2,10 +2,14 @@
 
 
 #include <Pacc/System/Process.hpp>
+#include <Pacc/Helpers/Tracing.hpp>
 
 ///////////////////////////////////////
 ChildProcess::ExitCode ChildProcess::runSync()
 {
+	auto span = tracing::Span("ChildProcess", "process");
+	span.arg("command", command).arg("workingDirectory", workingDirectory.string());
+
 	auto prevWorkingDirectory = fs::current_path();
 	if (workingDirectory != "")
 		fs::current_path(workingDirectory);
@@ -0,0 +1,372 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include <Pacc/System/Socket.hpp>
+
+#include <Pacc/Helpers/Exceptions.hpp>
+
+#ifdef PACC_SYSTEM_LINUX
+	#include <unistd.h>
+	#include <netdb.h>
+	#include <arpa/inet.h>
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
+#endif
+
+#include <cstring>
+
+constexpr StringView UnixPrefix = "unix:";
+
+namespace net
+{
+
+#ifdef PACC_SYSTEM_LINUX
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto unixAddress(StringView path_, sockaddr_un& addr_) -> bool;
+static auto resolveTcp(StringView address_, bool passive_) -> addrinfo*;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+void FileDescriptor::close()
+{
+	if (fd >= 0)
+		::close(fd);
+	fd = -1;
+}
+
+///////////////////////////////////////////////////
+auto writeAll(int fd_, void const* data_, std::size_t size_) -> bool
+{
+	auto data = static_cast<char const*>(data_);
+	while (size_ > 0)
+	{
+		// Not `write`, a closed connection must not raise SIGPIPE
+		auto written = ::send(fd_, data, size_, MSG_NOSIGNAL);
+		if (written < 0 && errno == ENOTSOCK)
+			written = ::write(fd_, data, size_);
+
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			return false;
+
+		data 	+= written;
+		size_ 	-= std::size_t(written);
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////
+auto readAll(int fd_, void* data_, std::size_t size_) -> bool
+{
+	auto data = static_cast<char*>(data_);
+	while (size_ > 0)
+	{
+		auto numRead = ::read(fd_, data, size_);
+		if (numRead < 0 && errno == EINTR)
+			continue;
+		if (numRead <= 0)
+			return false;
+
+		data 	+= numRead;
+		size_ 	-= std::size_t(numRead);
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////
+auto writeFrame(int fd_, StringView data_) -> bool
+{
+	if (data_.size() > std::numeric_limits<uint32_t>::max())
+		return false;
+
+	auto size = htonl(uint32_t(data_.size()));
+	return writeAll(fd_, &size, sizeof(size)) && writeAll(fd_, data_.data(), data_.size());
+}
+
+///////////////////////////////////////////////////
+auto readFrame(int fd_, std::size_t maxSize_) -> Opt<String>
+{
+	auto size = uint32_t(0);
+	if (!readAll(fd_, &size, sizeof(size)))
+		return std::nullopt;
+
+	size = ntohl(size);
+	if (size > maxSize_)
+		return std::nullopt;
+
+	auto data = String(size, '\0');
+	if (!readAll(fd_, data.data(), data.size()))
+		return std::nullopt;
+
+	return data;
+}
+
+///////////////////////////////////////////////////
+auto connectTo(StringView address_, Opt<ch::milliseconds> timeout_) -> int
+{
+	auto fd = -1;
+
+	// On Linux the send timeout limits the time `connect` waits too
+	auto connectWithTimeout = [&](sockaddr const* addr_, socklen_t addrSize_) {
+			if (timeout_)
+			{
+				auto tv = timeval{};
+				tv.tv_sec 	= long(timeout_->count() / 1000);
+				tv.tv_usec 	= long(timeout_->count() % 1000) * 1000;
+				::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+			}
+
+			if (::connect(fd, addr_, addrSize_) != 0)
+				return false;
+
+			if (timeout_)
+			{
+				auto none = timeval{};
+				::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &none, sizeof(none));
+			}
+			return true;
+		};
+
+	if (address_.starts_with(UnixPrefix))
+	{
+		auto addr = sockaddr_un{};
+		if (!unixAddress(address_.substr(UnixPrefix.size()), addr))
+			return -1;
+
+		fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd >= 0 && !connectWithTimeout(reinterpret_cast<sockaddr*>(&addr), sizeof(addr)))
+		{
+			::close(fd);
+			fd = -1;
+		}
+		return fd;
+	}
+
+	auto resolved = resolveTcp(address_, false);
+	for (auto info = resolved; info; info = info->ai_next)
+	{
+		fd = ::socket(info->ai_family, info->ai_socktype | SOCK_CLOEXEC, info->ai_protocol);
+		if (fd < 0)
+			continue;
+
+		if (connectWithTimeout(info->ai_addr, info->ai_addrlen))
+		{
+			auto noDelay = 1;
+			::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+			break;
+		}
+
+		::close(fd);
+		fd = -1;
+	}
+
+	if (resolved)
+		::freeaddrinfo(resolved);
+
+	return fd;
+}
+
+///////////////////////////////////////////////////
+void setReceiveTimeout(int fd_, ch::milliseconds timeout_)
+{
+	auto tv = timeval{};
+	tv.tv_sec 	= long(timeout_.count() / 1000);
+	tv.tv_usec 	= long(timeout_.count() % 1000) * 1000;
+	::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+///////////////////////////////////////////////////
+auto listenOn(StringView address_) -> int
+{
+	auto fd = FileDescriptor();
+
+	if (address_.starts_with(UnixPrefix))
+	{
+		auto path = address_.substr(UnixPrefix.size());
+
+		auto addr = sockaddr_un{};
+		if (!unixAddress(path, addr))
+			throw PaccException("Invalid socket path \"{}\" (empty or too long).", path);
+
+		// Left behind by a process that did not exit cleanly
+		if (auto probe = FileDescriptor(connectTo(address_)); probe.fd >= 0)
+			throw PaccException("Address \"{}\" is already in use.", address_);
+
+		::unlink(addr.sun_path);
+
+		fd.fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd.fd < 0
+			|| ::bind(fd.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0
+			|| ::listen(fd.fd, 64) != 0)
+		{
+			throw PaccException("Could not listen on \"{}\" ({}).", address_, std::strerror(errno));
+		}
+
+		::chmod(addr.sun_path, S_IRUSR | S_IWUSR);
+	}
+	else
+	{
+		auto resolved = resolveTcp(address_, true);
+		if (!resolved)
+		{
+			throw PaccException("Invalid address \"{}\".", address_)
+				.withHelp("Use \"host:port\" (f.e. \"127.0.0.1:7340\") or \"unix:/path/to/socket\".");
+		}
+
+		fd.fd = ::socket(resolved->ai_family, resolved->ai_socktype | SOCK_CLOEXEC, resolved->ai_protocol);
+
+		auto reuse = 1;
+		auto ok = fd.fd >= 0
+			&& ::setsockopt(fd.fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) == 0
+			&& ::bind(fd.fd, resolved->ai_addr, resolved->ai_addrlen) == 0
+			&& ::listen(fd.fd, 64) == 0;
+
+		auto error = errno;
+		::freeaddrinfo(resolved);
+
+		if (!ok)
+			throw PaccException("Could not listen on \"{}\" ({}).", address_, std::strerror(error));
+	}
+
+	return std::exchange(fd.fd, -1);
+}
+
+///////////////////////////////////////////////////
+auto isLocalAddress(StringView address_) -> bool
+{
+	if (address_.starts_with(UnixPrefix))
+		return true;
+
+	// Without a host, listens on all interfaces
+	auto resolved = resolveTcp(address_, true);
+	if (!resolved)
+		return false;
+
+	auto local = true;
+	for (auto info = resolved; info; info = info->ai_next)
+	{
+		if (info->ai_family == AF_INET)
+			local = local && (ntohl(reinterpret_cast<sockaddr_in*>(info->ai_addr)->sin_addr.s_addr) >> 24) == 127;
+		else if (info->ai_family == AF_INET6)
+			local = local && IN6_IS_ADDR_LOOPBACK(&reinterpret_cast<sockaddr_in6*>(info->ai_addr)->sin6_addr);
+		else
+			local = false;
+	}
+
+	::freeaddrinfo(resolved);
+	return local;
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static auto unixAddress(StringView path_, sockaddr_un& addr_) -> bool
+{
+	addr_ = {};
+	addr_.sun_family = AF_UNIX;
+	if (path_.empty() || path_.size() >= sizeof(addr_.sun_path))
+		return false;
+
+	std::memcpy(addr_.sun_path, path_.data(), path_.size());
+	return true;
+}
+
+///////////////////////////////////////////////////
+/// <summary>Resolves "host:port" (IPv6 hosts in brackets, f.e. "[::1]:7340").</summary>
+/// <returns>The addresses (free with <c>freeaddrinfo</c>) or <c>nullptr</c>.</returns>
+static auto resolveTcp(StringView address_, bool passive_) -> addrinfo*
+{
+	auto colon = address_.rfind(':');
+	if (colon == StringView::npos || colon + 1 == address_.size())
+		return nullptr;
+
+	auto host = String(address_.substr(0, colon));
+	auto port = String(address_.substr(colon + 1));
+
+	if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+		host = host.substr(1, host.size() - 2);
+
+	auto hints = addrinfo{};
+	hints.ai_family 	= AF_UNSPEC;
+	hints.ai_socktype 	= SOCK_STREAM;
+	hints.ai_flags 		= passive_ ? AI_PASSIVE : 0;
+
+	auto result = static_cast<addrinfo*>(nullptr);
+	if (::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result) != 0)
+		return nullptr;
+
+	return result;
+}
+
+#else
+
+///////////////////////////////////////////////////
+void FileDescriptor::close()
+{
+	fd = -1;
+}
+
+///////////////////////////////////////////////////
+auto writeAll(int fd_, void const* data_, std::size_t size_) -> bool
+{
+	return false;
+}
+
+///////////////////////////////////////////////////
+auto readAll(int fd_, void* data_, std::size_t size_) -> bool
+{
+	return false;
+}
+
+///////////////////////////////////////////////////
+auto writeFrame(int fd_, StringView data_) -> bool
+{
+	return false;
+}
+
+///////////////////////////////////////////////////
+auto readFrame(int fd_, std::size_t maxSize_) -> Opt<String>
+{
+	return std::nullopt;
+}
+
+///////////////////////////////////////////////////
+auto connectTo(StringView address_, Opt<ch::milliseconds> timeout_) -> int
+{
+	return -1;
+}
+
+///////////////////////////////////////////////////
+void setReceiveTimeout(int fd_, ch::milliseconds timeout_)
+{
+}
+
+///////////////////////////////////////////////////
+auto listenOn(StringView address_) -> int
+{
+	throw PaccException("Listening on \"{}\" is supported only on Linux.", address_);
+}
+
+///////////////////////////////////////////////////
+auto isLocalAddress(StringView address_) -> bool
+{
+	return false;
+}
+
+#endif
+
+}
@@ -7,6 +7,8 @@
 #include <Pacc/System/Process.hpp>
 #include <Pacc/Generation/Logs.hpp>
 #include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/PackageSystem/Version.hpp>
+#include <Pacc/Build/DistributedBuild.hpp>
 
 ///////////////////////////////////////////////
 Vec<GNUMakeToolchain> GNUMakeToolchain::detect()
@@ -78,6 +80,12 @@ Opt<int> GNUMakeToolchain::run(Package const & pkg_, BuildSettings settings_, in
 
 	fmt::print(fg(color::gray), "Running GNU Make... {}", verbose ? "\n" : "");
 
+	// Distributed build or link pool: make runs the compilers through the pacc launcher,
+	// which sends the compilations to the workers and lets links wait for a slot of the pool
+	auto launcher = String();
+	if (!settings_.workers.empty() || settings_.linkPool)
+		launcher = fmt::format("{} {} ", env::getPaccAppPath().string(), distributed::LauncherAction);
+
 	Vec<String> params =
 		{
 			// Note: this probably won't work on configurations with spaces in names
@@ -85,13 +93,38 @@ Opt<int> GNUMakeToolchain::run(Package const & pkg_, BuildSettings settings_, in
 					toLower(settings_.configName),
 					toLower(settings_.platformName)
 				),
-			fmt::format("CXX={}", cppCompilerName),
-			fmt::format("CC={}", cCompilerName)
+			fmt::format("CXX={}{}", launcher, cppCompilerName),
+			fmt::format("CC={}{}", launcher, cCompilerName)
 		};
 
-	if (settings_.cores.has_value())
+	// Command line variables are exported to the commands run by make
+	if (!settings_.workers.empty())
+	{
+		auto workers = String();
+		for (auto const& address : settings_.workers)
+			workers += (workers.empty() ? "" : ";") + address;
+
+		params.push_back(fmt::format("{}={}", distributed::WorkersVariable, workers));
+	}
+
+	// Otherwise make takes its jobs from the jobserver in MAKEFLAGS
+	if (settings_.cores.has_value() && !settings_.sharedJobServer)
 		params.push_back(fmt::format("-j{}", settings_.cores.value()));
 
+	// Make does not know about changed flags, build all targets unconditionally
+	if (settings_.rebuild)
+		params.push_back("-B");
+
+	// Only the specified projects (make targets), separated with ';'
+	for (auto targets = StringView(settings_.targetName); !targets.empty(); )
+	{
+		auto end = targets.find(';');
+		if (auto target = targets.substr(0, end); !target.empty())
+			params.push_back(String(target));
+
+		targets.remove_prefix(end == StringView::npos ? targets.size() : end + 1);
+	}
+
 	String buildCommand = (mainPath / "make").string();
 	for(auto p : params)
 		buildCommand += fmt::format(" \"{}\"", p);
@@ -147,3 +180,50 @@ bool GNUMakeToolchain::deserialize(json const& in_)
 
 	return true;
 }
+
+///////////////////////////////////////////////
+bool GNUMakeToolchain::supportsJobServer() const
+{
+	try {
+		return Version::fromString(version) >= Version{ 4, 4, 0 };
+	}
+	catch(...) {
+		return false;
+	}
+}
+
+///////////////////////////////////////////////
+bool GNUMakeToolchain::cmakeGeneratorSupportsJobServer() const
+{
+	if (!this->supportsJobServer())
+		return false;
+
+	if (this->cmakeGenerator() != "Ninja")
+		return true;
+
+	// Ninja prints just the version, f.e. "1.11.1"
+	static const bool ninjaSupportsJobServer = []
+		{
+			auto proc = ChildProcess{"ninja --version", "", ch::milliseconds{2500}};
+			if (proc.runSync().value_or(1) != 0)
+				return false;
+
+			try {
+				auto const& out = proc.out.stdOut;
+				return Version::fromString(out.substr(0, out.find_first_of("\r\n"))) >= Version{ 1, 13, 0 };
+			}
+			catch(...) {
+				return false;
+			}
+		}();
+
+	return ninjaSupportsJobServer;
+}
+
+///////////////////////////////////////////////
+String GNUMakeToolchain::cmakeGenerator() const
+{
+	static const bool hasNinja = !env::findExecutable("ninja").empty();
+
+	return hasNinja ? "Ninja" : "Unix Makefiles";
+}
@@ -4,6 +4,7 @@
 #include <Pacc/System/Process.hpp>
 #include <Pacc/Generation/Logs.hpp>
 #include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/Helpers/String.hpp>
 
 #include <ranges>
 
@@ -135,8 +136,15 @@ Opt<int> MSVCToolchain::run(Package const& pkg_, BuildSettings settings_, int ve
 		"/property:GenerateFullPaths=true"
 	};
 
+	auto targetAction = settings_.rebuild ? StringView("rebuild") : StringView("build");
 	if (settings_.targetName.empty())
-		params.push_back("/t:build");
+		params.push_back(fmt::format("/t:{}", targetAction));
+	else if (settings_.rebuild)
+	{
+		// Projects separated with ';', each as "Name:Rebuild"
+		params.push_back("/t:" + replaceAll(settings_.targetName, ";", ":Rebuild;") + ":Rebuild");
+		params.push_back("/p:BuildProjectReferences=false");
+	}
 	else
 	{
 		params.push_back("/t:" + settings_.targetName);
@@ -202,3 +210,17 @@ String MSVCToolchain::premakeToolchainType() const
 	default: return "vs2019"; // not found
 	}
 }
+
+///////////////////////////////
+String MSVCToolchain::cmakeGenerator() const
+{
+	switch(lineVersion)
+	{
+	case LineVersion::VS2022: return "Visual Studio 17 2022";
+	case LineVersion::VS2019: return "Visual Studio 16 2019";
+	case LineVersion::VS2017: return "Visual Studio 15 2017";
+	case LineVersion::VS2015: return "Visual Studio 14 2015";
+	case LineVersion::VS2013: return "Visual Studio 12 2013";
+	default: return "Visual Studio 16 2019"; // not found
+	}
+}
@@ -25,6 +25,24 @@ String Toolchain::premakeToolchainType() const
 	return "";
 }
 
+////////////////////////////////////////////
+String Toolchain::cmakeGenerator() const
+{
+	return "";
+}
+
+////////////////////////////////////////////
+bool Toolchain::supportsJobServer() const
+{
+	return false;
+}
+
+////////////////////////////////////////////
+bool Toolchain::cmakeGeneratorSupportsJobServer() const
+{
+	return false;
+}
+
 ////////////////////////////////////////////
 Toolchain::Type Toolchain::type() const
 {
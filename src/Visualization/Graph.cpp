@@ -2,13 +2,388 @@
 
 #include <Pacc/Visualization/Graph.hpp>
 #include <Pacc/PackageSystem/Package.hpp>
+#include <Pacc/Generation/Logs.hpp>
+#include <Pacc/Helpers/JsonWriter.hpp>
+#include <Pacc/Helpers/String.hpp>
+#include <Pacc/System/Filesystem.hpp>
 
 namespace viz
 {
 
-auto generateGraphContent(Package const& root_) -> String
+using PackageNode 	= BuildGraph::PackageNode;
+using ProjectNode 	= BuildGraph::ProjectNode;
+using Edge 			= BuildGraph::Edge;
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static void computeCriticalPath(BuildGraph& graph_, Vec<USet<std::size_t>> const& packageDeps_);
+static void writeDot(std::ostream& out_, BuildGraph const& graph_);
+static void writeJson(std::ostream& out_, BuildGraph const& graph_);
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+auto parseGraphFormat(StringView str_) -> Opt<GraphFormat>
+{
+	if (compareIgnoreCase(str_, "dot")) 	return GraphFormat::Dot;
+	if (compareIgnoreCase(str_, "json")) 	return GraphFormat::Json;
+	return std::nullopt;
+}
+
+///////////////////////////////////////////////////
+auto BuildGraph::build(Package const& root_, BuildQueueBuilder::DepQueue const& queue_, StrUMap<double> const& buildDurations_)
+	-> BuildGraph
+{
+	auto graph = BuildGraph();
+
+	// Packages: the root and every package dependency of the queue
+	auto packageIndex = UMap<Package const*, std::size_t>();
+
+	auto addPackage = [&](Package const& pkg_)
+		{
+			if (packageIndex.contains(&pkg_))
+				return;
+
+			auto node = PackageNode{ &pkg_ };
+			if (auto it = buildDurations_.find(buildDurationKey(pkg_.rootFolder())); it != buildDurations_.end())
+				node.buildMs = it->second;
+
+			packageIndex.emplace(&pkg_, graph.packages.size());
+			graph.packages.push_back(node);
+		};
+
+	addPackage(root_);
+	for (auto const& step : queue_)
+	{
+		for (auto const& pd : step)
+		{
+			if (pd.dep->isPackage())
+				addPackage(*pd.dep->package().package);
+		}
+	}
+
+	// Projects:
+	auto projectIndex = UMap<Project const*, std::size_t>();
+	for (std::size_t i = 0; i < graph.packages.size(); ++i)
+	{
+		for (auto const& project : graph.packages[i].package->projects)
+		{
+			projectIndex.emplace(&project, graph.projects.size());
+			graph.projects.push_back({ &project, i });
+		}
+	}
+
+	// Edges:
+	auto packageDeps = Vec<USet<std::size_t>>(graph.packages.size());
+
+	auto addEdge = [&](Project const* from_, Project const* to_, AccessType access_)
+		{
+			auto fromIt = projectIndex.find(from_);
+			auto toIt 	= projectIndex.find(to_);
+			if (fromIt == projectIndex.end() || toIt == projectIndex.end())
+				return;
+
+			graph.edges.push_back({ fromIt->second, toIt->second, access_ });
+
+			auto fromPkg 	= graph.projects[fromIt->second].package;
+			auto toPkg 		= graph.projects[toIt->second].package;
+			if (fromPkg != toPkg)
+				packageDeps[fromPkg].insert(toPkg);
+		};
+
+	for (auto const& step : queue_)
+	{
+		for (auto const& pd : step)
+		{
+			if (pd.dep->isSelf())
+			{
+				auto const& self = pd.dep->self();
+				addEdge(pd.project, self.package->findProject(self.depProjName), pd.dep->accessType);
+			}
+			else if (pd.dep->isPackage())
+			{
+				auto const& pkgDep = pd.dep->package();
+				for (auto const& projectName : pkgDep.projects)
+					addEdge(pd.project, pkgDep.package->findProject(projectName), pd.dep->accessType);
+			}
+		}
+	}
+
+	computeCriticalPath(graph, packageDeps);
+
+	return graph;
+}
+
+///////////////////////////////////////////////////
+void writeGraph(std::ostream& out_, BuildGraph const& graph_, GraphFormat format_)
+{
+	if (format_ == GraphFormat::Json)
+		writeJson(out_, graph_);
+	else
+		writeDot(out_, graph_);
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static void computeCriticalPath(BuildGraph& graph_, Vec<USet<std::size_t>> const& packageDeps_)
 {
+	graph_.measured = rg::any_of(graph_.packages, [](PackageNode const& p) { return p.buildMs.has_value(); });
+
+	// Unmeasured packages do not add time, unless nothing was measured (then the longest chain wins).
+	auto weight = [&](PackageNode const& p) {
+			return graph_.measured ? p.buildMs.value_or(0.0) : 1.0;
+		};
+
+	// Packages are finished in reverse topological order (dependencies first):
+	enum class State { New, Visiting, Done };
+	auto states = Vec<State>(graph_.packages.size(), State::New);
+	auto stack 	= Vec<std::pair<std::size_t, bool>>{ { 0, false } }; // (package, dependencies finished)
+
+	while (!stack.empty())
+	{
+		auto [idx, depsFinished] = stack.back();
+		stack.pop_back();
+
+		auto& node = graph_.packages[idx];
+
+		if (depsFinished)
+		{
+			node.finishMs = weight(node);
+			for (auto dep : packageDeps_[idx])
+			{
+				auto candidate = weight(node) + graph_.packages[dep].finishMs;
+				if (!node.next || candidate > node.finishMs)
+				{
+					node.finishMs 	= candidate;
+					node.next 		= dep;
+				}
+			}
+			states[idx] = State::Done;
+			continue;
+		}
+
+		if (states[idx] != State::New)
+			continue; // reached through another dependant
+
+		states[idx] = State::Visiting;
+		stack.emplace_back(idx, true);
+
+		for (auto dep : packageDeps_[idx])
+		{
+			if (states[dep] == State::New)
+				stack.emplace_back(dep, false);
+		}
+	}
+
+	for (auto idx = Opt<std::size_t>(0); idx; idx = graph_.packages[*idx].next)
+	{
+		graph_.packages[*idx].critical = true;
+		graph_.criticalPath.push_back(*idx);
+	}
+
+	graph_.criticalPathMs = graph_.measured ? graph_.packages[0].finishMs : 0.0;
+
+	// Edges between consecutive packages of the path:
+	auto onPath = Vec<Opt<std::size_t>>(graph_.packages.size()); // package -> next package on the path
+	for (std::size_t i = 0; i + 1 < graph_.criticalPath.size(); ++i)
+		onPath[graph_.criticalPath[i]] = graph_.criticalPath[i + 1];
+
+	for (auto& edge : graph_.edges)
+	{
+		auto fromPkg = graph_.projects[edge.from].package;
+		edge.critical = onPath[fromPkg] == graph_.projects[edge.to].package;
+	}
+}
+
+///////////////////////////////////////////////////
+static auto accessName(AccessType access_) -> StringView
+{
+	switch (access_)
+	{
+	case AccessType::Private: 	return "private";
+	case AccessType::Public: 	return "public";
+	case AccessType::Interface: return "interface";
+	}
 	return "";
 }
 
+///////////////////////////////////////////////////
+static auto formatDuration(Opt<double> ms_) -> String
+{
+	if (!ms_)
+		return "not built yet";
+
+	if (*ms_ < 1000)
+		return fmt::format("{:.0f} ms", *ms_);
+
+	return fmt::format("{:.1f} s", *ms_ / 1000.0);
+}
+
+///////////////////////////////////////////////////
+/// <summary>Escapes a DOT string (without quotes).</summary>
+static auto escapeDot(StringView str_) -> String
+{
+	auto result = String();
+	result.reserve(str_.size());
+	for (char c : str_)
+	{
+		if (c == '"' || c == '\\')
+			result += '\\';
+		result += c;
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////
+static void writeDot(std::ostream& out_, BuildGraph const& graph_)
+{
+	constexpr std::size_t FlushThreshold = 64 * 1024;
+
+	auto buffer = fmt::memory_buffer();
+	auto write = [&](auto&& format_, auto&&... args_)
+		{
+			fmt::format_to(std::back_inserter(buffer), fmt::runtime(format_), std::forward<decltype(args_)>(args_)...);
+			if (buffer.size() >= FlushThreshold)
+			{
+				out_.write(buffer.data(), std::streamsize(buffer.size()));
+				buffer.clear();
+			}
+		};
+
+	auto const& root = *graph_.packages[0].package;
+
+	auto pathNames = Vec<String>();
+	for (auto idx : graph_.criticalPath)
+		pathNames.push_back(graph_.packages[idx].package->name);
+
+	auto pathLabel = graph_.measured
+		? fmt::format("Critical path: {} ({})", fmt::join(pathNames, " -> "), formatDuration(graph_.criticalPathMs))
+		: fmt::format("Longest dependency chain: {} (no build durations recorded)", fmt::join(pathNames, " -> "));
+
+	write("digraph \"{}\" {{\n", escapeDot(root.name));
+	write("\tgraph [rankdir=LR, fontname=\"Helvetica\", labelloc=t, label=\"{}\"];\n", escapeDot(pathLabel));
+	write("\tnode [shape=box, style=\"rounded,filled\", fillcolor=white, fontname=\"Helvetica\"];\n");
+	write("\tedge [color=gray40];\n");
+
+	// Packages as clusters of their projects (projects are grouped by package):
+	auto projectIdx = std::size_t(0);
+	for (std::size_t i = 0; i < graph_.packages.size(); ++i)
+	{
+		auto const& node 	= graph_.packages[i];
+		auto const& pkg 	= *node.package;
+
+		write("\n\tsubgraph \"cluster_{}\" {{\n", i);
+		write("\t\tlabel=\"{} {}\\n{}\";\n", escapeDot(pkg.name), pkg.version.toString(), formatDuration(node.buildMs));
+		if (node.critical)
+			write("\t\tcolor=red; penwidth=2; fontcolor=red;\n");
+		else
+			write("\t\tcolor=gray60;\n");
+
+		for (; projectIdx < graph_.projects.size() && graph_.projects[projectIdx].package == i; ++projectIdx)
+		{
+			auto const& project = *graph_.projects[projectIdx].project;
+			write("\t\tn{} [label=\"{}\\n({})\"{}];\n",
+					projectIdx, escapeDot(project.name), toString(project.type),
+					node.critical ? ", fillcolor=mistyrose" : ""
+				);
+		}
+
+		write("\t}}\n");
+	}
+
+	write("\n");
+	for (auto const& edge : graph_.edges)
+	{
+		write("\tn{} -> n{} [{}{}];\n",
+				edge.from, edge.to,
+				edge.access == AccessType::Interface ? "style=dashed" : (edge.access == AccessType::Public ? "style=bold" : "style=solid"),
+				edge.critical ? ", color=red, penwidth=2" : ""
+			);
+	}
+
+	write("}}\n");
+	out_.write(buffer.data(), std::streamsize(buffer.size()));
+}
+
+///////////////////////////////////////////////////
+static void writeJson(std::ostream& out_, BuildGraph const& graph_)
+{
+	auto w = JsonWriter(out_);
+
+	w.beginObject();
+	w.field("root", graph_.packages[0].package->name);
+
+	w.key("packages").beginArray();
+	auto projectIdx = std::size_t(0);
+	for (std::size_t i = 0; i < graph_.packages.size(); ++i)
+	{
+		auto const& node 	= graph_.packages[i];
+		auto const& pkg 	= *node.package;
+
+		w.beginObject();
+		w.field("id", i);
+		w.field("name", pkg.name);
+		w.field("version", pkg.version.toString());
+		w.field("folder", fsx::fwd(pkg.rootFolder()).string());
+
+		w.key("buildMs");
+		if (node.buildMs)
+			w.value(*node.buildMs);
+		else
+			w.null();
+
+		w.field("critical", node.critical);
+
+		w.key("projects").beginArray();
+		for (; projectIdx < graph_.projects.size() && graph_.projects[projectIdx].package == i; ++projectIdx)
+		{
+			auto const& project = *graph_.projects[projectIdx].project;
+			w.beginObject()
+				.field("id", projectIdx)
+				.field("name", project.name)
+				.field("type", toString(project.type))
+				.endObject();
+		}
+		w.endArray();
+
+		w.endObject();
+	}
+	w.endArray();
+
+	w.key("edges").beginArray();
+	for (auto const& edge : graph_.edges)
+	{
+		w.beginObject()
+			.field("from", edge.from)
+			.field("to", edge.to)
+			.field("access", accessName(edge.access))
+			.field("critical", edge.critical)
+			.endObject();
+	}
+	w.endArray();
+
+	w.key("criticalPath").beginObject();
+	w.key("packages").beginArray();
+	for (auto idx : graph_.criticalPath)
+		w.value(idx);
+	w.endArray();
+	w.key("buildMs");
+	if (graph_.measured)
+		w.value(graph_.criticalPathMs);
+	else
+		w.null();
+	w.endObject();
+
+	w.endObject();
+}
+
 }
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+/// <summary>Benchmark parameters, passed as "key=value" arguments.</summary>
+struct BenchmarkOptions
+{
+	StrUMap<String> values;
+
+	auto get(StringView key_, std::size_t default_) const -> std::size_t
+	{
+		auto it = values.find(key_);
+		if (it == values.end())
+			return default_;
+
+		return std::stoull(it->second);
+	}
+};
+
+/// <summary>Results of all benchmarks that were run, saved as JSON with "--json=file".</summary>
+struct BenchmarkReport
+{
+	json 	results = json::object();
+	json* 	current = nullptr; // entry of the running benchmark
+
+	static auto get() -> BenchmarkReport&
+	{
+		static auto report = BenchmarkReport();
+		return report;
+	}
+
+	void parameter(StringView name_, json value_)
+	{
+		(*current)["parameters"][String(name_)] = std::move(value_);
+	}
+
+	/// <summary>Prints the median and the best time and stores them in the results.</summary>
+	void times(StringView name_, Vec<double> times_)
+	{
+		rg::sort(times_);
+
+		auto median = times_[times_.size() / 2];
+		fmt::print("{:<40} median: {:>10.3f} ms, best: {:>10.3f} ms ({} runs)\n", name_, median, times_.front(), times_.size());
+
+		(*current)["measurements"][String(name_)] = {
+				{ "median_ms", 	median },
+				{ "best_ms", 	times_.front() },
+				{ "runs", 		times_.size() }
+			};
+	}
+};
+
+/// <summary>Runs the function `iterations_` times and reports the median and the best time.</summary>
+template <typename TFunc>
+void measure(StringView name_, std::size_t iterations_, TFunc&& func_)
+{
+	auto times = Vec<double>();
+	times.reserve(iterations_);
+
+	for (std::size_t i = 0; i < iterations_; ++i)
+	{
+		auto start = ch::steady_clock::now();
+		func_();
+		times.push_back( ch::duration<double, std::milli>(ch::steady_clock::now() - start).count() );
+	}
+
+	BenchmarkReport::get().times(name_, std::move(times));
+}
+
+// Benchmarks:
+void benchReadPackageJson(BenchmarkOptions const& options_);
+void benchPlanner(BenchmarkOptions const& options_);
+void benchFileHasher(BenchmarkOptions const& options_);
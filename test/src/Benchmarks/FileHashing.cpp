@@ -0,0 +1,143 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "Benchmarks.hpp"
+
+#include <Pacc/System/FileHasher.hpp>
+
+///////////////////////////////////////////////////
+/// <summary>Writes the files (of slightly different sizes) into folders of 1000 files.</summary>
+static auto generateFiles(Path const& root_, std::size_t numFiles_, std::size_t fileSize_) -> Vec<Path>
+{
+	auto ec = std::error_code{};
+	fs::remove_all(root_, ec);
+
+	// Old enough to be remembered by the hasher
+	auto mtime = fs::file_time_type::clock::now() - ch::hours(1);
+
+	auto files = Vec<Path>();
+	files.reserve(numFiles_);
+
+	auto content = String(fileSize_ + 64, 'x');
+	for (std::size_t i = 0; i < numFiles_; ++i)
+	{
+		auto folder = root_ / fmt::format("folder{}", i / 1000);
+		if (i % 1000 == 0)
+			fs::create_directories(folder);
+
+		auto path = folder / fmt::format("file{}.cpp", i);
+		auto size = fileSize_ + (i % 64);
+		content[i % size] = char('a' + i % 26);
+
+		std::ofstream(path, std::ios::binary).write(content.data(), std::streamsize(size));
+		fs::last_write_time(path, mtime);
+
+		files.push_back(std::move(path));
+	}
+
+	return files;
+}
+
+///////////////////////////////////////////////////
+void benchFileHasher(BenchmarkOptions const& options_)
+{
+	auto const NumFiles 	= options_.get("files", 100'000);
+	auto const FileSize 	= options_.get("size", 4096);
+	auto const NumRuns 		= options_.get("runs", 5);
+
+	auto& report = BenchmarkReport::get();
+	report.parameter("files", 	NumFiles);
+	report.parameter("size", 	FileSize);
+
+	auto root 		= fs::temp_directory_path() / "pacc-bench-file-hasher";
+	auto tableFile 	= root / "file_hashes.bin";
+	auto files 		= generateFiles(root / "tree", NumFiles, FileSize);
+
+	auto totalBytes = double(NumFiles) * double(FileSize);
+	fmt::print("{} files x ~{} bytes ({:.1f} MiB), in the OS file cache\n", NumFiles, FileSize, totalBytes / (1024 * 1024));
+
+	auto timed = [](Vec<double>& times_, auto&& func_)
+		{
+			auto start = ch::steady_clock::now();
+			func_();
+			times_.push_back( ch::duration<double, std::milli>(ch::steady_clock::now() - start).count() );
+		};
+
+	// The hash functions alone, on a buffer of the same total size (at most 256 MiB)
+	{
+		auto buffer = String(std::min<std::size_t>(NumFiles * FileSize, 256u << 20), 'x');
+		for (std::size_t i = 0; i < buffer.size(); i += 4096)
+			buffer[i] = char(i);
+
+		auto fast = Vec<double>();
+		auto fnv1a = Vec<double>();
+		for (std::size_t i = 0; i < NumRuns; ++i)
+		{
+			timed(fast, [&]{
+					if (fastHash128(buffer) == Hash128{}) std::abort();
+				});
+
+			timed(fnv1a, [&]{
+					auto hash = Fnv1a();
+					hash.addBytes(buffer);
+					if (hash.digest() == 0) std::abort();
+				});
+		}
+
+		auto mibPerSecond = [&](Vec<double> const& times_) {
+				return double(buffer.size()) / (1024 * 1024) / (*rg::min_element(times_) / 1000);
+			};
+
+		fmt::print("fastHash128: {:.0f} MiB/s, Fnv1a: {:.0f} MiB/s\n", mibPerSecond(fast), mibPerSecond(fnv1a));
+		report.parameter("buffer", buffer.size());
+		report.times("fastHash128 (buffer)", std::move(fast));
+		report.times("Fnv1a (buffer)", std::move(fnv1a));
+	}
+
+	auto ec = std::error_code{};
+
+	// Every file read and hashed
+	measure("FileHasher::hashAll (no table)", NumRuns, [&]{
+			fs::remove(tableFile, ec);
+
+			auto hasher = FileHasher(tableFile);
+			hasher.hashAll(files);
+			if (hasher.stats().read != NumFiles) std::abort();
+		});
+
+	{
+		auto hasher = FileHasher(tableFile);
+		hasher.hashAll(files);
+		measure("FileHasher::save", 1, [&]{ hasher.save(); });
+	}
+
+	// Only stat calls, the hashes come from the table
+	measure("FileHasher (table loaded, unchanged)", NumRuns, [&]{
+			auto hasher = FileHasher(tableFile);
+			hasher.hashAll(files);
+			if (hasher.stats().reused != NumFiles) std::abort();
+		});
+
+	// 1% of the files modified before each run
+	{
+		auto changed 	= Vec<double>();
+		auto mtime 		= fs::file_time_type::clock::now() - ch::minutes(30);
+		for (std::size_t run = 1; run <= NumRuns; ++run)
+		{
+			for (std::size_t i = run; i < files.size(); i += 100)
+			{
+				std::ofstream(files[i], std::ios::app) << run;
+				fs::last_write_time(files[i], mtime + ch::seconds(run));
+			}
+
+			timed(changed, [&]{
+					auto hasher = FileHasher(tableFile);
+					hasher.hashAll(files);
+					hasher.save();
+				});
+		}
+
+		report.times("FileHasher (table loaded, 1% changed)", std::move(changed));
+	}
+
+	fs::remove_all(root, ec);
+}
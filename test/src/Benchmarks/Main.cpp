@@ -0,0 +1,50 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "Benchmarks.hpp"
+
+struct Benchmark
+{
+	StringView 	name;
+	void 		(*run)(BenchmarkOptions const&);
+};
+
+const Benchmark Benchmarks[] = {
+	{ "read-package-json", 	benchReadPackageJson },
+	{ "planner", 			benchPlanner },
+	{ "file-hasher", 		benchFileHasher },
+};
+
+///////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	// Arguments: names of benchmarks to run (all by default), "key=value" parameters and "--json=file".
+	auto selected 	= Vec<StringView>();
+	auto options 	= BenchmarkOptions();
+	auto jsonOutput = String();
+
+	for (auto arg : Vec<StringView>(argv + 1, argv + argc))
+	{
+		if (arg.starts_with("--json="))
+			jsonOutput = arg.substr(7);
+		else if (auto eq = arg.find('='); eq != StringView::npos)
+			options.values[String(arg.substr(0, eq))] = String(arg.substr(eq + 1));
+		else
+			selected.push_back(arg);
+	}
+
+	auto& report = BenchmarkReport::get();
+
+	for (auto const& bench : Benchmarks)
+	{
+		if (!selected.empty() && rg::find(selected, bench.name) == selected.end())
+			continue;
+
+		fmt::print("[{}]\n", bench.name);
+
+		report.current = &(report.results[String(bench.name)] = { { "parameters", json::object() }, { "measurements", json::object() } });
+		bench.run(options);
+	}
+
+	if (!jsonOutput.empty())
+		std::ofstream(jsonOutput) << report.results.dump(1, '\t');
+}
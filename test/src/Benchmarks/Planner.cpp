@@ -0,0 +1,174 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "Benchmarks.hpp"
+
+#include <Pacc/App/App.hpp>
+#include <Pacc/Generation/BuildQueueBuilder.hpp>
+
+/// <summary>Shape of the synthetic package tree.</summary>
+struct SyntheticTree
+{
+	std::size_t packages 	= 50; 	// dependency packages (besides the root)
+	std::size_t projects 	= 10; 	// projects per package
+	std::size_t fanOut 		= 3; 	// package dependencies of each package
+	std::size_t filters 	= 2; 	// filters per project
+	bool 		diamonds 	= true; // packages share dependencies (otherwise a tree)
+};
+
+///////////////////////////////////////////////////
+static auto packageName(std::size_t idx_) -> String
+{
+	return fmt::format("pkg{}", idx_);
+}
+
+///////////////////////////////////////////////////
+/// <summary>Packages that the package depends on, always of greater index (no cycles).</summary>
+static auto packageDependencies(SyntheticTree const& tree_, std::size_t idx_) -> Vec<std::size_t>
+{
+	auto result = Vec<std::size_t>();
+	for (std::size_t i = 1; i <= tree_.fanOut; ++i)
+	{
+		auto dep = tree_.diamonds ? (idx_ + i) : (idx_ * tree_.fanOut + i);
+		if (dep < tree_.packages)
+			result.push_back(dep);
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////
+/// <summary>
+/// 	The first project is named as the package and uses the dependency packages,
+/// 	the others depend on it.
+/// </summary>
+static auto generatePackage(SyntheticTree const& tree_, String const& name_, Vec<std::size_t> const& deps_)
+	-> String
+{
+	auto j = json::object();
+	j["name"] 		= name_;
+	j["version"] 	= "1.0.0";
+
+	auto& projects = j["projects"] = json::array();
+	for (std::size_t i = 0; i < tree_.projects; ++i)
+	{
+		auto projectName = (i == 0) ? name_ : fmt::format("{}_{}", name_, i);
+
+		auto project = json::object();
+		project["name"] 			= projectName;
+		project["type"] 			= "static lib";
+		project["language"] 		= "C++17";
+		project["files"] 			= { fmt::format("src/{}/**.cpp", projectName), fmt::format("include/{}/**.hpp", projectName) };
+		project["includeFolders"] 	= { { "public", { fmt::format("include/{}", projectName) } }, { "private", { "src" } } };
+		project["defines"] 			= { { "public", { fmt::format("{}_API", projectName) } }, { "private", { "BENCH" } } };
+
+		auto deps = json::array();
+		if (i == 0)
+		{
+			for (auto dep : deps_)
+				deps.push_back(packageName(dep));
+		}
+		else
+			deps.push_back(fmt::format("self:{}", name_));
+
+		project["dependencies"] = { { "public", std::move(deps) } };
+
+		auto filters = json::object();
+		for (std::size_t f = 0; f < tree_.filters; ++f)
+		{
+			filters[fmt::format("configurations:Config{}", f)] = {
+					{ "defines", 			{ { "public", { fmt::format("{}_CONFIG_{}", projectName, f) } } } },
+					{ "compilerOptions", 	{ "-Wall" } }
+				};
+		}
+		project["filters"] = std::move(filters);
+
+		projects.push_back(std::move(project));
+	}
+
+	return j.dump(1, '\t');
+}
+
+///////////////////////////////////////////////////
+/// <summary>Writes the root package and its dependencies (in "pacc_packages").</summary>
+static void generateTree(SyntheticTree const& tree_, Path const& root_)
+{
+	auto ec = std::error_code{};
+	fs::remove_all(root_, ec);
+
+	auto write = [](Path const& folder_, String const& content_)
+		{
+			fs::create_directories(folder_);
+			std::ofstream(folder_ / "pacc.json") << content_;
+		};
+
+	auto rootDeps = tree_.packages > 0 ? Vec<std::size_t>{ 0 } : Vec<std::size_t>{};
+	write(root_, generatePackage(tree_, "root", rootDeps));
+
+	for (std::size_t i = 0; i < tree_.packages; ++i)
+		write(root_ / "pacc_packages" / packageName(i), generatePackage(tree_, packageName(i), packageDependencies(tree_, i)));
+}
+
+///////////////////////////////////////////////////
+void benchPlanner(BenchmarkOptions const& options_)
+{
+	auto tree = SyntheticTree();
+	tree.packages 	= options_.get("packages", 	tree.packages);
+	tree.projects 	= std::max<std::size_t>(options_.get("projects", tree.projects), 1);
+	tree.fanOut 	= options_.get("fanout", 	tree.fanOut);
+	tree.filters 	= options_.get("filters", 	tree.filters);
+	tree.diamonds 	= options_.get("diamonds", 	1) != 0;
+
+	auto const NumRuns = options_.get("runs", 10);
+
+	auto& report = BenchmarkReport::get();
+	report.parameter("packages", 	tree.packages);
+	report.parameter("projects", 	tree.projects);
+	report.parameter("fanout", 		tree.fanOut);
+	report.parameter("filters", 	tree.filters);
+	report.parameter("diamonds", 	tree.diamonds);
+
+	auto root = fs::temp_directory_path() / "pacc-bench-planner";
+	generateTree(tree, root);
+
+	fmt::print("{} packages x {} projects, fan-out {}, {} filters, {}\n",
+			tree.packages + 1, tree.projects, tree.fanOut, tree.filters, tree.diamonds ? "diamonds" : "tree"
+		);
+
+	// Dependencies are searched relative to the working directory:
+	auto previousDir = fs::current_path();
+	fs::current_path(root);
+
+	auto& app = useApp();
+
+	auto load 		= Vec<double>();
+	auto recursive 	= Vec<double>();
+	auto setup 		= Vec<double>();
+	auto merging 	= Vec<double>();
+	auto generate 	= Vec<double>();
+
+	auto timed = [](Vec<double>& times_, auto&& func_)
+		{
+			auto start = ch::steady_clock::now();
+			func_();
+			times_.push_back( ch::duration<double, std::milli>(ch::steady_clock::now() - start).count() );
+		};
+
+	for (std::size_t run = 0; run < NumRuns; ++run)
+	{
+		auto pkg 		= UPtr<Package>();
+		auto depQueue 	= BuildQueueBuilder{app};
+
+		timed(load, 		[&]{ pkg = Package::load(root); });
+		timed(recursive, 	[&]{ depQueue.recursiveLoad(*pkg); });
+		timed(setup, 		[&]{ depQueue.setup(); });
+		timed(merging, 		[&]{ depQueue.performConfigurationMerging(); });
+		timed(generate, 	[&]{ app.createPremake5Generator().generate(*pkg); });
+	}
+
+	fs::current_path(previousDir);
+
+	report.times("Package::load", 								std::move(load));
+	report.times("BuildQueueBuilder::recursiveLoad", 			std::move(recursive));
+	report.times("BuildQueueBuilder::setup", 					std::move(setup));
+	report.times("BuildQueueBuilder::performConfigurationMerging", std::move(merging));
+	report.times("Premake5::generate", 							std::move(generate));
+}
@@ -0,0 +1,58 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "Benchmarks.hpp"
+
+#include <Pacc/Readers/JsonReader.hpp>
+
+///////////////////////////////////////////////////
+static auto generateWorkspace(std::size_t numProjects_)
+	-> String
+{
+	auto j = json::object();
+	j["name"] 		= "bench";
+	j["version"] 	= "1.0.0";
+
+	auto& projects = j["projects"] = json::array();
+	for (std::size_t i = 0; i < numProjects_; ++i)
+	{
+		auto name = fmt::format("project{}", i);
+
+		auto project = json::object();
+		project["name"] 			= name;
+		project["type"] 			= (i % 2) ? "static lib" : "app";
+		project["language"] 		= "C++17";
+		project["files"] 			= { fmt::format("src/{}/**.cpp", name), fmt::format("include/{}/**.hpp", name) };
+		project["includeFolders"] 	= { { "public", { fmt::format("include/{}", name) } }, { "private", { "src" } } };
+		project["defines"] 			= { "BENCH", fmt::format("PROJECT_{}", i) };
+		project["dependencies"] 	= { "fmt@7.0.0", fmt::format("self:project{}", i / 2) };
+		project["filters"] 			= { { "system:windows", { { "defines", { "BENCH_WINDOWS" } } } } };
+
+		projects.push_back(std::move(project));
+	}
+
+	return j.dump(1, '\t');
+}
+
+///////////////////////////////////////////////////
+void benchReadPackageJson(BenchmarkOptions const& options_)
+{
+	auto const NumProjects 	= options_.get("projects", 5000);
+	auto const NumRuns 		= options_.get("runs", 20);
+
+	auto content = generateWorkspace(NumProjects);
+	fmt::print("workspace with {} projects, {} KiB\n", NumProjects, content.size() / 1024);
+
+	BenchmarkReport::get().parameter("projects", NumProjects);
+
+	// Reference: only building the JSON document, which the reader no longer does:
+	measure("json::parse (document only)", NumRuns, [&]{
+			auto j = json::parse(content);
+			if (j.empty()) std::abort();
+		});
+
+	measure("readPackageJson (SAX)", NumRuns, [&]{
+			auto pkg = Package();
+			readPackageJson(pkg, content);
+			if (pkg.projects.size() != NumProjects) std::abort();
+		});
+}
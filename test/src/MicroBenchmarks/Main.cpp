@@ -0,0 +1,99 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "MicroBenchmarks.hpp"
+
+#include <Pacc/Helpers/Formatting.hpp>
+
+///////////////////////////////////////////////////
+static auto loadBaseline(String const& path_) -> json
+{
+	auto file = std::ifstream(path_);
+	if (!file)
+	{
+		fmt::print(stderr, "Could not open baseline file \"{}\".\n", path_);
+		return json::object();
+	}
+
+	return json::parse(file, nullptr, false).value("results", json::object());
+}
+
+///////////////////////////////////////////////////
+/// <summary>Change of the median against the baseline, marked when it exceeds the noise of both runs.</summary>
+static auto compareWithBaseline(MicroResult const& result_, json const& baseline_) -> String
+{
+	auto it = baseline_.find(result_.name);
+	if (it == baseline_.end())
+		return "";
+
+	auto baseMedian = it->value("median_ns", 0.0);
+	if (baseMedian <= 0)
+		return "";
+
+	auto change = (result_.median - baseMedian) / baseMedian * 100.0;
+	auto noise 	= 3 * (result_.mad + it->value("mad_ns", 0.0));
+	auto mark 	= std::abs(result_.median - baseMedian) > noise ? (change < 0 ? " faster" : " SLOWER") : "";
+
+	return fmt::format("{:+7.1f}%{}", change, mark);
+}
+
+///////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	// Arguments: name filters (substrings, all benchmarks by default),
+	// "samples=", "warmup=", "sample-us=", "--json=file" and "--baseline=file".
+	auto filters 	= Vec<StringView>();
+	auto options 	= MicroOptions();
+	auto jsonOutput = String();
+	auto baseline 	= json::object();
+
+	for (auto arg : Vec<StringView>(argv + 1, argv + argc))
+	{
+		if (arg.starts_with("--json="))
+			jsonOutput = arg.substr(7);
+		else if (arg.starts_with("--baseline="))
+			baseline = loadBaseline(String(arg.substr(11)));
+		else if (arg.starts_with("samples="))
+			options.samples = std::stoull(String(arg.substr(8)));
+		else if (arg.starts_with("warmup="))
+			options.warmup = std::stoull(String(arg.substr(7)));
+		else if (arg.starts_with("sample-us="))
+			options.sampleUs = std::stod(String(arg.substr(10)));
+		else
+			filters.push_back(arg);
+	}
+
+	auto benchmarks = parsingMicroBenchmarks();
+	rg::move(stringMicroBenchmarks(), std::back_inserter(benchmarks));
+
+	auto selected = [&](String const& name_) {
+			return filters.empty() || rg::any_of(filters, [&](StringView f) { return name_.find(f) != String::npos; });
+		};
+
+	fmt::print("{:<40} {:>12} {:>12} {:>12}\n", "benchmark (ns/call)", "median", "p95", "MAD");
+
+	auto results = json::object();
+	for (auto const& bench : benchmarks)
+	{
+		if (!selected(bench.name))
+			continue;
+
+		auto r = bench.run(options);
+		fmt::print("{:<40} {:>12.2f} {:>12.2f} {:>12.2f} {}\n", r.name, r.median, r.p95, r.mad, compareWithBaseline(r, baseline));
+
+		results[r.name] = {
+				{ "median_ns", 	r.median },
+				{ "p95_ns", 	r.p95 },
+				{ "mad_ns", 	r.mad },
+				{ "samples", 	r.samples },
+				{ "batch", 		r.batch }
+			};
+	}
+
+	if (!jsonOutput.empty())
+	{
+		auto report = json::object();
+		report["options"] = { { "samples", options.samples }, { "warmup", options.warmup }, { "sample_us", options.sampleUs } };
+		report["results"] = std::move(results);
+		std::ofstream(jsonOutput) << report.dump(1, '\t');
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/Helpers/HelperTypes.hpp>
+
+#include <functional>
+
+/// <summary>Harness parameters, passed as "key=value" arguments.</summary>
+struct MicroOptions
+{
+	std::size_t samples 	= 50; 	// measured samples per benchmark
+	std::size_t warmup 		= 5; 	// samples run and discarded before measuring
+	double 		sampleUs 	= 500; 	// target duration of a single sample in microseconds
+};
+
+/// <summary>Statistics of a single benchmark, in nanoseconds per call.</summary>
+struct MicroResult
+{
+	String 		name;
+	double 		median 		= 0;
+	double 		p95 		= 0;
+	double 		mad 		= 0; // median absolute deviation
+	std::size_t samples 	= 0;
+	std::size_t batch 		= 0; // calls per sample
+};
+
+/// <summary>Keeps the compiler from optimizing away the computation of `value_`.</summary>
+template <typename T>
+inline void doNotOptimize(T const& value_)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value_) : "memory");
+#else
+	static_cast<void>(*reinterpret_cast<char const volatile*>(&value_));
+#endif
+}
+
+///////////////////////////////////////////////////
+inline auto medianOf(Vec<double> sorted_) -> double
+{
+	auto n = sorted_.size();
+	return (n % 2) ? sorted_[n / 2] : (sorted_[n / 2 - 1] + sorted_[n / 2]) / 2;
+}
+
+///////////////////////////////////////////////////
+inline auto computeStats(String name_, Vec<double> times_, std::size_t batch_) -> MicroResult
+{
+	rg::sort(times_);
+
+	auto result = MicroResult{ std::move(name_) };
+	result.samples 	= times_.size();
+	result.batch 	= batch_;
+	result.median 	= medianOf(times_);
+	result.p95 		= times_[ std::min(times_.size() - 1, (times_.size() * 95 + 99) / 100 - 1) ]; // nearest rank
+
+	auto deviations = Vec<double>();
+	deviations.reserve(times_.size());
+	for (auto t : times_)
+		deviations.push_back(std::abs(t - result.median));
+
+	rg::sort(deviations);
+	result.mad = medianOf(std::move(deviations));
+
+	return result;
+}
+
+/// <summary>
+/// 	Measures the function in samples of `batch` calls each. The batch is calibrated
+/// 	so that a sample takes about `options_.sampleUs`, which keeps the timer overhead negligible.
+/// </summary>
+template <typename TFunc>
+auto runMicro(StringView name_, MicroOptions const& options_, TFunc&& func_) -> MicroResult
+{
+	auto sample = [&](std::size_t batch_)
+		{
+			auto start = ch::steady_clock::now();
+			for (std::size_t i = 0; i < batch_; ++i)
+				func_();
+			return ch::duration<double, std::nano>(ch::steady_clock::now() - start).count();
+		};
+
+	auto const targetNs = options_.sampleUs * 1000.0;
+
+	auto batch = std::size_t(1);
+	while (batch < (std::size_t(1) << 30))
+	{
+		if (sample(batch) >= targetNs / 4)
+			break;
+		batch *= 2;
+	}
+	batch = std::max<std::size_t>(1, std::size_t(batch * targetNs / std::max(sample(batch), 1.0)));
+
+	for (std::size_t i = 0; i < options_.warmup; ++i)
+		sample(batch);
+
+	auto times = Vec<double>();
+	times.reserve(options_.samples);
+	for (std::size_t i = 0; i < std::max<std::size_t>(options_.samples, 1); ++i)
+		times.push_back(sample(batch) / double(batch));
+
+	return computeStats(String(name_), std::move(times), batch);
+}
+
+/// <summary>A single micro-benchmark, registered in one of the benchmark groups.</summary>
+struct MicroBenchmark
+{
+	String 												name;
+	std::function<MicroResult(MicroOptions const&)> 	run;
+};
+
+/// <summary>Creates a benchmark entry that calls `func_` in a loop.</summary>
+template <typename TFunc>
+auto micro(StringView name_, TFunc func_) -> MicroBenchmark
+{
+	return {
+			String(name_),
+			[name = String(name_), func = std::move(func_)](MicroOptions const& options_) {
+				return runMicro(name, options_, func);
+			}
+		};
+}
+
+// Benchmark groups:
+auto parsingMicroBenchmarks() -> Vec<MicroBenchmark>;
+auto stringMicroBenchmarks() -> Vec<MicroBenchmark>;
@@ -0,0 +1,59 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "MicroBenchmarks.hpp"
+
+#include <Pacc/PackageSystem/Dependency.hpp>
+#include <Pacc/PackageSystem/Version.hpp>
+
+///////////////////////////////////////////////////
+/// <summary>Output of "git ls-remote --tags" with `numTags_` tags in all supported naming styles.</summary>
+static auto generateLsRemoteOutput(std::size_t numTags_) -> String
+{
+	auto result = String();
+	for (std::size_t i = 0; i < numTags_; ++i)
+	{
+		auto version = fmt::format("{}.{}.{}", i / 100, (i / 10) % 10, i % 10);
+		auto tag = (i % 3 == 0) ? fmt::format("pacc-{}", version)
+				 : (i % 3 == 1) ? fmt::format("v{}", version)
+				 : version;
+
+		result += fmt::format("{:040x}\trefs/tags/{}\n", i * 2654435761u, tag);
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////
+auto parsingMicroBenchmarks() -> Vec<MicroBenchmark>
+{
+	auto result = Vec<MicroBenchmark>();
+
+	result.push_back(micro("DownloadLocation::parse (official)", [input = String("fmt@8.0.1")] {
+			doNotOptimize(DownloadLocation::parse(input));
+		}));
+
+	result.push_back(micro("DownloadLocation::parse (github)", [input = String("github:PoetaKodu/pacc@!main")] {
+			doNotOptimize(DownloadLocation::parse(input));
+		}));
+
+	result.push_back(micro("Version::fromString", [] {
+			doNotOptimize(Version::fromString("12.34.567"));
+		}));
+
+	result.push_back(micro("VersionReq::fromString", [] {
+			doNotOptimize(VersionReq::fromString("^1.2.3"));
+		}));
+
+	result.push_back(micro("VersionReq::test", [
+				reqs = std::array{ VersionReq("1.2.3"), VersionReq("~1.2.0"), VersionReq("^1.0.0"), VersionReq("*") },
+				version = Version{ 1, 2, 3 }
+			] {
+			for (auto const& req : reqs)
+				doNotOptimize(req.test(version));
+		}));
+
+	result.push_back(micro("PackageVersions::parse (200 tags)", [input = generateLsRemoteOutput(200)] {
+			doNotOptimize(PackageVersions::parse(input));
+		}));
+
+	return result;
+}
@@ -0,0 +1,44 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "MicroBenchmarks.hpp"
+
+#include <Pacc/Helpers/String.hpp>
+
+///////////////////////////////////////////////////
+auto stringMicroBenchmarks() -> Vec<MicroBenchmark>
+{
+	auto result = Vec<MicroBenchmark>();
+
+	// Typical values emitted by `appendStrings`, most of them without quotes:
+	result.push_back(micro("replaceAll (no match)", [input = String("src/Generation/**.cpp")] {
+			doNotOptimize(replaceAll(input, "\"", "\\\""));
+		}));
+
+	result.push_back(micro("replaceAll (2 matches)", [input = String("VERSION_STRING=\"1.2.3\"")] {
+			doNotOptimize(replaceAll(input, "\"", "\\\""));
+		}));
+
+	result.push_back(micro("splitBy", [] {
+			doNotOptimize(splitBy("configurations:Debug", ':'));
+		}));
+
+	result.push_back(micro("parseArgSwitch (match)", [] {
+			auto value = String();
+			doNotOptimize(parseArgSwitch("--premake5=/usr/local/bin/premake5", "--premake5", value));
+		}));
+
+	result.push_back(micro("parseArgSwitch (no match)", [] {
+			auto value = String();
+			doNotOptimize(parseArgSwitch("--compile-commands", "--premake5", value));
+		}));
+
+	result.push_back(micro("compareIgnoreCase (equal)", [] {
+			doNotOptimize(compareIgnoreCase("StaticLib", "staticlib"));
+		}));
+
+	result.push_back(micro("compareIgnoreCase (different)", [] {
+			doNotOptimize(compareIgnoreCase("StaticLib", "SharedLib"));
+		}));
+
+	return result;
+}
@@ -0,0 +1,309 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "ReaderParity.hpp"
+
+#include <Pacc/Helpers/Json.hpp>
+#include <Pacc/Helpers/String.hpp>
+#include <Pacc/Helpers/Exceptions.hpp>
+
+// Copied from the reader before the streaming rewrite, only the event handlers and the CMake query were left out.
+
+namespace dom
+{
+
+using json_vt = json::value_t;
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static void makeConformant(json& root_);
+static void loadConfiguration(Package& pkg_, Project& project_, Configuration& conf_, json const& root_);
+static void readDependencyAccess(Package& pkg_, Project& proj_, json const& deps_, Vec<Dependency>& target_);
+static auto loadVecOfStrField(json const& j_, StringView fieldName_, bool direct_ = false) -> Vec<String>;
+static auto loadVecOfStrAccField(json const& j_, StringView fieldName_, AccessType defaultAccess_) -> VecOfStrAcc;
+
+
+///////////////////////////////////////////////////
+// Public functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+void readPackageJson(Package& package_, StringView content_)
+{
+	auto j = json::parse(content_);
+	makeConformant(j);
+
+	package_.name 			= j["name"].get<String>();
+	package_.startupProject	= j.value("startupProject", "");
+	package_.version 		= Version::fromString( j.value("version", "0") );
+	package_.isCMake 		= j.value("cmake", false);
+
+	for (auto it : j["projects"].items())
+	{
+		auto& jsonProject = it.value();
+
+		auto project = Project();
+		project.name = jsonProject["name"].get<String>();
+		project.type = parseProjectType(jsonProject["type"].get<String>());
+
+		if (jsonProject.contains("pch"))
+		{
+			auto pch = PrecompiledHeader();
+			pch.header		= jsonProject["pch"]["header"];
+			pch.source		= jsonProject["pch"]["source"];
+			pch.definition 	= jsonProject["pch"]["definition"];
+			project.pch = std::move(pch);
+		}
+
+		if (auto lang = jsonProject.find("language"); lang != jsonProject.end())
+			project.language = lang->get<String>();
+
+		loadConfiguration(package_, project, project, jsonProject);
+
+		if (auto filters = jsonProject.find("filters"); filters != jsonProject.end() && filters->is_object())
+		{
+			for (auto filterIt : filters->items())
+			{
+				if (filterIt.value().is_object())
+					loadConfiguration(package_, project, project.premakeFilters[filterIt.key()], filterIt.value());
+			}
+		}
+
+		package_.projects.emplace_back(std::move(project));
+	}
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+static void makeConformant(json& root_)
+{
+	using JV = JsonView;
+
+	if (root_.is_array())
+	{
+		auto projects = std::move(root_);
+
+		root_ = json::object();
+		root_["projects"] = std::move(projects);
+	}
+
+	if (!root_.is_object())
+		throw PaccException("Empty workspace not allowed, your pacc.json is invalid.");
+
+	if (auto it = root_.find("projects"); it != root_.end())
+	{
+		JV{*it}.requireType("projects", json_vt::array);
+
+		if (it->size() < 1)
+			throw PaccException("empty workspace not allowed");
+
+		for (auto projIt : it->items())
+		{
+			auto& proj = projIt.value();
+			if (proj.type() != json_vt::object)
+				throw PaccException("each workspace project has to be an JSON object");
+
+			JV{proj}.expect("name", json_vt::string);
+			JV{proj}.expect("type", json_vt::string);
+		}
+
+		if (auto name = root_.find("name"); name != root_.end())
+			JV{*name}.requireType("name", json_vt::string);
+		else
+			root_["name"] = (*it)[0]["name"].get<String>();
+	}
+	else if (root_.contains("type"))
+	{
+		if (!root_.contains("name") || root_["name"].type() != json_vt::string)
+			throw PaccException("Project doesn't contain string field \"name\".");
+
+		auto singleProject = std::move(root_);
+
+		root_ = json::object();
+		root_["name"] 		= singleProject["name"];
+		root_["cmake"] 		= singleProject.value("cmake", false);
+		root_["version"]	= JV{singleProject}.stringFieldOr("version", "0.0.0");
+		root_["projects"] 	= json::array();
+		root_["projects"].push_back(std::move(singleProject));
+
+		makeConformant(root_);
+	}
+	else
+		throw PaccException("Invalid pacc.json format.");
+}
+
+///////////////////////////////////////////////////
+static void loadConfiguration(Package& pkg_, Project& project_, Configuration& conf_, json const& root_)
+{
+	conf_.symbolVisibility 		= GNUSymbolVisibility::fromString(root_.value("symbolVisibility", "Default"));
+	conf_.moduleDefinitionFile 	= root_.value("moduleDefinitionFile", "");
+
+	auto isInterface 	= (project_.type == Project::Type::Interface);
+	auto defaultAccess 	= isInterface ? AccessType::Interface : AccessType::Private;
+
+	conf_.files		 			= loadVecOfStrField(root_, "files");
+	conf_.defines.self	 		= loadVecOfStrAccField(root_, "defines", 			defaultAccess);
+	conf_.includeFolders.self	= loadVecOfStrAccField(root_, "includeFolders",		defaultAccess);
+	conf_.linkerFolders.self	= loadVecOfStrAccField(root_, "linkerFolders", 		defaultAccess);
+	conf_.compilerOptions.self	= loadVecOfStrAccField(root_, "compilerOptions", 	defaultAccess);
+	conf_.linkerOptions.self	= loadVecOfStrAccField(root_, "linkerOptions", 		defaultAccess);
+
+	auto depsIt = root_.find("dependencies");
+	if (depsIt == root_.end())
+		return;
+
+	auto const& deps = *depsIt;
+	auto& selfDeps = conf_.dependencies.self;
+	if (deps.is_array())
+		readDependencyAccess(pkg_, project_, deps, targetByAccessType(selfDeps, defaultAccess));
+	else if (deps.is_object())
+	{
+		if (!isInterface)
+		{
+			if (deps.contains("public")) 	readDependencyAccess(pkg_, project_, deps["public"], selfDeps.public_);
+			if (deps.contains("private")) 	readDependencyAccess(pkg_, project_, deps["private"], selfDeps.private_);
+		}
+
+		if (deps.contains("interface")) readDependencyAccess(pkg_, project_, deps["interface"], selfDeps.interface_);
+	}
+	else
+		throw PaccException("Invalid type of \"dependencies\" field (must be an array or an object)");
+}
+
+///////////////////////////////////////////////////
+static void readDependencyAccess(Package& pkg_, Project& proj_, json const& deps_, Vec<Dependency>& target_)
+{
+	if (!deps_.is_array())
+		throw PaccException("invalid type of dependencies subfield - array required");
+
+	for (auto item : deps_.items())
+	{
+		auto const& dep = item.value();
+		if (dep.is_string())
+		{
+			auto depPattern = dep.get<String>();
+			if (startsWith(depPattern, "file:"))
+				target_.push_back( Dependency::raw( depPattern.substr(5) ) );
+			else if (startsWith(depPattern, "self:"))
+				target_.push_back( Dependency::self( SelfDependency{ &proj_, depPattern.substr(5), &pkg_ } ) );
+			else
+			{
+				auto loc = DownloadLocation::parse(depPattern);
+
+				auto pd = PackageDependency();
+				pd.packageName = loc.repository;
+
+				try {
+					pd.version = VersionReq::fromString(loc.branch);
+				}
+				catch(...) {}
+
+				pd.projects.push_back(loc.repository);
+				pd.downloadLocation = std::move(depPattern);
+
+				target_.push_back( Dependency::package( std::move(pd) ) );
+			}
+		}
+		else if (dep.is_object())
+		{
+			auto name = dep.find("name");
+			if (name == dep.end() || !name->is_string())
+				throw PaccException("invalid subfield type");
+
+			auto pd = PackageDependency();
+			pd.packageName 		= name->get<String>();
+			pd.downloadLocation = dep.value("from", "");
+
+			if (auto projects = dep.find("projects"); projects != dep.end() && projects->is_array())
+			{
+				for (auto proj : projects->items())
+				{
+					if (!proj.value().is_string())
+						throw PaccException("invalid type");
+
+					pd.projects.push_back(proj.value().get<String>());
+				}
+			}
+			else
+			{
+				auto loc = DownloadLocation::parse(pd.downloadLocation);
+				pd.projects.push_back(!loc.repository.empty() ? loc.repository : pd.packageName);
+			}
+
+			if (auto version = dep.find("version"); version != dep.end() && version->is_string())
+			{
+				try {
+					pd.version = VersionReq::fromString(version->get<String>());
+				}
+				catch (...) {
+					pd.version.type = VersionReq::Any;
+				}
+			}
+
+			target_.push_back( Dependency::package( std::move(pd) ) );
+		}
+		else
+			throw PaccException("Invalid dependency type");
+	}
+}
+
+///////////////////////////////////////////////////
+static auto loadVecOfStrField(json const& j_, StringView fieldName_, bool direct_) -> Vec<String>
+{
+	auto result = Vec<String>();
+
+	auto const* val = &j_;
+	if (!direct_)
+	{
+		auto it = j_.find(fieldName_);
+		if (it == j_.end())
+			return result;
+
+		val = &*it;
+	}
+
+	if (val->is_string())
+	{
+		result.push_back(*val);
+		return result;
+	}
+
+	JsonView(*val).requireType(fieldName_, json_vt::array);
+
+	auto elemName = String(fieldName_) + " element";
+	for (auto elem : val->items())
+	{
+		JsonView{elem.value()}.requireType(elemName, json_vt::string);
+		result.push_back(elem.value());
+	}
+
+	return result;
+}
+
+///////////////////////////////////////////////////
+static auto loadVecOfStrAccField(json const& j_, StringView fieldName_, AccessType defaultAccess_) -> VecOfStrAcc
+{
+	auto result = VecOfStrAcc();
+
+	auto it = j_.find(fieldName_);
+	if (it == j_.end())
+		return result;
+
+	if (it->is_array() || it->is_string())
+		targetByAccessType(result, defaultAccess_) = loadVecOfStrField(*it, fieldName_, true);
+	else
+	{
+		result.private_ 	= loadVecOfStrField(*it, "private");
+		result.public_ 		= loadVecOfStrField(*it, "public");
+		result.interface_ 	= loadVecOfStrField(*it, "interface");
+	}
+
+	return result;
+}
+
+}
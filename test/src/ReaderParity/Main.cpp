@@ -0,0 +1,246 @@
+#include "include/Pacc/PaccPCH.hpp"
+
+#include "ReaderParity.hpp"
+
+#include <Pacc/Readers/JsonReader.hpp>
+
+#ifdef PACC_SYSTEM_WINDOWS
+	#include <io.h>
+	#define dup _dup
+	#define dup2 _dup2
+	#define fileno _fileno
+#else
+	#include <unistd.h>
+#endif
+
+/// <summary>Manifest read by both readers, the resulting packages have to be equal.</summary>
+struct ParityCase
+{
+	StringView name;
+	StringView manifest;
+};
+
+// Each field in the array (default access) and the object form, in every manifest format:
+const ParityCase Cases[] = {
+	{ "single project", R"({ "name": "a", "type": "app", "version": "1.2.3", "language": "C++20", "files": [ "src/**.cpp" ] })" },
+	{ "single project, string files", R"({ "name": "a", "type": "app", "files": "src/main.cpp" })" },
+	{ "array of projects", R"([ { "name": "a", "type": "app" }, { "name": "b", "type": "static lib" } ])" },
+	{ "workspace", R"({ "name": "w", "version": "0.1.0", "startupProject": "b", "projects": [ { "name": "a", "type": "static lib" }, { "name": "b", "type": "app" } ] })" },
+	{ "workspace without a name", R"({ "projects": [ { "name": "a", "type": "app" } ] })" },
+
+	{ "strings, array form", R"({ "name": "a", "type": "static lib",
+		"defines": [ "A", "B" ], "includeFolders": [ "include" ], "linkerFolders": [ "lib" ],
+		"compilerOptions": [ "-Wall" ], "linkerOptions": [ "-s" ] })" },
+	{ "strings, string form", R"({ "name": "a", "type": "static lib",
+		"defines": "A", "includeFolders": "include", "linkerFolders": "lib", "compilerOptions": "-Wall", "linkerOptions": "-s" })" },
+	{ "strings, object form", R"({ "name": "a", "type": "static lib",
+		"defines": { "public": [ "A" ], "private": "B", "interface": [ "C", "D" ] },
+		"includeFolders": { "public": [ "include" ], "private": [ "src" ] },
+		"linkerFolders": { "interface": [ "lib" ] },
+		"compilerOptions": { "private": [ "-Wall" ] },
+		"linkerOptions": { "public": "-s" } })" },
+	{ "strings, array form in an interface project", R"({ "name": "a", "type": "interface", "defines": [ "A" ], "includeFolders": [ "include" ] })" },
+
+	{ "dependencies, array form", R"({ "name": "a", "type": "app",
+		"dependencies": [ "fmt@7.0.0", "file:pthread", "self:b", "github:user/repo@1.0.0", { "name": "json", "version": "3.9.1", "projects": [ "json", "json-extra" ] }, { "name": "x", "from": "github:user/y" } ] })" },
+	{ "dependencies, object form", R"({ "name": "a", "type": "static lib",
+		"dependencies": { "public": [ "fmt@7.0.0" ], "private": [ "file:pthread" ], "interface": [ "self:b" ] } })" },
+	{ "dependencies, array form in an interface project", R"({ "name": "a", "type": "interface", "dependencies": [ "fmt" ] })" },
+	{ "dependencies, object form in an interface project", R"({ "name": "a", "type": "interface", "dependencies": { "interface": [ "fmt" ] } })" },
+	{ "dependencies, ignored split in an interface project", R"({ "name": "a", "type": "interface", "dependencies": { "public": [ "fmt" ], "interface": [ "json" ] } })" },
+
+	{ "symbol visibility and module definition", R"({ "name": "a", "type": "shared lib", "symbolVisibility": "Hidden", "moduleDefinitionFile": "a.def" })" },
+	{ "precompiled header", R"({ "name": "a", "type": "app", "pch": { "header": "pch.hpp", "source": "pch.cpp", "definition": "PCH" } })" },
+	{ "filters", R"({ "name": "a", "type": "static lib",
+		"filters": {
+			"system:windows": { "defines": [ "WIN" ], "files": "win.cpp", "dependencies": [ "file:ws2_32" ] },
+			"system:linux": { "defines": { "public": [ "LINUX" ] }, "dependencies": { "private": [ "file:pthread" ] } },
+			"ignored": "not an object"
+		} })" },
+
+	// Both readers have to reject these:
+	{ "invalid: empty workspace", R"({ "projects": [] })" },
+	{ "invalid: no projects nor type", R"({ "name": "a" })" },
+	{ "invalid: project without a name", R"({ "type": "app" })" },
+	{ "invalid: number files", R"({ "name": "a", "type": "app", "files": 1 })" },
+	{ "invalid: number define", R"({ "name": "a", "type": "app", "defines": [ 1 ] })" },
+	{ "invalid: number dependencies", R"({ "name": "a", "type": "app", "dependencies": 1 })" },
+	{ "invalid: object dependency access", R"({ "name": "a", "type": "app", "dependencies": { "public": { "name": "fmt" } } })" },
+	{ "invalid: dependency without a name", R"({ "name": "a", "type": "app", "dependencies": [ { "version": "1.0.0" } ] })" },
+};
+
+///////////////////////////////////////////////////
+// Private functions (forward declaration)
+///////////////////////////////////////////////////
+
+static auto describe(Package const& pkg_) -> json;
+static auto describe(Configuration const& config_) -> json;
+static auto describe(Dependency const& dep_) -> String;
+static auto read(void (*reader_)(Package&, StringView), StringView manifest_) -> json;
+template <typename TFunc>
+static auto captureStdout(TFunc&& func_) -> String;
+
+
+///////////////////////////////////////////////////
+int main()
+{
+	auto failed = 0;
+
+	for (auto const& c : Cases)
+	{
+		auto expected 	= read(dom::readPackageJson, c.manifest);
+		auto actual 	= read(readPackageJson, c.manifest);
+
+		if (expected == actual)
+			continue;
+
+		++failed;
+		fmt::print("FAILED: {}\nexpected (DOM reader):\n{}\nactual:\n{}\n\n", c.name, expected.dump(1, '\t'), actual.dump(1, '\t'));
+	}
+
+	// Public or private dependencies are ignored in interface projects with a warning, "interface" alone is valid:
+	auto warnings = [](StringView manifest_) {
+			auto output = captureStdout([&] { auto pkg = Package(); readPackageJson(pkg, manifest_); });
+			return output.find("cannot include public or private dependencies") != String::npos;
+		};
+
+	if (warnings(R"({ "name": "a", "type": "interface", "dependencies": { "interface": [ "fmt" ] } })"))
+	{
+		++failed;
+		fmt::print("FAILED: interface project with interface dependencies warned\n");
+	}
+
+	if (!warnings(R"({ "name": "a", "type": "interface", "dependencies": { "private": [ "fmt" ] } })"))
+	{
+		++failed;
+		fmt::print("FAILED: interface project with private dependencies did not warn\n");
+	}
+
+	fmt::print("{} of {} checks passed\n", std::size(Cases) + 2 - failed, std::size(Cases) + 2);
+	return failed ? 1 : 0;
+}
+
+
+///////////////////////////////////////////////////
+// Private functions
+///////////////////////////////////////////////////
+
+///////////////////////////////////////////////////
+/// <returns>Description of the read package, or of the error.</returns>
+static auto read(void (*reader_)(Package&, StringView), StringView manifest_) -> json
+{
+	auto pkg = Package();
+	try {
+		reader_(pkg, manifest_);
+	}
+	catch(std::exception&) {
+		// Messages may differ, only both have to fail
+		return "error";
+	}
+
+	return describe(pkg);
+}
+
+///////////////////////////////////////////////////
+static auto describe(Package const& pkg_) -> json
+{
+	auto j = json::object();
+	j["name"] 			= pkg_.name;
+	j["version"] 		= pkg_.version.toString();
+	j["startupProject"] = pkg_.startupProject;
+	j["cmake"] 			= pkg_.isCMake;
+
+	auto& projects = j["projects"] = json::array();
+	for (auto const& project : pkg_.projects)
+	{
+		auto p = describe(static_cast<Configuration const&>(project));
+		p["name"] 		= project.name;
+		p["type"] 		= toString(project.type);
+		p["language"] 	= project.language;
+
+		if (project.pch)
+			p["pch"] = { project.pch->header, project.pch->source, project.pch->definition };
+
+		auto& filters = p["filters"] = json::object();
+		for (auto const& [filter, config] : project.premakeFilters)
+			filters[filter] = describe(config);
+
+		projects.push_back(std::move(p));
+	}
+
+	return j;
+}
+
+///////////////////////////////////////////////////
+static auto describe(Configuration const& config_) -> json
+{
+	auto accesses = [](auto const& split_) {
+			return json{ { "private", split_.private_ }, { "public", split_.public_ }, { "interface", split_.interface_ } };
+		};
+
+	auto dependencies = [](Vec<Dependency> const& deps_) {
+			auto result = json::array();
+			for (auto const& dep : deps_)
+				result.push_back(describe(dep));
+			return result;
+		};
+
+	auto const& deps = config_.dependencies.self;
+
+	auto j = json::object();
+	j["files"] 					= config_.files;
+	j["symbolVisibility"] 		= config_.symbolVisibility.toString();
+	j["moduleDefinitionFile"] 	= config_.moduleDefinitionFile;
+	j["defines"] 				= accesses(config_.defines.self);
+	j["includeFolders"] 		= accesses(config_.includeFolders.self);
+	j["linkerFolders"] 			= accesses(config_.linkerFolders.self);
+	j["compilerOptions"] 		= accesses(config_.compilerOptions.self);
+	j["linkerOptions"] 			= accesses(config_.linkerOptions.self);
+	j["dependencies"] 			= {
+			{ "private", dependencies(deps.private_) },
+			{ "public", dependencies(deps.public_) },
+			{ "interface", dependencies(deps.interface_) }
+		};
+	return j;
+}
+
+///////////////////////////////////////////////////
+static auto describe(Dependency const& dep_) -> String
+{
+	if (dep_.isRaw())
+		return "file:" + dep_.raw();
+
+	if (dep_.isSelf())
+		return "self:" + dep_.self().depProjName;
+
+	auto const& pd = dep_.package();
+	return fmt::format("package:{} version:{} from:{} projects:{}", pd.packageName, pd.version.toString(), pd.downloadLocation, fmt::join(pd.projects, ","));
+}
+
+///////////////////////////////////////////////////
+template <typename TFunc>
+static auto captureStdout(TFunc&& func_) -> String
+{
+	auto file = std::tmpfile();
+	std::fflush(stdout);
+
+	auto saved = ::dup(fileno(stdout));
+	::dup2(fileno(file), fileno(stdout));
+
+	try {
+		func_();
+	}
+	catch(...) {}
+
+	std::fflush(stdout);
+	::dup2(saved, fileno(stdout));
+	::close(saved);
+
+	auto output = String();
+	std::rewind(file);
+	for (int c; (c = std::fgetc(file)) != EOF; )
+		output += char(c);
+
+	std::fclose(file);
+	return output;
+}
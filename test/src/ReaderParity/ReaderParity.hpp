@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Pacc/PaccPCH.hpp>
+
+#include <Pacc/PackageSystem/Package.hpp>
+
+namespace dom
+{
+
+/// <summary>
+/// 	The document (DOM) pacc.json reader that <c>readPackageJson</c> replaced, kept as the reference
+/// 	the streaming reader is compared with. Event handlers and CMake packages are not read.
+/// </summary>
+void readPackageJson(Package& package_, StringView content_);
+
+}